@@ -1,5 +1,6 @@
 #pragma once
 #include <array>
+#include <random>
 #include <vector>
 
 #ifdef __cplusplus
@@ -9,9 +10,12 @@ extern "C" {
 namespace card_sampler {
 class CardSampler {
   std::array<int, 52> deck;
+  std::default_random_engine generator;
 
  public:
   CardSampler(void);
+  // Samplers with the same seed return the same sequence of samples.
+  explicit CardSampler(unsigned int seed);
   std::vector<int> sample(int size);
 };
 }  // namespace card_sampler
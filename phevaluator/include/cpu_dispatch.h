@@ -0,0 +1,68 @@
+/*
+ *  Copyright 2016 Henry Lee
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef PHEVALUATOR_CPU_DISPATCH_H
+#define PHEVALUATOR_CPU_DISPATCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Runtime CPU dispatch.
+ *
+ * The library is built without ISA flags, so one binary runs on any x86-64.
+ * Hot kernels have a version per cpu_level, compiled with per-function target
+ * attributes, and every call goes to the version for the current dispatch
+ * level. That is the best level the CPU supports, unless it is lowered with
+ * the PHEVALUATOR_ISA environment variable (scalar, sse4.2, avx2 or avx512)
+ * or set_cpu_dispatch_level, e.g. to test the other versions.
+ *
+ * Only GCC and Clang on x86 build the ISA specific versions. Elsewhere every
+ * level runs the scalar code.
+ */
+typedef enum {
+  CPU_LEVEL_SCALAR = 0,
+  CPU_LEVEL_SSE42 = 1,  /* SSE4.2 and POPCNT */
+  CPU_LEVEL_AVX2 = 2,   /* AVX2, FMA, BMI1 and BMI2 */
+  CPU_LEVEL_AVX512 = 3, /* AVX-512 F, BW, DQ and VL */
+  CPU_NUM_LEVELS = 4
+} cpu_level;
+
+/* Best level this CPU supports. */
+cpu_level cpu_detected_level(void);
+
+/* Level the kernels currently dispatch to. */
+cpu_level cpu_dispatch_level(void);
+
+/*
+ * Sets the dispatch level, capped at cpu_detected_level(). Returns the level
+ * now in use. Kernels pick it up on their next call.
+ */
+cpu_level set_cpu_dispatch_level(cpu_level level);
+
+const char* cpu_level_name(cpu_level level);
+
+/* Parses a name from cpu_level_name. Returns 0 if it isn't one. */
+int parse_cpu_level(const char* name, cpu_level* level);
+
+int cpu_has_bmi2(void);
+
+#ifdef __cplusplus
+}  // closing brace for extern "C"
+#endif
+
+#endif  // PHEVALUATOR_CPU_DISPATCH_H
@@ -17,6 +17,8 @@
 #ifndef PHEVALUATOR_H
 #define PHEVALUATOR_H
 
+#include <include/cpu_dispatch.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -62,6 +64,30 @@ int evaluate_5cards(int a, int b, int c, int d, int e);
 int evaluate_6cards(int a, int b, int c, int d, int e, int f);
 int evaluate_7cards(int a, int b, int c, int d, int e, int f, int g);
 
+/*
+ * Board context for evaluating many hands on the same board cards.
+ * The board's rank counts and suit bits are computed once, so each
+ * evaluation only adds the hand's cards.
+ */
+typedef struct {
+  int num_cards;
+  int suit_hash;
+  int suit_binary[4];
+  unsigned char quinary[13];
+} board_context;
+
+void init_board_context(board_context* board, const int cards[],
+                        int num_cards);
+
+/*
+ * Evaluates num_hands hands of hand_size cards each against the board.
+ * Hand i is hands[i * hand_size] to hands[i * hand_size + hand_size - 1], and
+ * its rank is written to ranks[i].
+ * The board and a hand must make 5, 6 or 7 cards together.
+ */
+void evaluate_batch(const board_context* board, const int hands[],
+                    int hand_size, int num_hands, int ranks[]);
+
 /*
  * The first five parameters are the community cards on the board
  * The last four parameters are the hole cards of the player
@@ -69,6 +95,44 @@ int evaluate_7cards(int a, int b, int c, int d, int e, int f, int g);
 int evaluate_plo4_cards(int c1, int c2, int c3, int c4, int c5, int h1, int h2,
                         int h3, int h4);
 
+/*
+ * PLO4 board context: everything evaluate_plo4_cards works out from the five
+ * board cards, including where the board's rows of the PLO4 tables start.
+ */
+typedef struct {
+  int noflush_hash;
+  int flush_suit; /* the suit with 3 or more cards, or -1 */
+  const short* noflush_row; /* NULL with PHEVALUATOR_COMPACT_PLO4 */
+  const short* flush_row; /* NULL if flush_suit is -1 */
+} plo4_board_context;
+
+void init_plo4_board_context(plo4_board_context* board, const int cards[]);
+
+/*
+ * Index of the four hole cards, in any order, in 0 to 270724.
+ * The index is colex over the sorted cards: c0 + C(c1, 2) + C(c2, 3) +
+ * C(c3, 4), the same as the solver's hand_index.
+ */
+int plo4_hole_index(const int hole[]);
+
+/*
+ * Rank of the hole with index hole_index on the board. The hole's hashes are
+ * precomputed for every index, so this is one small key load plus the table
+ * lookups.
+ */
+int evaluate_plo4_hole(const plo4_board_context* board, int hole_index);
+
+/*
+ * Evaluates one PLO4 hole (hole[0] to hole[3]) on num_boards boards of five
+ * cards each. Board i is boards[i * 5] to boards[i * 5 + 4], and its rank is
+ * written to ranks[i].
+ * Large batches read the hole-major copy of the PLO4 tables, where all the
+ * entries of one hole are contiguous. Small ones evaluate hand by hand, so
+ * they don't pay for building that copy.
+ */
+void evaluate_plo4_boards(const int hole[], const int boards[],
+                          int num_boards, int ranks[]);
+
 /*
  * The first five parameters are the community cards on the board
  * The last four parameters are the hole cards of the player
@@ -80,6 +144,9 @@ int evaluate_omaha_cards(int c1, int c2, int c3, int c4, int c5, int h1, int h2,
 /*
  * The first five parameters are the community cards on the board
  * The last five parameters are the hole cards of the player
+ * The first call generates the PLO5 tables (about 100MB) in memory, which
+ * takes a few seconds. They are only cached on disk if
+ * PHEVALUATOR_CACHE_DIR is set (see omaha_tables.h).
  */
 int evaluate_plo5_cards(int c1, int c2, int c3, int c4, int c5, int h1, int h2,
                         int h3, int h4, int h5);
@@ -87,6 +154,9 @@ int evaluate_plo5_cards(int c1, int c2, int c3, int c4, int c5, int h1, int h2,
 /*
  * The first five parameters are the community cards on the board
  * The last six parameters are the hole cards of the player
+ * The first call generates the PLO6 tables (about 300MB) in memory, which
+ * takes a few seconds. They are only cached on disk if
+ * PHEVALUATOR_CACHE_DIR is set (see omaha_tables.h).
  */
 int evaluate_plo6_cards(int c1, int c2, int c3, int c4, int c5, int h1, int h2,
                         int h3, int h4, int h5, int h6);
@@ -8,11 +8,13 @@
 #include <vector>
 
 namespace card_sampler {
-static unsigned seed =
-    std::chrono::system_clock::now().time_since_epoch().count();
-static std::default_random_engine generator(seed);
+CardSampler::CardSampler(void)
+    : CardSampler(
+          std::chrono::system_clock::now().time_since_epoch().count()) {}
 
-CardSampler::CardSampler(void) { std::iota(deck.begin(), deck.end(), 0); }
+CardSampler::CardSampler(unsigned int seed) : generator(seed) {
+  std::iota(deck.begin(), deck.end(), 0);
+}
 
 std::vector<int> CardSampler::sample(int size) {
   std::vector<int> ret;
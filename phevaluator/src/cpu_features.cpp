@@ -0,0 +1,108 @@
+/*
+ *  Copyright 2016 Henry Lee
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "src/cpu_features.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+namespace phevaluator {
+
+std::atomic<int> dispatch_level(-1);
+
+int resolve_dispatch_level() {
+  int level = cpu_detected_level();
+
+  cpu_level requested;
+  const char* isa = getenv("PHEVALUATOR_ISA");
+  if (isa != NULL && parse_cpu_level(isa, &requested) && requested < level) {
+    level = requested;
+  }
+
+  // racing threads all compute the same level.
+  dispatch_level.store(level, std::memory_order_relaxed);
+  return level;
+}
+
+}  // namespace phevaluator
+
+static const char* const LEVEL_NAMES[CPU_NUM_LEVELS] = {"scalar", "sse4.2",
+                                                        "avx2", "avx512"};
+
+cpu_level cpu_detected_level(void) {
+#ifdef PHEVALUATOR_X86_TARGETS
+  // __builtin_cpu_init is needed when this runs before main.
+  static const cpu_level detected = [] {
+    __builtin_cpu_init();
+    if (!__builtin_cpu_supports("sse4.2") ||
+        !__builtin_cpu_supports("popcnt")) {
+      return CPU_LEVEL_SCALAR;
+    }
+    if (!__builtin_cpu_supports("avx2") || !__builtin_cpu_supports("fma") ||
+        !__builtin_cpu_supports("bmi") || !__builtin_cpu_supports("bmi2")) {
+      return CPU_LEVEL_SSE42;
+    }
+    if (!__builtin_cpu_supports("avx512f") ||
+        !__builtin_cpu_supports("avx512bw") ||
+        !__builtin_cpu_supports("avx512dq") ||
+        !__builtin_cpu_supports("avx512vl")) {
+      return CPU_LEVEL_AVX2;
+    }
+    return CPU_LEVEL_AVX512;
+  }();
+  return detected;
+#else
+  return CPU_LEVEL_SCALAR;
+#endif
+}
+
+cpu_level cpu_dispatch_level(void) {
+  int level = phevaluator::dispatch_level.load(std::memory_order_relaxed);
+  if (level < 0) level = phevaluator::resolve_dispatch_level();
+  return (cpu_level)level;
+}
+
+cpu_level set_cpu_dispatch_level(cpu_level level) {
+  if (level < CPU_LEVEL_SCALAR) level = CPU_LEVEL_SCALAR;
+  if (level > cpu_detected_level()) level = cpu_detected_level();
+  phevaluator::dispatch_level.store(level, std::memory_order_relaxed);
+  return level;
+}
+
+const char* cpu_level_name(cpu_level level) {
+  if (level < CPU_LEVEL_SCALAR || level >= CPU_NUM_LEVELS) return "unknown";
+  return LEVEL_NAMES[level];
+}
+
+int parse_cpu_level(const char* name, cpu_level* level) {
+  for (int i = 0; i < CPU_NUM_LEVELS; i++) {
+    if (strcmp(name, LEVEL_NAMES[i]) == 0) {
+      *level = (cpu_level)i;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+int cpu_has_bmi2(void) {
+#ifdef PHEVALUATOR_X86_TARGETS
+  static const int has_bmi2 = (__builtin_cpu_init(),
+                               __builtin_cpu_supports("bmi2"));
+  return has_bmi2;
+#else
+  return 0;
+#endif
+}
@@ -0,0 +1,66 @@
+/*
+ *  Copyright 2016 Henry Lee
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef CPU_FEATURES_H
+#define CPU_FEATURES_H
+
+#include "include/cpu_dispatch.h"
+
+/*
+ * Target attributes for the per-level kernel versions (see cpu_dispatch.h).
+ * Only GCC and Clang on x86 build the ISA specific versions. Elsewhere every
+ * level runs the scalar code.
+ */
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define PHEVALUATOR_X86_TARGETS 1
+#define PHEVALUATOR_TARGET(isa) __attribute__((target(isa)))
+#define PHEVALUATOR_INLINE inline __attribute__((always_inline))
+#else
+#define PHEVALUATOR_TARGET(isa)
+#define PHEVALUATOR_INLINE inline
+#endif
+
+#ifdef __cplusplus
+
+#include <atomic>
+
+namespace phevaluator {
+
+// The dispatch level, or -1 until the first kernel call reads the CPU and
+// PHEVALUATOR_ISA.
+extern std::atomic<int> dispatch_level;
+int resolve_dispatch_level();
+
+// A kernel with one version per cpu_level, indexed by the level. Aggregate
+// initialised, so kernels defined at namespace scope are ready before any
+// static constructor runs.
+template <typename Fn>
+struct DispatchedKernel {
+  Fn versions[CPU_NUM_LEVELS];
+
+  Fn get() const {
+    int level = dispatch_level.load(std::memory_order_relaxed);
+    if (level < 0) level = resolve_dispatch_level();
+    return versions[level];
+  }
+};
+
+}  // namespace phevaluator
+
+#endif  // __cplusplus
+
+#endif  // CPU_FEATURES_H
@@ -0,0 +1,325 @@
+/*
+ *  Copyright 2016-2023 Henry Lee
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <string.h>
+
+#include "src/cpu_features.h"
+#include "src/hash.h"
+#include "tables/tables.h"
+#include "include/phevaluator.h"
+
+#ifdef PHEVALUATOR_X86_TARGETS
+#include <immintrin.h>
+#endif
+
+void init_board_context(board_context* board, const int cards[],
+                        int num_cards) {
+  memset(board, 0, sizeof(*board));
+  board->num_cards = num_cards;
+
+  for (int i = 0; i < num_cards; i++) {
+    const int c = cards[i];
+    board->suit_hash += bit_of_mod_4_x_3[c];         // (1 << ((c % 4) * 3))
+    board->suit_binary[c & 0x3] |= bit_of_div_4[c];  // (1 << (c / 4))
+    board->quinary[(c >> 2)]++;
+  }
+}
+
+static const short* noflush_table(int num_cards) {
+  return num_cards == 5 ? noflush5 : num_cards == 6 ? noflush6 : noflush7;
+}
+
+// One hand, the plain way. Every version uses it for flushes and for the
+// hands left over after the last full vector.
+static PHEVALUATOR_INLINE int evaluate_one(const board_context* board,
+                                           const int* hand, int hand_size) {
+  const int num_cards = board->num_cards + hand_size;
+
+  int suit_hash = board->suit_hash;
+  for (int j = 0; j < hand_size; j++) {
+    suit_hash += bit_of_mod_4_x_3[hand[j]];
+  }
+
+  if (suits[suit_hash]) {
+    // only the flush suit matters.
+    const int suit = suits[suit_hash] - 1;
+    int suit_binary = board->suit_binary[suit];
+    for (int j = 0; j < hand_size; j++) {
+      if ((hand[j] & 0x3) == suit) {
+        suit_binary |= bit_of_div_4[hand[j]];
+      }
+    }
+
+    return flush[suit_binary];
+  }
+
+  unsigned char quinary[13];
+  memcpy(quinary, board->quinary, sizeof(quinary));
+  for (int j = 0; j < hand_size; j++) {
+    quinary[(hand[j] >> 2)]++;
+  }
+
+  return noflush_table(num_cards)[hash_quinary(quinary, num_cards)];
+}
+
+static void evaluate_batch_scalar(const board_context* board,
+                                  const int hands[], int hand_size,
+                                  int num_hands, int ranks[]) {
+  for (int i = 0; i < num_hands; i++) {
+    ranks[i] = evaluate_one(board, hands + i * hand_size, hand_size);
+  }
+}
+
+#ifdef PHEVALUATOR_X86_TARGETS
+
+// Without gathers there is nothing to vectorise across hands, so the SSE4.2
+// version is the scalar loop compiled for SSE4.2/POPCNT.
+PHEVALUATOR_TARGET("sse4.2,popcnt")
+static void evaluate_batch_sse42(const board_context* board,
+                                 const int hands[], int hand_size,
+                                 int num_hands, int ranks[]) {
+  for (int i = 0; i < num_hands; i++) {
+    ranks[i] = evaluate_one(board, hands + i * hand_size, hand_size);
+  }
+}
+
+/*
+ * The AVX2 and AVX-512 versions evaluate 8 or 16 hands at a time:
+ * - the suit hash and ranks of each hand are worked out from its gathered
+ *   cards with shifts, instead of table lookups,
+ * - the quinary hash walks the 13 ranks for all lanes at once, gathering
+ *   dp[q][12 - rank][k] for the lanes that still have cards left (k > 0),
+ * - the noflush rank is gathered, and the (rare) flushes are redone one by
+ *   one with evaluate_one.
+ *
+ * 32 bit gathers from the short and char tables would read past the end of
+ * the table for its last entries, so they read the 4 bytes that end at the
+ * entry instead (or start at it, near the start of the table) and shift.
+ */
+#define AVX2_TARGET "avx2,fma,bmi,bmi2"
+#define AVX512_TARGET AVX2_TARGET ",avx512f,avx512bw,avx512dq,avx512vl"
+
+PHEVALUATOR_TARGET(AVX2_TARGET)
+static inline __m256i gather_short_avx2(const short* table, __m256i index) {
+  const __m256i offset = _mm256_max_epi32(
+      _mm256_sub_epi32(index, _mm256_set1_epi32(1)), _mm256_setzero_si256());
+  const __m256i v = _mm256_i32gather_epi32((const int*)table, offset, 2);
+  const __m256i shift = _mm256_slli_epi32(_mm256_sub_epi32(index, offset), 4);
+  return _mm256_and_si256(_mm256_srlv_epi32(v, shift),
+                          _mm256_set1_epi32(0xFFFF));
+}
+
+PHEVALUATOR_TARGET(AVX2_TARGET)
+static inline __m256i gather_byte_avx2(const unsigned char* table,
+                                       __m256i index) {
+  const __m256i offset = _mm256_max_epi32(
+      _mm256_sub_epi32(index, _mm256_set1_epi32(3)), _mm256_setzero_si256());
+  const __m256i v = _mm256_i32gather_epi32((const int*)table, offset, 1);
+  const __m256i shift = _mm256_slli_epi32(_mm256_sub_epi32(index, offset), 3);
+  return _mm256_and_si256(_mm256_srlv_epi32(v, shift),
+                          _mm256_set1_epi32(0xFF));
+}
+
+PHEVALUATOR_TARGET(AVX2_TARGET)
+static void evaluate_batch_avx2(const board_context* board, const int hands[],
+                                int hand_size, int num_hands, int ranks[]) {
+  const int num_cards = board->num_cards + hand_size;
+  const short* noflush = noflush_table(num_cards);
+  const int* dp_table = &dp[0][0][0];
+
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i one = _mm256_set1_epi32(1);
+  const __m256i three = _mm256_set1_epi32(3);
+  const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+  int i = 0;
+  for (; i + 8 <= num_hands; i += 8) {
+    const __m256i first_card = _mm256_mullo_epi32(
+        _mm256_add_epi32(_mm256_set1_epi32(i), lanes),
+        _mm256_set1_epi32(hand_size));
+
+    __m256i rank[7];
+    __m256i suit_hash = _mm256_set1_epi32(board->suit_hash);
+    for (int j = 0; j < hand_size; j++) {
+      const __m256i card = _mm256_i32gather_epi32(
+          hands, _mm256_add_epi32(first_card, _mm256_set1_epi32(j)), 4);
+      rank[j] = _mm256_srli_epi32(card, 2);
+      // 1 << ((card % 4) * 3)
+      const __m256i suit_shift =
+          _mm256_mullo_epi32(_mm256_and_si256(card, three), three);
+      suit_hash =
+          _mm256_add_epi32(suit_hash, _mm256_sllv_epi32(one, suit_shift));
+    }
+    const __m256i flush_suit = gather_byte_avx2(suits, suit_hash);
+
+    __m256i k = _mm256_set1_epi32(num_cards);
+    __m256i sum = zero;
+    for (int r = 0; r < 13; r++) {
+      const __m256i active = _mm256_cmpgt_epi32(k, zero);
+      if (_mm256_testz_si256(active, active)) break;
+
+      __m256i q = _mm256_set1_epi32(board->quinary[r]);
+      for (int j = 0; j < hand_size; j++) {
+        q = _mm256_sub_epi32(
+            q, _mm256_cmpeq_epi32(rank[j], _mm256_set1_epi32(r)));
+      }
+
+      // dp[q][12 - r][k]
+      const __m256i index = _mm256_add_epi32(
+          _mm256_add_epi32(_mm256_mullo_epi32(q, _mm256_set1_epi32(140)),
+                           _mm256_set1_epi32((12 - r) * 10)),
+          k);
+      sum = _mm256_add_epi32(
+          sum, _mm256_mask_i32gather_epi32(zero, dp_table, index, active, 4));
+      k = _mm256_sub_epi32(k, q);
+    }
+
+    _mm256_storeu_si256((__m256i*)(ranks + i), gather_short_avx2(noflush, sum));
+
+    unsigned int flushes = _mm256_movemask_ps(
+        _mm256_castsi256_ps(_mm256_cmpgt_epi32(flush_suit, zero)));
+    for (; flushes; flushes &= flushes - 1) {
+      const int h = i + _tzcnt_u32(flushes);
+      ranks[h] = evaluate_one(board, hands + h * hand_size, hand_size);
+    }
+  }
+
+  for (; i < num_hands; i++) {
+    ranks[i] = evaluate_one(board, hands + i * hand_size, hand_size);
+  }
+}
+
+// GCC 12 warns that the undefined operand the AVX-512 intrinsics pass to
+// their unmasked builtins may be used uninitialized. It is never read.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+PHEVALUATOR_TARGET(AVX512_TARGET)
+static inline __m512i gather_short_avx512(const short* table, __m512i index) {
+  const __m512i offset = _mm512_max_epi32(
+      _mm512_sub_epi32(index, _mm512_set1_epi32(1)), _mm512_setzero_si512());
+  const __m512i v = _mm512_i32gather_epi32(offset, table, 2);
+  const __m512i shift = _mm512_slli_epi32(_mm512_sub_epi32(index, offset), 4);
+  return _mm512_and_si512(_mm512_srlv_epi32(v, shift),
+                          _mm512_set1_epi32(0xFFFF));
+}
+
+PHEVALUATOR_TARGET(AVX512_TARGET)
+static inline __m512i gather_byte_avx512(const unsigned char* table,
+                                         __m512i index) {
+  const __m512i offset = _mm512_max_epi32(
+      _mm512_sub_epi32(index, _mm512_set1_epi32(3)), _mm512_setzero_si512());
+  const __m512i v = _mm512_i32gather_epi32(offset, table, 1);
+  const __m512i shift = _mm512_slli_epi32(_mm512_sub_epi32(index, offset), 3);
+  return _mm512_and_si512(_mm512_srlv_epi32(v, shift),
+                          _mm512_set1_epi32(0xFF));
+}
+
+PHEVALUATOR_TARGET(AVX512_TARGET)
+static void evaluate_batch_avx512(const board_context* board,
+                                  const int hands[], int hand_size,
+                                  int num_hands, int ranks[]) {
+  const int num_cards = board->num_cards + hand_size;
+  const short* noflush = noflush_table(num_cards);
+  const int* dp_table = &dp[0][0][0];
+
+  const __m512i zero = _mm512_setzero_si512();
+  const __m512i one = _mm512_set1_epi32(1);
+  const __m512i three = _mm512_set1_epi32(3);
+  const __m512i lanes = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10,
+                                          11, 12, 13, 14, 15);
+
+  int i = 0;
+  for (; i + 16 <= num_hands; i += 16) {
+    const __m512i first_card = _mm512_mullo_epi32(
+        _mm512_add_epi32(_mm512_set1_epi32(i), lanes),
+        _mm512_set1_epi32(hand_size));
+
+    __m512i rank[7];
+    __m512i suit_hash = _mm512_set1_epi32(board->suit_hash);
+    for (int j = 0; j < hand_size; j++) {
+      const __m512i card = _mm512_i32gather_epi32(
+          _mm512_add_epi32(first_card, _mm512_set1_epi32(j)), hands, 4);
+      rank[j] = _mm512_srli_epi32(card, 2);
+      // 1 << ((card % 4) * 3)
+      const __m512i suit_shift =
+          _mm512_mullo_epi32(_mm512_and_si512(card, three), three);
+      suit_hash =
+          _mm512_add_epi32(suit_hash, _mm512_sllv_epi32(one, suit_shift));
+    }
+    const __m512i flush_suit = gather_byte_avx512(suits, suit_hash);
+
+    __m512i k = _mm512_set1_epi32(num_cards);
+    __m512i sum = zero;
+    for (int r = 0; r < 13; r++) {
+      const __mmask16 active = _mm512_cmpgt_epi32_mask(k, zero);
+      if (active == 0) break;
+
+      __m512i q = _mm512_set1_epi32(board->quinary[r]);
+      for (int j = 0; j < hand_size; j++) {
+        const __mmask16 is_rank =
+            _mm512_cmpeq_epi32_mask(rank[j], _mm512_set1_epi32(r));
+        q = _mm512_mask_add_epi32(q, is_rank, q, one);
+      }
+
+      // dp[q][12 - r][k]
+      const __m512i index = _mm512_add_epi32(
+          _mm512_add_epi32(_mm512_mullo_epi32(q, _mm512_set1_epi32(140)),
+                           _mm512_set1_epi32((12 - r) * 10)),
+          k);
+      sum = _mm512_add_epi32(
+          sum, _mm512_mask_i32gather_epi32(zero, active, index, dp_table, 4));
+      k = _mm512_sub_epi32(k, q);
+    }
+
+    _mm512_storeu_si512(ranks + i, gather_short_avx512(noflush, sum));
+
+    unsigned int flushes = _mm512_cmpgt_epi32_mask(flush_suit, zero);
+    for (; flushes; flushes &= flushes - 1) {
+      const int h = i + _tzcnt_u32(flushes);
+      ranks[h] = evaluate_one(board, hands + h * hand_size, hand_size);
+    }
+  }
+
+  for (; i < num_hands; i++) {
+    ranks[i] = evaluate_one(board, hands + i * hand_size, hand_size);
+  }
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+static const phevaluator::DispatchedKernel<void (*)(
+    const board_context*, const int[], int, int, int[])>
+    evaluate_batch_kernel = {{evaluate_batch_scalar, evaluate_batch_sse42,
+                              evaluate_batch_avx2, evaluate_batch_avx512}};
+
+#else
+
+static const phevaluator::DispatchedKernel<void (*)(
+    const board_context*, const int[], int, int, int[])>
+    evaluate_batch_kernel = {{evaluate_batch_scalar, evaluate_batch_scalar,
+                              evaluate_batch_scalar, evaluate_batch_scalar}};
+
+#endif
+
+void evaluate_batch(const board_context* board, const int hands[],
+                    int hand_size, int num_hands, int ranks[]) {
+  evaluate_batch_kernel.get()(board, hands, hand_size, num_hands, ranks);
+}
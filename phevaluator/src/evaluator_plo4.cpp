@@ -15,30 +15,10 @@
  */
 
 #include "src/hash.h"
+#include "src/omaha_tables.h"
 #include "tables/tables.h"
 #include "include/phevaluator.h"
 
-static int hash_binary(const int binary, int k) {
-  // The binary should have 15 bits
-  int sum = 0;
-  int i;
-  const int len = 15;
-
-  for (i = 0; i < len; i++) {
-    if (binary & (1 << i)) {
-      if (len - i - 1 >= k) sum += choose[len - i - 1][k];
-
-      k--;
-
-      if (k == 0) {
-        break;
-      }
-    }
-  }
-
-  return sum;
-}
-
 /*
  * Card id, ranged from 0 to 51.
  * The two least significant bits represent the suit, ranged from 0-3.
@@ -50,6 +30,7 @@ static int hash_binary(const int binary, int k) {
  */
 int evaluate_plo4_cards(int c1, int c2, int c3, int c4, int c5, int h1, int h2,
                         int h3, int h4) {
+  const omaha_tables* tables = plo4_tables();
   int value_flush = 10000;
   int value_noflush = 10000;
   int suit_count_board[4] = {0};
@@ -100,7 +81,7 @@ int evaluate_plo4_cards(int c1, int c2, int c3, int c4, int c5, int h1, int h2,
         const int board_hash = hash_binary(suit_binary_board[i], 5);
         const int hole_hash = hash_binary(suit_binary_hole[i], 4);
 
-        value_flush = flush_plo4[board_hash * 1365 + hole_hash];
+        value_flush = tables->flush[board_hash * 1365 + hole_hash];
       }
 
       break;
@@ -124,7 +105,11 @@ int evaluate_plo4_cards(int c1, int c2, int c3, int c4, int c5, int h1, int h2,
   const int board_hash = hash_quinary(quinary_board, 5);
   const int hole_hash = hash_quinary(quinary_hole, 4);
 
-  value_noflush = noflush_plo4[board_hash * 1820 + hole_hash];
+#ifdef PHEVALUATOR_COMPACT_PLO4
+  value_noflush = plo4_compact_noflush(plo4_compact(), board_hash, hole_hash);
+#else
+  value_noflush = tables->noflush[board_hash * 1820 + hole_hash];
+#endif
 
   if (value_flush < value_noflush)
     return value_flush;
@@ -132,6 +117,151 @@ int evaluate_plo4_cards(int c1, int c2, int c3, int c4, int c5, int h1, int h2,
     return value_noflush;
 }
 
+void init_plo4_board_context(plo4_board_context* board, const int cards[]) {
+  const omaha_tables* tables = plo4_tables();
+
+  int suit_count[4] = {0};
+  int suit_binary[4] = {0};
+  unsigned char quinary[13] = {0};
+  for (int j = 0; j < 5; j++) {
+    suit_count[cards[j] & 0x3]++;
+    suit_binary[cards[j] & 0x3] |= bit_of_div_4[cards[j]];
+    quinary[(cards[j] >> 2)]++;
+  }
+
+  board->noflush_hash = hash_quinary(quinary, 5);
+#ifdef PHEVALUATOR_COMPACT_PLO4
+  board->noflush_row = NULL;
+#else
+  board->noflush_row = tables->noflush + board->noflush_hash * 1820;
+#endif
+  board->flush_suit = -1;
+  board->flush_row = NULL;
+
+  for (int s = 0; s < 4; s++) {
+    if (suit_count[s] >= 3) {
+      const int padding[3] = {0x0000, 0x2000, 0x6000};
+      const int binary = suit_binary[s] | padding[5 - suit_count[s]];
+      board->flush_suit = s;
+      board->flush_row = tables->flush + hash_binary(binary, 5) * 1365;
+      break;
+    }
+  }
+}
+
+int plo4_hole_index(const int hole[]) {
+  int c[4] = {hole[0], hole[1], hole[2], hole[3]};
+  // sorting network
+  int t;
+#define SWAP(i, j) \
+  if (c[i] > c[j]) { t = c[i]; c[i] = c[j]; c[j] = t; }
+  SWAP(0, 1);
+  SWAP(2, 3);
+  SWAP(0, 2);
+  SWAP(1, 3);
+  SWAP(1, 2);
+#undef SWAP
+  return c[0] + choose[c[1]][2] + choose[c[2]][3] + choose[c[3]][4];
+}
+
+int evaluate_plo4_hole(const plo4_board_context* board, int hole_index) {
+  const plo4_hole_key key = plo4_hole_keys()[hole_index];
+
+#ifdef PHEVALUATOR_COMPACT_PLO4
+  int value = plo4_compact_noflush(plo4_compact(), board->noflush_hash,
+                                   key.noflush_hash);
+#else
+  int value = board->noflush_row[key.noflush_hash];
+#endif
+
+  if (board->flush_suit >= 0 && key.flush_hash[board->flush_suit] >= 0) {
+    const int value_flush = board->flush_row[key.flush_hash[board->flush_suit]];
+    if (value_flush < value) value = value_flush;
+  }
+  return value;
+}
+
+// Batches smaller than this evaluate hand by hand.
+static const int HOLE_MAJOR_MIN_BOARDS = 64;
+
+void evaluate_plo4_boards(const int hole[], const int boards[],
+                          int num_boards, int ranks[]) {
+  if (num_boards < HOLE_MAJOR_MIN_BOARDS) {
+    for (int i = 0; i < num_boards; i++) {
+      const int* b = boards + i * 5;
+      ranks[i] = evaluate_plo4_cards(b[0], b[1], b[2], b[3], b[4], hole[0],
+                                     hole[1], hole[2], hole[3]);
+    }
+    return;
+  }
+
+  const omaha_tables* tables = plo4_hole_major_tables();
+  const int padding[3] = {0x0000, 0x2000, 0x6000};
+
+  // everything about the hole is worked out once, for all the boards.
+  int suit_count_hole[4] = {0};
+  int suit_binary_hole[4] = {0};
+  unsigned char quinary_hole[13] = {0};
+  for (int j = 0; j < 4; j++) {
+    suit_count_hole[hole[j] & 0x3]++;
+    suit_binary_hole[hole[j] & 0x3] |= bit_of_div_4[hole[j]];
+    quinary_hole[(hole[j] >> 2)]++;
+  }
+
+  const int hole_hash = hash_quinary(quinary_hole, 4);
+#ifdef PHEVALUATOR_COMPACT_PLO4
+  const plo4_compact_tables* compact = plo4_compact();
+#else
+  const short* noflush_row = tables->noflush + hole_hash * 6175;
+#endif
+  const short* flush_row[4] = {0};
+  for (int s = 0; s < 4; s++) {
+    if (suit_count_hole[s] >= 2) {
+      const int binary = suit_binary_hole[s] | padding[4 - suit_count_hole[s]];
+      flush_row[s] = tables->flush + hash_binary(binary, 4) * 3003;
+    }
+  }
+
+  for (int i = 0; i < num_boards; i++) {
+    const int* b = boards + i * 5;
+
+    int suit_count_board[4] = {0};
+    unsigned char quinary_board[13] = {0};
+    for (int j = 0; j < 5; j++) {
+      suit_count_board[b[j] & 0x3]++;
+      quinary_board[(b[j] >> 2)]++;
+    }
+
+#ifdef PHEVALUATOR_COMPACT_PLO4
+    int value = plo4_compact_noflush(compact, hash_quinary(quinary_board, 5),
+                                     hole_hash);
+#else
+    int value = noflush_row[hash_quinary(quinary_board, 5)];
+#endif
+
+    for (int s = 0; s < 4; s++) {
+      if (suit_count_board[s] >= 3 && flush_row[s]) {
+        int suit_binary_board = 0;
+        for (int j = 0; j < 5; j++) {
+          if ((b[j] & 0x3) == s) suit_binary_board |= bit_of_div_4[b[j]];
+        }
+
+        int value_flush;
+        if (suit_count_board[s] == 3 && suit_count_hole[s] == 2) {
+          value_flush = flush[suit_binary_board | suit_binary_hole[s]];
+        } else {
+          suit_binary_board |= padding[5 - suit_count_board[s]];
+          value_flush = flush_row[s][hash_binary(suit_binary_board, 5)];
+        }
+        if (value_flush < value) value = value_flush;
+        break;
+      }
+    }
+
+    ranks[i] = value;
+  }
+}
+
 int evaluate_omaha_cards(int c1, int c2, int c3, int c4, int c5, int h1, int h2,
                          int h3, int h4) {
   return evaluate_plo4_cards(c1, c2, c3, c4, c5, h1, h2, h3, h4);
@@ -17,10 +17,16 @@
 #include "src/hash.h"
 
 #include <stdio.h>
+#include <string.h>
 
+#include "src/cpu_features.h"
 #include "tables/tables.h"
 
-int hash_quinary(const unsigned char q[], int k) {
+#ifdef PHEVALUATOR_X86_TARGETS
+#include <immintrin.h>
+#endif
+
+int hash_quinary_scalar(const unsigned char q[], int k) {
   int sum = 0;
   const int len = 13;
   int i;
@@ -37,3 +43,125 @@ int hash_quinary(const unsigned char q[], int k) {
 
   return sum;
 }
+
+/*
+ * choose[len - i - 1][k] stays inside the table for every len and k that
+ * hash.h allows, which covers the PLO6 holes (17 bits, 6 set).
+ */
+static_assert(sizeof(choose) / sizeof(choose[0]) >= 31 &&
+                  sizeof(choose[0]) / sizeof(choose[0][0]) >= 10,
+              "choose doesn't cover hash_binary_len's bounds");
+
+int hash_binary_len_scalar(const int binary, int len, int k) {
+  int sum = 0;
+  int i;
+
+  for (i = 0; i < len; i++) {
+    if (binary & (1 << i)) {
+      if (len - i - 1 >= k) sum += choose[len - i - 1][k];
+
+      k--;
+
+      if (k == 0) {
+        break;
+      }
+    }
+  }
+
+  return sum;
+}
+
+#ifdef PHEVALUATOR_X86_TARGETS
+
+/*
+ * Empty ranks add dp[0][..][..] = 0, so only the ranks with cards are
+ * visited. Their mask is made with PEXT: each count is at most 4 (3 bits),
+ * so OR-ing a byte's low 3 bits into bit 0 and extracting every bit 0 gives
+ * one bit per rank.
+ */
+PHEVALUATOR_TARGET("bmi,bmi2")
+int hash_quinary_bmi2(const unsigned char q[], int k) {
+  const unsigned long long ONES = 0x0101010101010101ull;
+  unsigned long long lo, hi;
+  memcpy(&lo, q, 8);      // ranks 0 to 7
+  memcpy(&hi, q + 5, 8);  // ranks 5 to 12
+  lo = (lo | (lo >> 1) | (lo >> 2)) & ONES;
+  hi = (hi | (hi >> 1) | (hi >> 2)) & ONES;
+  unsigned int ranks =
+      (unsigned int)(_pext_u64(lo, ONES) | (_pext_u64(hi, ONES) << 5));
+
+  int sum = 0;
+  while (ranks) {
+    const int i = _tzcnt_u32(ranks);
+    sum += dp[q[i]][12 - i][k];
+
+    k -= q[i];
+
+    if (k <= 0) {
+      break;
+    }
+
+    ranks = _blsr_u32(ranks);
+  }
+
+  return sum;
+}
+
+/*
+ * Visits only the set bits, lowest first, in the same order as the scalar
+ * loop.
+ */
+PHEVALUATOR_TARGET("bmi,bmi2")
+int hash_binary_len_bmi2(const int binary, int len, int k) {
+  unsigned int bits = _bzhi_u32(binary, len);
+
+  int sum = 0;
+  while (bits) {
+    const int i = _tzcnt_u32(bits);
+    if (len - i - 1 >= k) sum += choose[len - i - 1][k];
+
+    k--;
+
+    if (k == 0) {
+      break;
+    }
+
+    bits = _blsr_u32(bits);
+  }
+
+  return sum;
+}
+
+#else
+
+int hash_quinary_bmi2(const unsigned char q[], int k) {
+  return hash_quinary_scalar(q, k);
+}
+
+int hash_binary_len_bmi2(const int binary, int len, int k) {
+  return hash_binary_len_scalar(binary, len, k);
+}
+
+#endif
+
+// BMI2 is part of the AVX2 level.
+static const phevaluator::DispatchedKernel<int (*)(const unsigned char[], int)>
+    hash_quinary_kernel = {{hash_quinary_scalar, hash_quinary_scalar,
+                            hash_quinary_bmi2, hash_quinary_bmi2}};
+
+static const phevaluator::DispatchedKernel<int (*)(const int, int, int)>
+    hash_binary_len_kernel = {{hash_binary_len_scalar, hash_binary_len_scalar,
+                               hash_binary_len_bmi2, hash_binary_len_bmi2}};
+
+int hash_quinary(const unsigned char q[], int k) {
+  return hash_quinary_kernel.get()(q, k);
+}
+
+int hash_binary_len(const int binary, int len, int k) {
+  return hash_binary_len_kernel.get()(binary, len, k);
+}
+
+int hash_binary(const int binary, int k) {
+  // The binary should have 15 bits
+  return hash_binary_len(binary, 15, k);
+}
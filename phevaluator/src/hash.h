@@ -23,6 +23,27 @@ extern "C" {
 
 int hash_quinary(const unsigned char q[], int k);
 
+/*
+ * Ranks a binary with k bits set among its lowest len bits. len is at most
+ * 31 and k at most 9, the bounds of the choose table; the longest in use are
+ * the PLO6 holes, 17 bits with 6 set. hash_binary is the 15 bit version,
+ * used by the PLO4 tables.
+ */
+int hash_binary_len(const int binary, int len, int k);
+int hash_binary(const int binary, int k);
+
+/*
+ * hash_quinary and hash_binary_len dispatch to one of these (see
+ * cpu_features.h): the BMI2 versions (PEXT/TZCNT, visiting only the ranks and
+ * bits that are set) from the AVX2 level up, and the plain loops below it.
+ * Both give the same results. Exposed for tests and benchmarks - only call
+ * the BMI2 ones when cpu_has_bmi2().
+ */
+int hash_quinary_scalar(const unsigned char q[], int k);
+int hash_quinary_bmi2(const unsigned char q[], int k);
+int hash_binary_len_scalar(const int binary, int len, int k);
+int hash_binary_len_bmi2(const int binary, int len, int k);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
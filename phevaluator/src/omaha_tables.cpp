@@ -0,0 +1,687 @@
+/*
+ *  Copyright 2016 Henry Lee
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "src/omaha_tables.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/vfs.h>
+#endif
+#elif defined(_WIN32)
+#include <process.h>
+#define getpid _getpid
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "include/phevaluator.h"
+#include "src/hash.h"
+#include "tables/tables.h"
+
+namespace {
+
+const short NO_RANK = 10000;
+
+// Every column of a table is a hole. The holes are stored with the rank pairs
+// they can play (r1 * 13 + r2), so that a cell is just the best of its
+// pairs, given the best rank each pair makes with the board.
+struct HoleColumns {
+  std::vector<int> index;
+  std::vector<int> offset = {0};
+  std::vector<unsigned char> pairs;
+
+  void Add(int column, const std::vector<unsigned char>& hole_pairs) {
+    index.push_back(column);
+    pairs.insert(pairs.end(), hole_pairs.begin(), hole_pairs.end());
+    offset.push_back(pairs.size());
+  }
+
+  void FillRow(short* row, const short best[169]) const {
+    for (size_t h = 0; h < index.size(); h++) {
+      short value = NO_RANK;
+      for (int i = offset[h]; i < offset[h + 1]; i++) {
+        value = std::min(value, best[pairs[i]]);
+      }
+      row[index[h]] = value;
+    }
+  }
+};
+
+int count_bits(int binary) {
+  int count = 0;
+  for (; binary; binary &= binary - 1) count++;
+  return count;
+}
+
+// Calls f(q) for every multiset q of k ranks with q[i] <= limit[i].
+template <typename F>
+void for_each_quinary(const unsigned char limit[13], int k, F f) {
+  unsigned char q[13] = {0};
+  auto recurse = [&](auto& self, int rank, int left) -> void {
+    if (rank == 13) {
+      if (left == 0) f(q);
+      return;
+    }
+    for (int n = 0; n <= limit[rank] && n <= left; n++) {
+      q[rank] = n;
+      self(self, rank + 1, left - n);
+    }
+    q[rank] = 0;
+  };
+  recurse(recurse, 0, k);
+}
+
+// Runs f(0) .. f(n - 1) on all cores.
+template <typename F>
+void parallel_for(int n, F f) {
+  std::atomic<int> next(0);
+  auto worker = [&]() {
+    for (int i; (i = next++) < n;) f(i);
+  };
+
+  const int num_threads = std::max(1u, std::thread::hardware_concurrency());
+  std::vector<std::thread> threads;
+  for (int t = 1; t < num_threads; t++) threads.emplace_back(worker);
+  worker();
+  for (auto& thread : threads) thread.join();
+}
+
+const unsigned char FOUR_OF_EACH[13] = {4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4};
+
+// The rank pairs (r1 * 13 + r2, r1 <= r2) a hole quinary can play.
+std::vector<unsigned char> quinary_pairs(const unsigned char q[13]) {
+  std::vector<unsigned char> pairs;
+  for (int r1 = 0; r1 < 13; r1++) {
+    for (int r2 = r1; r2 < 13; r2++) {
+      if (q[r1] && q[r2] && (r1 != r2 || q[r1] >= 2)) {
+        pairs.push_back(r1 * 13 + r2);
+      }
+    }
+  }
+  return pairs;
+}
+
+std::vector<std::vector<unsigned char>> all_boards() {
+  std::vector<std::vector<unsigned char>> boards;
+  for_each_quinary(FOUR_OF_EACH, 5, [&](const unsigned char q[13]) {
+    boards.emplace_back(q, q + 13);
+  });
+  return boards;
+}
+
+// best[r1 * 13 + r2] = the best non-flush rank of the pair with 3 cards of
+// the board.
+void board_best_pairs(const unsigned char board[13], short best[169]) {
+  std::fill(best, best + 169, NO_RANK);
+  for_each_quinary(board, 3, [&](const unsigned char t[13]) {
+    unsigned char q[13];
+    std::copy(t, t + 13, q);
+    for (int r1 = 0; r1 < 13; r1++) {
+      for (int r2 = r1; r2 < 13; r2++) {
+        q[r1]++;
+        q[r2]++;
+        if (q[r1] <= 4 && q[r2] <= 4) {
+          const short value = noflush5[hash_quinary(q, 5)];
+          best[r1 * 13 + r2] = std::min(best[r1 * 13 + r2], value);
+        }
+        q[r1]--;
+        q[r2]--;
+      }
+    }
+  });
+}
+
+// Non-flush table: one row per 5 card board, one column per hole of
+// hole_size cards.
+void generate_noflush(short* table, int hole_size, int num_holes) {
+  HoleColumns holes;
+  for_each_quinary(FOUR_OF_EACH, hole_size, [&](const unsigned char q[13]) {
+    holes.Add(hash_quinary(q, hole_size), quinary_pairs(q));
+  });
+
+  const auto boards = all_boards();
+  parallel_for(boards.size(), [&](int b) {
+    short best[169];
+    board_best_pairs(boards[b].data(), best);
+    holes.FillRow(table + (size_t)hash_quinary(boards[b].data(), 5) * num_holes,
+                  best);
+  });
+}
+
+// A suit binary as it is keyed in a flush table: the row or column it hashes
+// to, and the ranks it holds without the padding.
+struct FlushKey {
+  int index;
+  int ranks;
+};
+
+// Padded binaries with k bits set among len bits, keyed by hash_binary_len.
+std::vector<FlushKey> padded_keys(int len, int k) {
+  std::vector<FlushKey> keys;
+  for (int binary = 0; binary < (1 << len); binary++) {
+    if (count_bits(binary) == k) {
+      keys.push_back({hash_binary_len(binary, len, k), binary & 0x1FFF});
+    }
+  }
+  return keys;
+}
+
+// Flush table: rows are boards and columns are holes, both suit binaries of
+// the flush suit. The caller fills the table with NO_RANK.
+void generate_flush(short* table, const std::vector<FlushKey>& board_keys,
+                    const std::vector<FlushKey>& hole_keys, int num_holes) {
+  HoleColumns holes;
+  for (const FlushKey& key : hole_keys) {
+    if (count_bits(key.ranks) < 2) continue;
+
+    std::vector<unsigned char> pairs;
+    for (int r1 = 0; r1 < 13; r1++) {
+      for (int r2 = r1 + 1; r2 < 13; r2++) {
+        if ((key.ranks >> r1 & 1) && (key.ranks >> r2 & 1)) {
+          pairs.push_back(r1 * 13 + r2);
+        }
+      }
+    }
+    holes.Add(key.index, pairs);
+  }
+
+  parallel_for(board_keys.size(), [&](int b) {
+    const int board = board_keys[b].ranks;
+    if (count_bits(board) < 3) return;
+
+    // every 3 card subset of the board
+    std::vector<int> triples;
+    for (int t = board; t; t = (t - 1) & board) {
+      if (count_bits(t) == 3) triples.push_back(t);
+    }
+
+    short best[169];
+    std::fill(best, best + 169, NO_RANK);
+    for (int r1 = 0; r1 < 13; r1++) {
+      for (int r2 = r1 + 1; r2 < 13; r2++) {
+        const int pair = (1 << r1) | (1 << r2);
+        if (board & pair) continue;
+        for (int triple : triples) {
+          best[r1 * 13 + r2] =
+              std::min(best[r1 * 13 + r2], flush[triple | pair]);
+        }
+      }
+    }
+
+    holes.FillRow(table + (size_t)board_keys[b].index * num_holes, best);
+  });
+}
+
+// Sizes of the flush and the noflush table for holes of hole_size cards.
+bool table_sizes(int hole_size, size_t* flush_size, size_t* noflush_size) {
+  switch (hole_size) {
+    case 4:
+      *flush_size = 3003 * 1365;
+#ifdef PHEVALUATOR_COMPACT_PLO4
+      // plo4_compact() stands in for the noflush table.
+      *noflush_size = 0;
+#else
+      *noflush_size = 6175 * 1820;
+#endif
+      return true;
+    case 5:
+      *flush_size = 3003 * 4368;
+      *noflush_size = 6175 * 6175;
+      return true;
+    case 6:
+      *flush_size = 3003 * 12376;
+      *noflush_size = 6175 * 18395;
+      return true;
+  }
+  return false;
+}
+
+void generate(int hole_size, short* flush_table, short* noflush_table) {
+  switch (hole_size) {
+    case 4:
+      generate_flush(flush_table, padded_keys(15, 5), padded_keys(15, 4),
+                     1365);
+#ifndef PHEVALUATOR_COMPACT_PLO4
+      generate_noflush(noflush_table, 4, 1820);
+#endif
+      break;
+    case 5:
+      generate_flush(flush_table, padded_keys(15, 5), padded_keys(16, 5),
+                     4368);
+      generate_noflush(noflush_table, 5, 6175);
+      break;
+    case 6:
+      generate_flush(flush_table, padded_keys(15, 5), padded_keys(17, 6),
+                     12376);
+      generate_noflush(noflush_table, 6, 18395);
+      break;
+  }
+}
+
+// A cache file is this header, then the flush table, then the noflush table.
+// Bump CACHE_VERSION whenever the layout or the contents of a table change,
+// so that stale caches get regenerated.
+const unsigned int CACHE_VERSION = 2;
+
+struct CacheHeader {
+  char magic[8];
+  unsigned int version;
+  unsigned int hole_size;
+  unsigned long long flush_size;
+  unsigned long long noflush_size;
+};
+
+CacheHeader cache_header(int hole_size) {
+  CacheHeader header = {{'P', 'H', 'E', 'V', 'T', 'B', 'L', 0},
+                        CACHE_VERSION, (unsigned int)hole_size, 0, 0};
+  size_t flush_size = 0, noflush_size = 0;
+  table_sizes(hole_size, &flush_size, &noflush_size);
+  header.flush_size = flush_size;
+  header.noflush_size = noflush_size;
+  return header;
+}
+
+// Name of the cache file for hole_size. Compact builds cache PLO4 without the
+// noflush table, under another name, so that they don't keep replacing the
+// cache of a flat build sharing the directory.
+std::string cache_name(int hole_size) {
+  size_t flush_size = 0, noflush_size = 0;
+  table_sizes(hole_size, &flush_size, &noflush_size);
+  return "plo" + std::to_string(hole_size) +
+         (noflush_size == 0 ? "-compact" : "") + ".bin";
+}
+
+// $PHEVALUATOR_CACHE_DIR, $XDG_CACHE_HOME/phevaluator or
+// ~/.cache/phevaluator, created if needed. Empty if caching is off. Only the
+// PLO4 tables go to the default directory: the PLO5 and PLO6 ones are
+// hundreds of MB, so they are only cached where PHEVALUATOR_CACHE_DIR says.
+std::string cache_dir(int hole_size) {
+#if defined(__unix__) || defined(__APPLE__)
+  if (const char* dir = getenv("PHEVALUATOR_CACHE_DIR")) {
+    mkdir(dir, 0755);
+    return dir;
+  }
+  if (hole_size != 4) {
+    return "";
+  }
+
+  std::string base;
+  if (const char* xdg = getenv("XDG_CACHE_HOME")) {
+    base = xdg;
+  } else if (const char* home = getenv("HOME")) {
+    base = std::string(home) + "/.cache";
+  } else {
+    return "";
+  }
+  mkdir(base.c_str(), 0755);
+  mkdir((base + "/phevaluator").c_str(), 0755);
+  return base + "/phevaluator";
+#else
+  return "";
+#endif
+}
+
+// set_table_mapping can race with tables being loaded on other threads, so
+// both are atomic. The override is stored before the flag that publishes it.
+std::atomic<bool> mapping_set{false};
+std::atomic<table_mapping> mapping_override{{TABLE_PAGES_DEFAULT, 0}};
+
+// $PHEVALUATOR_HUGEPAGES and $PHEVALUATOR_PREFAULT.
+table_mapping mapping_from_env() {
+  table_mapping mapping = {TABLE_PAGES_DEFAULT, 0};
+  if (const char* pages = getenv("PHEVALUATOR_HUGEPAGES")) {
+    if (strcmp(pages, "madvise") == 0) mapping.pages = TABLE_PAGES_MADVISE;
+    if (strcmp(pages, "hugetlb") == 0) mapping.pages = TABLE_PAGES_HUGETLB;
+  }
+  if (const char* prefault = getenv("PHEVALUATOR_PREFAULT")) {
+    mapping.prefault = strcmp(prefault, "1") == 0;
+  }
+  return mapping;
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+
+// Maps a cache file read only and checks its header. Files on hugetlbfs are
+// rounded up to a whole number of huge pages, so only need to be at least
+// size bytes, and are mapped whole: hugetlbfs mappings (and munmap) must
+// cover whole huge pages. Returns NULL on failure.
+const void* map_cache_file(const std::string& path,
+                           const CacheHeader& expected, size_t size,
+                           bool exact_size, table_mapping mapping) {
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) return NULL;
+
+  int flags = MAP_SHARED;
+#ifdef MAP_POPULATE
+  if (mapping.prefault) flags |= MAP_POPULATE;
+#endif
+
+  struct stat st;
+  size_t length = size;
+  void* data = MAP_FAILED;
+  if (fstat(fd, &st) == 0 && (exact_size ? (size_t)st.st_size == size
+                                         : (size_t)st.st_size >= size)) {
+    length = st.st_size;
+    data = mmap(NULL, length, PROT_READ, flags, fd, 0);
+  }
+  close(fd);
+  if (data == MAP_FAILED) return NULL;
+
+  if (memcmp(data, &expected, sizeof(CacheHeader)) != 0) {
+    munmap(data, length);
+    return NULL;
+  }
+
+#ifdef MADV_HUGEPAGE
+  if (mapping.pages == TABLE_PAGES_MADVISE) {
+    madvise(data, length, MADV_HUGEPAGE);
+  }
+#endif
+#ifndef MAP_POPULATE
+  if (mapping.prefault) {
+    const long page = sysconf(_SC_PAGESIZE);
+    volatile char sum = 0;
+    for (size_t i = 0; i < size; i += page) sum += ((const char*)data)[i];
+  }
+#endif
+  return data;
+}
+
+// Maps this host's copy of the cache file at path on hugetlbfs, making the
+// copy first if no process has yet. Returns NULL if there is no hugetlbfs
+// mount or not enough huge pages.
+const void* map_hugetlb_copy(const std::string& path,
+                             const CacheHeader& expected, size_t size,
+                             table_mapping mapping) {
+#ifdef __linux__
+  const long HUGETLBFS_MAGIC = 0x958458f6;
+  const char* dir = getenv("PHEVALUATOR_HUGETLB_DIR");
+  if (dir == NULL) dir = "/dev/hugepages";
+  struct statfs fs;
+  if (statfs(dir, &fs) != 0 || (long)fs.f_type != HUGETLBFS_MAGIC) {
+    return NULL;
+  }
+
+  const std::string huge_path =
+      std::string(dir) + "/phevaluator-" + cache_name(expected.hole_size);
+  if (const void* data =
+          map_cache_file(huge_path, expected, size, false, mapping)) {
+    return data;
+  }
+
+  // files on hugetlbfs can't be written to, only mapped. The copy is made
+  // under a temporary name and renamed into place, like the cache itself.
+  const void* source = map_cache_file(path, expected, size, true,
+                                      {TABLE_PAGES_DEFAULT, 0});
+  if (source == NULL) return NULL;
+
+  const size_t huge_page = fs.f_bsize;
+  const size_t huge_size = (size + huge_page - 1) / huge_page * huge_page;
+  const std::string tmp_path = huge_path + ".tmp" + std::to_string(getpid());
+  bool ok = false;
+  const int fd = open(tmp_path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+  if (fd >= 0) {
+    void* copy = MAP_FAILED;
+    if (ftruncate(fd, huge_size) == 0) {
+      copy = mmap(NULL, huge_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (copy != MAP_FAILED) {
+      memcpy(copy, source, size);
+      munmap(copy, huge_size);
+      ok = rename(tmp_path.c_str(), huge_path.c_str()) == 0;
+    }
+    if (!ok) unlink(tmp_path.c_str());
+  }
+  munmap((void*)source, size);
+  if (!ok) return NULL;
+
+  return map_cache_file(huge_path, expected, size, false, mapping);
+#else
+  return NULL;
+#endif
+}
+
+#endif
+
+struct OwnedTables {
+  std::vector<short> flush;
+  std::vector<short> noflush;
+  omaha_tables tables;
+};
+
+// Maps the cached tables for hole_size, or generates (and caches) them.
+const omaha_tables* build(OwnedTables& owned, int hole_size) {
+  const std::string dir = cache_dir(hole_size);
+  const std::string path =
+      dir.empty() ? ""
+                  : dir + "/" + cache_name(hole_size);
+  if (!path.empty() &&
+      load_omaha_tables(path.c_str(), hole_size, &owned.tables)) {
+    return &owned.tables;
+  }
+
+  size_t flush_size, noflush_size;
+  table_sizes(hole_size, &flush_size, &noflush_size);
+  owned.flush.assign(flush_size, NO_RANK);
+  owned.noflush.assign(noflush_size, NO_RANK);
+  generate(hole_size, owned.flush.data(), owned.noflush.data());
+  owned.tables = {owned.flush.data(),
+                  noflush_size == 0 ? NULL : owned.noflush.data()};
+
+  // map the file just written, so that this process shares its pages with
+  // every later one, and free the generated copy.
+  if (!path.empty() &&
+      save_omaha_tables(path.c_str(), hole_size, &owned.tables) &&
+      load_omaha_tables(path.c_str(), hole_size, &owned.tables)) {
+    std::vector<short>().swap(owned.flush);
+    std::vector<short>().swap(owned.noflush);
+  }
+  return &owned.tables;
+}
+
+}  // namespace
+
+const omaha_tables* plo4_hole_major_tables(void) {
+  static OwnedTables owned;
+  static const omaha_tables* tables = [] {
+    const omaha_tables* board_major = plo4_tables();
+    owned.flush.resize(3003 * 1365);
+    if (board_major->noflush != NULL) {
+      owned.noflush.resize(6175 * 1820);
+    }
+    parallel_for(1820, [&](int hole) {
+      if (board_major->noflush != NULL) {
+        for (int board = 0; board < 6175; board++) {
+          owned.noflush[hole * 6175 + board] =
+              board_major->noflush[board * 1820 + hole];
+        }
+      }
+      if (hole >= 1365) return;
+      for (int board = 0; board < 3003; board++) {
+        owned.flush[hole * 3003 + board] =
+            board_major->flush[board * 1365 + hole];
+      }
+    });
+    owned.tables = {owned.flush.data(),
+                    owned.noflush.empty() ? NULL : owned.noflush.data()};
+    return &owned.tables;
+  }();
+  return tables;
+}
+
+const plo4_hole_key* plo4_hole_keys(void) {
+  static std::vector<plo4_hole_key> keys(270725);
+  static const plo4_hole_key* tables = [] {
+    const int padding[3] = {0x0000, 0x2000, 0x6000};
+    for (int d = 3; d < 52; d++) {
+      for (int c = 2; c < d; c++) {
+        for (int b = 1; b < c; b++) {
+          for (int a = 0; a < b; a++) {
+            const int hole[4] = {a, b, c, d};
+            int suit_count[4] = {0};
+            int suit_binary[4] = {0};
+            unsigned char quinary[13] = {0};
+            for (int j = 0; j < 4; j++) {
+              suit_count[hole[j] & 0x3]++;
+              suit_binary[hole[j] & 0x3] |= bit_of_div_4[hole[j]];
+              quinary[(hole[j] >> 2)]++;
+            }
+
+            plo4_hole_key& key = keys[plo4_hole_index(hole)];
+            key.noflush_hash = hash_quinary(quinary, 4);
+            for (int s = 0; s < 4; s++) {
+              key.flush_hash[s] =
+                  suit_count[s] < 2
+                      ? -1
+                      : hash_binary(suit_binary[s] | padding[4 - suit_count[s]],
+                                    4);
+            }
+          }
+        }
+      }
+    }
+    return keys.data();
+  }();
+  return tables;
+}
+
+const plo4_compact_tables* plo4_compact(void) {
+  static std::vector<short> best_pair(6175 * 91);
+  static std::vector<unsigned char> hole_pairs(1820 * 6);
+  static const plo4_compact_tables tables = [] {
+    // r1 * 13 + r2 -> index of the pair among the 91 with r1 <= r2
+    unsigned char slot[169] = {0};
+    for (int r1 = 0, n = 0; r1 < 13; r1++) {
+      for (int r2 = r1; r2 < 13; r2++) slot[r1 * 13 + r2] = n++;
+    }
+
+    for_each_quinary(FOUR_OF_EACH, 4, [&](const unsigned char q[13]) {
+      const std::vector<unsigned char> pairs = quinary_pairs(q);
+      unsigned char* out = &hole_pairs[hash_quinary(q, 4) * 6];
+      for (int i = 0; i < 6; i++) {
+        out[i] = slot[pairs[i < (int)pairs.size() ? i : 0]];
+      }
+    });
+
+    for (const auto& board : all_boards()) {
+      short best[169];
+      board_best_pairs(board.data(), best);
+      short* row = &best_pair[hash_quinary(board.data(), 5) * 91];
+      for (int p = 0; p < 169; p++) {
+        if (p / 13 <= p % 13) row[slot[p]] = best[p];
+      }
+    }
+
+    return plo4_compact_tables{best_pair.data(), hole_pairs.data()};
+  }();
+  return &tables;
+}
+
+int save_omaha_tables(const char* path, int hole_size,
+                      const omaha_tables* tables) {
+  const CacheHeader header = cache_header(hole_size);
+  if (header.flush_size == 0) return 0;
+
+  // write to a temporary file and rename it into place, so that a process
+  // loading the cache never sees a partly written file.
+  const std::string tmp_path =
+      std::string(path) + ".tmp" + std::to_string(getpid());
+  FILE* file = fopen(tmp_path.c_str(), "wb");
+  if (file == NULL) return 0;
+
+  bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+            fwrite(tables->flush, sizeof(short), header.flush_size, file) ==
+                header.flush_size &&
+            (header.noflush_size == 0 ||
+             fwrite(tables->noflush, sizeof(short), header.noflush_size,
+                    file) == header.noflush_size);
+  ok = fclose(file) == 0 && ok;
+  ok = ok && rename(tmp_path.c_str(), path) == 0;
+  if (!ok) remove(tmp_path.c_str());
+  return ok;
+}
+
+table_mapping get_table_mapping(void) {
+  static const table_mapping from_env = mapping_from_env();
+  return mapping_set.load() ? mapping_override.load() : from_env;
+}
+
+void set_table_mapping(table_mapping mapping) {
+  mapping_override.store(mapping);
+  mapping_set.store(true);
+}
+
+int load_omaha_tables(const char* path, int hole_size, omaha_tables* tables) {
+#if defined(__unix__) || defined(__APPLE__)
+  const CacheHeader expected = cache_header(hole_size);
+  if (expected.flush_size == 0) return 0;
+  const size_t size =
+      sizeof(CacheHeader) +
+      (expected.flush_size + expected.noflush_size) * sizeof(short);
+
+  table_mapping mapping = get_table_mapping();
+  const void* data = NULL;
+  if (mapping.pages == TABLE_PAGES_HUGETLB) {
+    data = map_hugetlb_copy(path, expected, size, mapping);
+    mapping.pages = TABLE_PAGES_MADVISE;
+  }
+  if (data == NULL) {
+    data = map_cache_file(path, expected, size, true, mapping);
+  }
+  if (data == NULL) return 0;
+
+  // the mapping stays alive for the rest of the process.
+  const short* flush_table =
+      (const short*)((const char*)data + sizeof(CacheHeader));
+  tables->flush = flush_table;
+  tables->noflush =
+      expected.noflush_size == 0 ? NULL : flush_table + expected.flush_size;
+  return 1;
+#else
+  return 0;
+#endif
+}
+
+const omaha_tables* plo4_tables(void) {
+  static OwnedTables owned;
+  static const omaha_tables* tables = build(owned, 4);
+  return tables;
+}
+
+const omaha_tables* plo5_tables(void) {
+  static OwnedTables owned;
+  static const omaha_tables* tables = build(owned, 5);
+  return tables;
+}
+
+const omaha_tables* plo6_tables(void) {
+  static OwnedTables owned;
+  static const omaha_tables* tables = build(owned, 6);
+  return tables;
+}
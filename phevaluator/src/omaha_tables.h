@@ -0,0 +1,180 @@
+/*
+ *  Copyright 2016 Henry Lee
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef OMAHA_TABLES_H
+#define OMAHA_TABLES_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * The lookup tables of an Omaha evaluator, indexed by
+ * board_hash * (number of hole hashes) + hole_hash.
+ *
+ * Each cell holds the best rank the hole can make with the board, using
+ * exactly 2 hole cards and 3 board cards. Cells for holes and boards that
+ * can't make a flush (or can't exist) hold 10000.
+ */
+typedef struct {
+  const short* flush;
+  const short* noflush;
+} omaha_tables;
+
+/*
+ * The Omaha tables are tens to hundreds of megabytes, so rather than being
+ * compiled in as literals, they are generated from flush and noflush5 the
+ * first time they are asked for. Generation runs on all cores, and is thread
+ * safe.
+ *
+ * Generated tables are cached in $PHEVALUATOR_CACHE_DIR, and mapped with mmap
+ * from there, including by the process that generated them. Setting
+ * PHEVALUATOR_CACHE_DIR to an empty string turns the cache off. When it isn't
+ * set, the PLO4 tables (30MB) are cached in $XDG_CACHE_HOME/phevaluator or
+ * ~/.cache/phevaluator, but the PLO5 (100MB) and PLO6 (300MB) ones aren't
+ * cached at all: every process generates them again.
+ *
+ * PLO4: flush[hash_binary(board, 5) * 1365 + hash_binary(hole, 4)]
+ *       noflush[hash_quinary(board, 5) * 1820 + hash_quinary(hole, 4)]
+ * PLO5: flush[hash_binary_len(board, 15, 5) * 4368 +
+ *             hash_binary_len(hole, 16, 5)]
+ *       noflush[hash_quinary(board, 5) * 6175 + hash_quinary(hole, 5)]
+ * PLO6: flush[hash_binary_len(board, 15, 5) * 12376 +
+ *             hash_binary_len(hole, 17, 6)]
+ *       noflush[hash_quinary(board, 5) * 18395 + hash_quinary(hole, 6)]
+ * Flush binaries are padded as in PLO4, so that every row and column is a
+ * suit binary that can occur.
+ *
+ * Built with PHEVALUATOR_COMPACT_PLO4, the PLO4 noflush table is never
+ * generated, cached or mapped, and plo4_tables()->noflush is NULL:
+ * plo4_compact() takes its place.
+ */
+const omaha_tables* plo4_tables(void);
+
+/*
+ * The PLO4 tables transposed, for evaluating one hole on many boards:
+ *   flush[hash_binary(hole, 4) * 3003 + hash_binary(board, 5)]
+ *   noflush[hash_quinary(hole, 4) * 6175 + hash_quinary(board, 5)]
+ * A hole's noflush row is 12KB, so it stays in L1/L2 across a batch.
+ * Built from plo4_tables() on first use. noflush is NULL with
+ * PHEVALUATOR_COMPACT_PLO4.
+ */
+const omaha_tables* plo4_hole_major_tables(void);
+const omaha_tables* plo5_tables(void);
+const omaha_tables* plo6_tables(void);
+
+/*
+ * Everything evaluate_plo4_cards works out from the hole cards, for each of
+ * the 270725 holes, indexed by plo4_hole_index:
+ * noflush_hash is hash_quinary(hole, 4), and flush_hash[suit] is
+ * hash_binary(padded suit binary, 4), or -1 if the hole has fewer than 2
+ * cards of the suit. 10 bytes a hole, 2.7MB in total.
+ */
+typedef struct {
+  short noflush_hash;
+  short flush_hash[4];
+} plo4_hole_key;
+
+const plo4_hole_key* plo4_hole_keys(void);
+
+/*
+ * Compact form of the PLO4 noflush table.
+ *
+ * A non-flush Omaha rank is the best over the rank pairs the hole can play,
+ * so rather than 6175 x 1820 cells (22MB), this keeps the best rank of each
+ * of the 91 rank pairs on every board (1.1MB) and the pairs of every hole:
+ *
+ *   noflush[board_hash * 1820 + hole_hash] == min over i < 6 of
+ *       best_pair[board_hash * 91 + hole_pairs[hole_hash * 6 + i]]
+ *
+ * Holes with fewer than 6 pairs repeat their first one. Six loads from one
+ * 182 byte row of a cache resident table beat one miss to DRAM in random
+ * access showdown loops. Every PLO4 evaluator uses it, and the flat table
+ * isn't built at all, when the library is built with
+ * PHEVALUATOR_COMPACT_PLO4.
+ */
+typedef struct {
+  const short* best_pair;
+  const unsigned char* hole_pairs;
+} plo4_compact_tables;
+
+const plo4_compact_tables* plo4_compact(void);
+
+static inline int plo4_compact_noflush(const plo4_compact_tables* tables,
+                                       int board_hash, int hole_hash) {
+  const short* row = tables->best_pair + board_hash * 91;
+  const unsigned char* pairs = tables->hole_pairs + hole_hash * 6;
+  int value = row[pairs[0]];
+  for (int i = 1; i < 6; i++) {
+    if (row[pairs[i]] < value) value = row[pairs[i]];
+  }
+  return value;
+}
+
+/*
+ * How cache files are mapped. Every process maps the same file, so they all
+ * share one copy of the tables in the page cache.
+ *
+ * pages:
+ * - TABLE_PAGES_DEFAULT: ordinary pages.
+ * - TABLE_PAGES_MADVISE: MADV_HUGEPAGE on the mapping. Kernels that back read
+ *   only file mappings with transparent huge pages use 2MB pages for it.
+ * - TABLE_PAGES_HUGETLB: the cache file is copied once per host into a
+ *   hugetlbfs mount ($PHEVALUATOR_HUGETLB_DIR, by default /dev/hugepages)
+ *   and mapped from there, so every process maps the same reserved huge
+ *   pages. Falls back to TABLE_PAGES_MADVISE if the mount is missing or
+ *   there are too few huge pages reserved.
+ * prefault: map every page when the tables are loaded (MAP_POPULATE),
+ * rather than on first touch, so that startup cost is predictable and the
+ * solver's first iterations don't take the page faults.
+ *
+ * The defaults come from $PHEVALUATOR_HUGEPAGES ("off", "madvise" or
+ * "hugetlb") and $PHEVALUATOR_PREFAULT ("1" to turn it on). Changes only
+ * affect tables loaded afterwards. Thread safe.
+ */
+typedef enum {
+  TABLE_PAGES_DEFAULT,
+  TABLE_PAGES_MADVISE,
+  TABLE_PAGES_HUGETLB
+} table_pages;
+
+typedef struct {
+  table_pages pages;
+  int prefault;
+} table_mapping;
+
+table_mapping get_table_mapping(void);
+void set_table_mapping(table_mapping mapping);
+
+/*
+ * Writes the tables for holes of hole_size cards to a cache file at path.
+ * Returns 1 on success, 0 on failure.
+ */
+int save_omaha_tables(const char* path, int hole_size,
+                      const omaha_tables* tables);
+
+/*
+ * Maps the cache file at path into tables, as get_table_mapping() says.
+ * Returns 0 if the file is missing, truncated, or was written for other
+ * tables or by another version.
+ */
+int load_omaha_tables(const char* path, int hole_size, omaha_tables* tables);
+
+#ifdef __cplusplus
+}  // closing brace for extern "C"
+#endif
+
+#endif  // OMAHA_TABLES_H
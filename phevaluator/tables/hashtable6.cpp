@@ -0,0 +1,1553 @@
+/*
+ *  Copyright 2016 Henry Lee
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "tables/tables.h"
+
+const short noflush6[18395] = {
+    11,   167,  23,   11,   167,  179,  23,   12,   168,  2468, 180,  24,
+    168,  191,  192,  180,  35,   35,   36,   11,   167,  179,  23,   12,
+    1610, 2468, 1676, 24,   168,  2479, 2600, 180,  191,  1742, 192,  35,
+    36,   13,   169,  2469, 181,  25,   169,  2490, 2611, 181,  2480, 2721,
+    2601, 193,  193,  37,   169,  203,  204,  181,  203,  1808, 204,  205,
+    205,  193,  47,   47,   48,   47,   48,   49,   11,   167,  179,  23,
+    12,   1610, 2468, 1676, 24,   168,  2479, 2600, 180,  191,  1742, 192,
+    35,   36,   13,   1611, 2469, 1677, 25,   1621, 1600, 1600, 1687, 2480,
+    1600, 2601, 1743, 1753, 37,   169,  2490, 2611, 181,  2491, 1600, 2612,
+    2721, 2722, 193,  203,  1808, 204,  1809, 1819, 205,  47,   48,   49,
+    14,   170,  2470, 182,  26,   170,  2501, 2622, 182,  2481, 2732, 2602,
+    194,  194,  38,   170,  2501, 2622, 182,  2502, 1600, 2623, 2732, 2733,
+    194,  2492, 2831, 2613, 2831, 2832, 2723, 206,  206,  206,  50,   170,
+    215,  216,  182,  215,  1874, 216,  217,  217,  194,  215,  1874, 216,
+    1875, 1885, 217,  218,  218,  218,  206,  59,   59,   60,   59,   60,
+    61,   59,   60,   61,   62,   11,   167,  179,  23,   12,   1610, 2468,
+    1676, 24,   168,  2479, 2600, 180,  191,  1742, 192,  35,   36,   13,
+    1611, 2469, 1677, 25,   1621, 3326, 3546, 1687, 2480, 3766, 2601, 1743,
+    1753, 37,   169,  2490, 2611, 181,  2491, 3986, 2612, 2721, 2722, 193,
+    203,  1808, 204,  1809, 1819, 205,  47,   48,   49,   14,   1612, 2470,
+    1678, 26,   1622, 3327, 3547, 1688, 2481, 3767, 2602, 1744, 1754, 38,
+    1631, 3336, 3556, 1697, 3381, 1600, 1601, 3776, 1601, 1763, 2492, 3987,
+    2613, 3996, 1601, 2723, 1810, 1820, 1829, 50,   170,  2501, 2622, 182,
+    2502, 4206, 2623, 2732, 2733, 194,  2503, 4207, 2624, 4216, 1601, 2734,
+    2831, 2832, 2833, 206,  215,  1874, 216,  1875, 1885, 217,  1876, 1886,
+    1895, 218,  59,   60,   61,   62,   15,   171,  2471, 183,  27,   171,
+    2512, 2633, 183,  2482, 2743, 2603, 195,  195,  39,   171,  2512, 2633,
+    183,  2513, 4426, 2634, 2743, 2744, 195,  2493, 2842, 2614, 2842, 2843,
+    2724, 207,  207,  207,  51,   171,  2512, 2633, 183,  2513, 4426, 2634,
+    2743, 2744, 195,  2514, 4427, 2635, 4436, 1601, 2745, 2842, 2843, 2844,
+    207,  2504, 2930, 2625, 2930, 2931, 2735, 2930, 2931, 2932, 2834, 219,
+    219,  219,  219,  63,   171,  227,  228,  183,  227,  1940, 228,  229,
+    229,  195,  227,  1940, 228,  1941, 1951, 229,  230,  230,  230,  207,
+    227,  1940, 228,  1941, 1951, 229,  1942, 1952, 1961, 230,  231,  231,
+    231,  231,  219,  71,   71,   72,   71,   72,   73,   71,   72,   73,
+    74,   71,   72,   73,   74,   75,   11,   167,  179,  23,   12,   1610,
+    2468, 1676, 24,   168,  2479, 2600, 180,  191,  1742, 192,  35,   36,
+    13,   1611, 2469, 1677, 25,   1621, 3326, 3546, 1687, 2480, 3766, 2601,
+    1743, 1753, 37,   169,  2490, 2611, 181,  2491, 3986, 2612, 2721, 2722,
+    193,  203,  1808, 204,  1809, 1819, 205,  47,   48,   49,   14,   1612,
+    2470, 1678, 26,   1622, 3327, 3547, 1688, 2481, 3767, 2602, 1744, 1754,
+    38,   1631, 3336, 3556, 1697, 3381, 1600, 3601, 3776, 3821, 1763, 2492,
+    3987, 2613, 3996, 4041, 2723, 1810, 1820, 1829, 50,   170,  2501, 2622,
+    182,  2502, 4206, 2623, 2732, 2733, 194,  2503, 4207, 2624, 4216, 4261,
+    2734, 2831, 2832, 2833, 206,  215,  1874, 216,  1875, 1885, 217,  1876,
+    1886, 1895, 218,  59,   60,   61,   62,   15,   1613, 2471, 1679, 27,
+    1623, 3328, 3548, 1689, 2482, 3768, 2603, 1745, 1755, 39,   1632, 3337,
+    3557, 1698, 3382, 6186, 3602, 3777, 3822, 1764, 2493, 3988, 2614, 3997,
+    4042, 2724, 1811, 1821, 1830, 51,   1640, 3345, 3565, 1706, 3390, 6194,
+    3610, 3785, 3830, 1772, 3426, 6230, 3646, 1602, 1601, 1602, 4005, 4050,
+    1602, 1838, 2504, 4208, 2625, 4217, 4262, 2735, 4225, 4270, 1602, 2834,
+    1877, 1887, 1896, 1904, 63,   171,  2512, 2633, 183,  2513, 4426, 2634,
+    2743, 2744, 195,  2514, 4427, 2635, 4436, 4481, 2745, 2842, 2843, 2844,
+    207,  2515, 4428, 2636, 4437, 4482, 2746, 4445, 4490, 1602, 2845, 2930,
+    2931, 2932, 2933, 219,  227,  1940, 228,  1941, 1951, 229,  1942, 1952,
+    1961, 230,  1943, 1953, 1962, 1970, 231,  71,   72,   73,   74,   75,
+    16,   172,  2472, 184,  28,   172,  2523, 2644, 184,  2483, 2754, 2604,
+    196,  196,  40,   172,  2523, 2644, 184,  2524, 4646, 2645, 2754, 2755,
+    196,  2494, 2853, 2615, 2853, 2854, 2725, 208,  208,  208,  52,   172,
+    2523, 2644, 184,  2524, 4646, 2645, 2754, 2755, 196,  2525, 4647, 2646,
+    4656, 4701, 2756, 2853, 2854, 2855, 208,  2505, 2941, 2626, 2941, 2942,
+    2736, 2941, 2942, 2943, 2835, 220,  220,  220,  220,  64,   172,  2523,
+    2644, 184,  2524, 4646, 2645, 2754, 2755, 196,  2525, 4647, 2646, 4656,
+    4701, 2756, 2853, 2854, 2855, 208,  2526, 4648, 2647, 4657, 4702, 2757,
+    4665, 4710, 1602, 2856, 2941, 2942, 2943, 2944, 220,  2516, 3018, 2637,
+    3018, 3019, 2747, 3018, 3019, 3020, 2846, 3018, 3019, 3020, 3021, 2934,
+    232,  232,  232,  232,  232,  76,   172,  239,  240,  184,  239,  2006,
+    240,  241,  241,  196,  239,  2006, 240,  2007, 2017, 241,  242,  242,
+    242,  208,  239,  2006, 240,  2007, 2017, 241,  2008, 2018, 2027, 242,
+    243,  243,  243,  243,  220,  239,  2006, 240,  2007, 2017, 241,  2008,
+    2018, 2027, 242,  2009, 2019, 2028, 2036, 243,  244,  244,  244,  244,
+    244,  232,  83,   83,   84,   83,   84,   85,   83,   84,   85,   86,
+    83,   84,   85,   86,   87,   83,   84,   85,   86,   87,   88,   11,
+    167,  179,  23,   12,   1610, 2468, 1676, 24,   168,  2479, 2600, 180,
+    191,  1742, 192,  35,   36,   13,   1611, 2469, 1677, 25,   1621, 3326,
+    3546, 1687, 2480, 3766, 2601, 1743, 1753, 37,   169,  2490, 2611, 181,
+    2491, 3986, 2612, 2721, 2722, 193,  203,  1808, 204,  1809, 1819, 205,
+    47,   48,   49,   14,   1612, 2470, 1678, 26,   1622, 3327, 3547, 1688,
+    2481, 3767, 2602, 1744, 1754, 38,   1631, 3336, 3556, 1697, 3381, 1600,
+    3601, 3776, 3821, 1763, 2492, 3987, 2613, 3996, 4041, 2723, 1810, 1820,
+    1829, 50,   170,  2501, 2622, 182,  2502, 4206, 2623, 2732, 2733, 194,
+    2503, 4207, 2624, 4216, 4261, 2734, 2831, 2832, 2833, 206,  215,  1874,
+    216,  1875, 1885, 217,  1876, 1886, 1895, 218,  59,   60,   61,   62,
+    15,   1613, 2471, 1679, 27,   1623, 3328, 3548, 1689, 2482, 3768, 2603,
+    1745, 1755, 39,   1632, 3337, 3557, 1698, 3382, 6186, 3602, 3777, 3822,
+    1764, 2493, 3988, 2614, 3997, 4042, 2724, 1811, 1821, 1830, 51,   1640,
+    3345, 3565, 1706, 3390, 6194, 3610, 3785, 3830, 1772, 3426, 6230, 3646,
+    6350, 1601, 3866, 4005, 4050, 4086, 1838, 2504, 4208, 2625, 4217, 4262,
+    2735, 4225, 4270, 4306, 2834, 1877, 1887, 1896, 1904, 63,   171,  2512,
+    2633, 183,  2513, 4426, 2634, 2743, 2744, 195,  2514, 4427, 2635, 4436,
+    4481, 2745, 2842, 2843, 2844, 207,  2515, 4428, 2636, 4437, 4482, 2746,
+    4445, 4490, 4526, 2845, 2930, 2931, 2932, 2933, 219,  227,  1940, 228,
+    1941, 1951, 229,  1942, 1952, 1961, 230,  1943, 1953, 1962, 1970, 231,
+    71,   72,   73,   74,   75,   16,   1614, 2472, 1680, 28,   1624, 3329,
+    3549, 1690, 2483, 3769, 2604, 1746, 1756, 40,   1633, 3338, 3558, 1699,
+    3383, 6187, 3603, 3778, 3823, 1765, 2494, 3989, 2615, 3998, 4043, 2725,
+    1812, 1822, 1831, 52,   1641, 3346, 3566, 1707, 3391, 6195, 3611, 3786,
+    3831, 1773, 3427, 6231, 3647, 6351, 6679, 3867, 4006, 4051, 4087, 1839,
+    2505, 4209, 2626, 4218, 4263, 2736, 4226, 4271, 4307, 2835, 1878, 1888,
+    1897, 1905, 64,   1648, 3353, 3573, 1714, 3398, 6202, 3618, 3793, 3838,
+    1780, 3434, 6238, 3654, 6358, 6686, 3874, 4013, 4058, 4094, 1846, 3462,
+    6266, 3682, 6386, 6714, 3902, 1603, 1603, 1602, 1603, 4233, 4278, 4314,
+    1603, 1912, 2516, 4429, 2637, 4438, 4483, 2747, 4446, 4491, 4527, 2846,
+    4453, 4498, 4534, 1603, 2934, 1944, 1954, 1963, 1971, 1978, 76,   172,
+    2523, 2644, 184,  2524, 4646, 2645, 2754, 2755, 196,  2525, 4647, 2646,
+    4656, 4701, 2756, 2853, 2854, 2855, 208,  2526, 4648, 2647, 4657, 4702,
+    2757, 4665, 4710, 4746, 2856, 2941, 2942, 2943, 2944, 220,  2527, 4649,
+    2648, 4658, 4703, 2758, 4666, 4711, 4747, 2857, 4673, 4718, 4754, 1603,
+    2945, 3018, 3019, 3020, 3021, 3022, 232,  239,  2006, 240,  2007, 2017,
+    241,  2008, 2018, 2027, 242,  2009, 2019, 2028, 2036, 243,  2010, 2020,
+    2029, 2037, 2044, 244,  83,   84,   85,   86,   87,   88,   17,   173,
+    2473, 185,  29,   173,  2534, 2655, 185,  2484, 2765, 2605, 197,  197,
+    41,   173,  2534, 2655, 185,  2535, 4866, 2656, 2765, 2766, 197,  2495,
+    2864, 2616, 2864, 2865, 2726, 209,  209,  209,  53,   173,  2534, 2655,
+    185,  2535, 4866, 2656, 2765, 2766, 197,  2536, 4867, 2657, 4876, 4921,
+    2767, 2864, 2865, 2866, 209,  2506, 2952, 2627, 2952, 2953, 2737, 2952,
+    2953, 2954, 2836, 221,  221,  221,  221,  65,   173,  2534, 2655, 185,
+    2535, 4866, 2656, 2765, 2766, 197,  2536, 4867, 2657, 4876, 4921, 2767,
+    2864, 2865, 2866, 209,  2537, 4868, 2658, 4877, 4922, 2768, 4885, 4930,
+    4966, 2867, 2952, 2953, 2954, 2955, 221,  2517, 3029, 2638, 3029, 3030,
+    2748, 3029, 3030, 3031, 2847, 3029, 3030, 3031, 3032, 2935, 233,  233,
+    233,  233,  233,  77,   173,  2534, 2655, 185,  2535, 4866, 2656, 2765,
+    2766, 197,  2536, 4867, 2657, 4876, 4921, 2767, 2864, 2865, 2866, 209,
+    2537, 4868, 2658, 4877, 4922, 2768, 4885, 4930, 4966, 2867, 2952, 2953,
+    2954, 2955, 221,  2538, 4869, 2659, 4878, 4923, 2769, 4886, 4931, 4967,
+    2868, 4893, 4938, 4974, 1603, 2956, 3029, 3030, 3031, 3032, 3033, 233,
+    2528, 3095, 2649, 3095, 3096, 2759, 3095, 3096, 3097, 2858, 3095, 3096,
+    3097, 3098, 2946, 3095, 3096, 3097, 3098, 3099, 3023, 245,  245,  245,
+    245,  245,  245,  89,   173,  251,  252,  185,  251,  2072, 252,  253,
+    253,  197,  251,  2072, 252,  2073, 2083, 253,  254,  254,  254,  209,
+    251,  2072, 252,  2073, 2083, 253,  2074, 2084, 2093, 254,  255,  255,
+    255,  255,  221,  251,  2072, 252,  2073, 2083, 253,  2074, 2084, 2093,
+    254,  2075, 2085, 2094, 2102, 255,  256,  256,  256,  256,  256,  233,
+    251,  2072, 252,  2073, 2083, 253,  2074, 2084, 2093, 254,  2075, 2085,
+    2094, 2102, 255,  2076, 2086, 2095, 2103, 2110, 256,  257,  257,  257,
+    257,  257,  257,  245,  95,   95,   96,   95,   96,   97,   95,   96,
+    97,   98,   95,   96,   97,   98,   99,   95,   96,   97,   98,   99,
+    100,  95,   96,   97,   98,   99,   100,  101,  11,   167,  179,  23,
+    12,   1610, 2468, 1676, 24,   168,  2479, 2600, 180,  191,  1742, 192,
+    35,   36,   13,   1611, 2469, 1677, 25,   1621, 3326, 3546, 1687, 2480,
+    3766, 2601, 1743, 1753, 37,   169,  2490, 2611, 181,  2491, 3986, 2612,
+    2721, 2722, 193,  203,  1808, 204,  1809, 1819, 205,  47,   48,   49,
+    14,   1612, 2470, 1678, 26,   1622, 3327, 3547, 1688, 2481, 3767, 2602,
+    1744, 1754, 38,   1631, 3336, 3556, 1697, 3381, 1600, 3601, 3776, 3821,
+    1763, 2492, 3987, 2613, 3996, 4041, 2723, 1810, 1820, 1829, 50,   170,
+    2501, 2622, 182,  2502, 4206, 2623, 2732, 2733, 194,  2503, 4207, 2624,
+    4216, 4261, 2734, 2831, 2832, 2833, 206,  215,  1874, 216,  1875, 1885,
+    217,  1876, 1886, 1895, 218,  59,   60,   61,   62,   15,   1613, 2471,
+    1679, 27,   1623, 3328, 3548, 1689, 2482, 3768, 2603, 1745, 1755, 39,
+    1632, 3337, 3557, 1698, 3382, 6186, 3602, 3777, 3822, 1764, 2493, 3988,
+    2614, 3997, 4042, 2724, 1811, 1821, 1830, 51,   1640, 3345, 3565, 1706,
+    3390, 6194, 3610, 3785, 3830, 1772, 3426, 6230, 3646, 6350, 1601, 3866,
+    4005, 4050, 4086, 1838, 2504, 4208, 2625, 4217, 4262, 2735, 4225, 4270,
+    4306, 2834, 1877, 1887, 1896, 1904, 63,   171,  2512, 2633, 183,  2513,
+    4426, 2634, 2743, 2744, 195,  2514, 4427, 2635, 4436, 4481, 2745, 2842,
+    2843, 2844, 207,  2515, 4428, 2636, 4437, 4482, 2746, 4445, 4490, 4526,
+    2845, 2930, 2931, 2932, 2933, 219,  227,  1940, 228,  1941, 1951, 229,
+    1942, 1952, 1961, 230,  1943, 1953, 1962, 1970, 231,  71,   72,   73,
+    74,   75,   16,   1614, 2472, 1680, 28,   1624, 3329, 3549, 1690, 2483,
+    3769, 2604, 1746, 1756, 40,   1633, 3338, 3558, 1699, 3383, 6187, 3603,
+    3778, 3823, 1765, 2494, 3989, 2615, 3998, 4043, 2725, 1812, 1822, 1831,
+    52,   1641, 3346, 3566, 1707, 3391, 6195, 3611, 3786, 3831, 1773, 3427,
+    6231, 3647, 6351, 6679, 3867, 4006, 4051, 4087, 1839, 2505, 4209, 2626,
+    4218, 4263, 2736, 4226, 4271, 4307, 2835, 1878, 1888, 1897, 1905, 64,
+    1648, 3353, 3573, 1714, 3398, 6202, 3618, 3793, 3838, 1780, 3434, 6238,
+    3654, 6358, 6686, 3874, 4013, 4058, 4094, 1846, 3462, 6266, 3682, 6386,
+    6714, 3902, 6470, 6798, 1602, 4122, 4233, 4278, 4314, 4342, 1912, 2516,
+    4429, 2637, 4438, 4483, 2747, 4446, 4491, 4527, 2846, 4453, 4498, 4534,
+    4562, 2934, 1944, 1954, 1963, 1971, 1978, 76,   172,  2523, 2644, 184,
+    2524, 4646, 2645, 2754, 2755, 196,  2525, 4647, 2646, 4656, 4701, 2756,
+    2853, 2854, 2855, 208,  2526, 4648, 2647, 4657, 4702, 2757, 4665, 4710,
+    4746, 2856, 2941, 2942, 2943, 2944, 220,  2527, 4649, 2648, 4658, 4703,
+    2758, 4666, 4711, 4747, 2857, 4673, 4718, 4754, 4782, 2945, 3018, 3019,
+    3020, 3021, 3022, 232,  239,  2006, 240,  2007, 2017, 241,  2008, 2018,
+    2027, 242,  2009, 2019, 2028, 2036, 243,  2010, 2020, 2029, 2037, 2044,
+    244,  83,   84,   85,   86,   87,   88,   17,   1615, 2473, 1681, 29,
+    1625, 3330, 3550, 1691, 2484, 3770, 2605, 1747, 1757, 41,   1634, 3339,
+    3559, 1700, 3384, 6188, 3604, 3779, 3824, 1766, 2495, 3990, 2616, 3999,
+    4044, 2726, 1813, 1823, 1832, 53,   1642, 3347, 3567, 1708, 3392, 6196,
+    3612, 3787, 3832, 1774, 3428, 6232, 3648, 6352, 6680, 3868, 4007, 4052,
+    4088, 1840, 2506, 4210, 2627, 4219, 4264, 2737, 4227, 4272, 4308, 2836,
+    1879, 1889, 1898, 1906, 65,   1649, 3354, 3574, 1715, 3399, 6203, 3619,
+    3794, 3839, 1781, 3435, 6239, 3655, 6359, 6687, 3875, 4014, 4059, 4095,
+    1847, 3463, 6267, 3683, 6387, 6715, 3903, 6471, 6799, 7008, 4123, 4234,
+    4279, 4315, 4343, 1913, 2517, 4430, 2638, 4439, 4484, 2748, 4447, 4492,
+    4528, 2847, 4454, 4499, 4535, 4563, 2935, 1945, 1955, 1964, 1972, 1979,
+    77,   1655, 3360, 3580, 1721, 3405, 6209, 3625, 3800, 3845, 1787, 3441,
+    6245, 3661, 6365, 6693, 3881, 4020, 4065, 4101, 1853, 3469, 6273, 3689,
+    6393, 6721, 3909, 6477, 6805, 7014, 4129, 4240, 4285, 4321, 4349, 1919,
+    3490, 6294, 3710, 6414, 6742, 3930, 6498, 6826, 7035, 4150, 1604, 1604,
+    1604, 1603, 1604, 4460, 4505, 4541, 4569, 1604, 1985, 2528, 4650, 2649,
+    4659, 4704, 2759, 4667, 4712, 4748, 2858, 4674, 4719, 4755, 4783, 2946,
+    4680, 4725, 4761, 4789, 1604, 3023, 2011, 2021, 2030, 2038, 2045, 2051,
+    89,   173,  2534, 2655, 185,  2535, 4866, 2656, 2765, 2766, 197,  2536,
+    4867, 2657, 4876, 4921, 2767, 2864, 2865, 2866, 209,  2537, 4868, 2658,
+    4877, 4922, 2768, 4885, 4930, 4966, 2867, 2952, 2953, 2954, 2955, 221,
+    2538, 4869, 2659, 4878, 4923, 2769, 4886, 4931, 4967, 2868, 4893, 4938,
+    4974, 5002, 2956, 3029, 3030, 3031, 3032, 3033, 233,  2539, 4870, 2660,
+    4879, 4924, 2770, 4887, 4932, 4968, 2869, 4894, 4939, 4975, 5003, 2957,
+    4900, 4945, 4981, 5009, 1604, 3034, 3095, 3096, 3097, 3098, 3099, 3100,
+    245,  251,  2072, 252,  2073, 2083, 253,  2074, 2084, 2093, 254,  2075,
+    2085, 2094, 2102, 255,  2076, 2086, 2095, 2103, 2110, 256,  2077, 2087,
+    2096, 2104, 2111, 2117, 257,  95,   96,   97,   98,   99,   100,  101,
+    18,   174,  2474, 186,  30,   174,  2545, 2666, 186,  2485, 2776, 2606,
+    198,  198,  42,   174,  2545, 2666, 186,  2546, 5086, 2667, 2776, 2777,
+    198,  2496, 2875, 2617, 2875, 2876, 2727, 210,  210,  210,  54,   174,
+    2545, 2666, 186,  2546, 5086, 2667, 2776, 2777, 198,  2547, 5087, 2668,
+    5096, 5141, 2778, 2875, 2876, 2877, 210,  2507, 2963, 2628, 2963, 2964,
+    2738, 2963, 2964, 2965, 2837, 222,  222,  222,  222,  66,   174,  2545,
+    2666, 186,  2546, 5086, 2667, 2776, 2777, 198,  2547, 5087, 2668, 5096,
+    5141, 2778, 2875, 2876, 2877, 210,  2548, 5088, 2669, 5097, 5142, 2779,
+    5105, 5150, 5186, 2878, 2963, 2964, 2965, 2966, 222,  2518, 3040, 2639,
+    3040, 3041, 2749, 3040, 3041, 3042, 2848, 3040, 3041, 3042, 3043, 2936,
+    234,  234,  234,  234,  234,  78,   174,  2545, 2666, 186,  2546, 5086,
+    2667, 2776, 2777, 198,  2547, 5087, 2668, 5096, 5141, 2778, 2875, 2876,
+    2877, 210,  2548, 5088, 2669, 5097, 5142, 2779, 5105, 5150, 5186, 2878,
+    2963, 2964, 2965, 2966, 222,  2549, 5089, 2670, 5098, 5143, 2780, 5106,
+    5151, 5187, 2879, 5113, 5158, 5194, 5222, 2967, 3040, 3041, 3042, 3043,
+    3044, 234,  2529, 3106, 2650, 3106, 3107, 2760, 3106, 3107, 3108, 2859,
+    3106, 3107, 3108, 3109, 2947, 3106, 3107, 3108, 3109, 3110, 3024, 246,
+    246,  246,  246,  246,  246,  90,   174,  2545, 2666, 186,  2546, 5086,
+    2667, 2776, 2777, 198,  2547, 5087, 2668, 5096, 5141, 2778, 2875, 2876,
+    2877, 210,  2548, 5088, 2669, 5097, 5142, 2779, 5105, 5150, 5186, 2878,
+    2963, 2964, 2965, 2966, 222,  2549, 5089, 2670, 5098, 5143, 2780, 5106,
+    5151, 5187, 2879, 5113, 5158, 5194, 5222, 2967, 3040, 3041, 3042, 3043,
+    3044, 234,  2550, 5090, 2671, 5099, 5144, 2781, 5107, 5152, 5188, 2880,
+    5114, 5159, 5195, 5223, 2968, 5120, 5165, 5201, 5229, 1604, 3045, 3106,
+    3107, 3108, 3109, 3110, 3111, 246,  2540, 3161, 2661, 3161, 3162, 2771,
+    3161, 3162, 3163, 2870, 3161, 3162, 3163, 3164, 2958, 3161, 3162, 3163,
+    3164, 3165, 3035, 3161, 3162, 3163, 3164, 3165, 3166, 3101, 258,  258,
+    258,  258,  258,  258,  258,  102,  174,  263,  264,  186,  263,  2138,
+    264,  265,  265,  198,  263,  2138, 264,  2139, 2149, 265,  266,  266,
+    266,  210,  263,  2138, 264,  2139, 2149, 265,  2140, 2150, 2159, 266,
+    267,  267,  267,  267,  222,  263,  2138, 264,  2139, 2149, 265,  2140,
+    2150, 2159, 266,  2141, 2151, 2160, 2168, 267,  268,  268,  268,  268,
+    268,  234,  263,  2138, 264,  2139, 2149, 265,  2140, 2150, 2159, 266,
+    2141, 2151, 2160, 2168, 267,  2142, 2152, 2161, 2169, 2176, 268,  269,
+    269,  269,  269,  269,  269,  246,  263,  2138, 264,  2139, 2149, 265,
+    2140, 2150, 2159, 266,  2141, 2151, 2160, 2168, 267,  2142, 2152, 2161,
+    2169, 2176, 268,  2143, 2153, 2162, 2170, 2177, 2183, 269,  270,  270,
+    270,  270,  270,  270,  270,  258,  107,  107,  108,  107,  108,  109,
+    107,  108,  109,  110,  107,  108,  109,  110,  111,  107,  108,  109,
+    110,  111,  112,  107,  108,  109,  110,  111,  112,  113,  107,  108,
+    109,  110,  111,  112,  113,  114,  11,   167,  179,  23,   12,   1610,
+    2468, 1676, 24,   168,  2479, 2600, 180,  191,  1742, 192,  35,   36,
+    13,   1611, 2469, 1677, 25,   1621, 3326, 3546, 1687, 2480, 3766, 2601,
+    1743, 1753, 37,   169,  2490, 2611, 181,  2491, 3986, 2612, 2721, 2722,
+    193,  203,  1808, 204,  1809, 1819, 205,  47,   48,   49,   14,   1612,
+    2470, 1678, 26,   1622, 3327, 3547, 1688, 2481, 3767, 2602, 1744, 1754,
+    38,   1631, 3336, 3556, 1697, 3381, 1600, 3601, 3776, 3821, 1763, 2492,
+    3987, 2613, 3996, 4041, 2723, 1810, 1820, 1829, 50,   170,  2501, 2622,
+    182,  2502, 4206, 2623, 2732, 2733, 194,  2503, 4207, 2624, 4216, 4261,
+    2734, 2831, 2832, 2833, 206,  215,  1874, 216,  1875, 1885, 217,  1876,
+    1886, 1895, 218,  59,   60,   61,   62,   15,   1613, 2471, 1679, 27,
+    1623, 3328, 3548, 1689, 2482, 3768, 2603, 1745, 1755, 39,   1632, 3337,
+    3557, 1698, 3382, 6186, 3602, 3777, 3822, 1764, 2493, 3988, 2614, 3997,
+    4042, 2724, 1811, 1821, 1830, 51,   1640, 3345, 3565, 1706, 3390, 6194,
+    3610, 3785, 3830, 1772, 3426, 6230, 3646, 6350, 1601, 3866, 4005, 4050,
+    4086, 1838, 2504, 4208, 2625, 4217, 4262, 2735, 4225, 4270, 4306, 2834,
+    1877, 1887, 1896, 1904, 63,   171,  2512, 2633, 183,  2513, 4426, 2634,
+    2743, 2744, 195,  2514, 4427, 2635, 4436, 4481, 2745, 2842, 2843, 2844,
+    207,  2515, 4428, 2636, 4437, 4482, 2746, 4445, 4490, 4526, 2845, 2930,
+    2931, 2932, 2933, 219,  227,  1940, 228,  1941, 1951, 229,  1942, 1952,
+    1961, 230,  1943, 1953, 1962, 1970, 231,  71,   72,   73,   74,   75,
+    16,   1614, 2472, 1680, 28,   1624, 3329, 3549, 1690, 2483, 3769, 2604,
+    1746, 1756, 40,   1633, 3338, 3558, 1699, 3383, 6187, 3603, 3778, 3823,
+    1765, 2494, 3989, 2615, 3998, 4043, 2725, 1812, 1822, 1831, 52,   1641,
+    3346, 3566, 1707, 3391, 6195, 3611, 3786, 3831, 1773, 3427, 6231, 3647,
+    6351, 6679, 3867, 4006, 4051, 4087, 1839, 2505, 4209, 2626, 4218, 4263,
+    2736, 4226, 4271, 4307, 2835, 1878, 1888, 1897, 1905, 64,   1648, 3353,
+    3573, 1714, 3398, 6202, 3618, 3793, 3838, 1780, 3434, 6238, 3654, 6358,
+    6686, 3874, 4013, 4058, 4094, 1846, 3462, 6266, 3682, 6386, 6714, 3902,
+    6470, 6798, 1602, 4122, 4233, 4278, 4314, 4342, 1912, 2516, 4429, 2637,
+    4438, 4483, 2747, 4446, 4491, 4527, 2846, 4453, 4498, 4534, 4562, 2934,
+    1944, 1954, 1963, 1971, 1978, 76,   172,  2523, 2644, 184,  2524, 4646,
+    2645, 2754, 2755, 196,  2525, 4647, 2646, 4656, 4701, 2756, 2853, 2854,
+    2855, 208,  2526, 4648, 2647, 4657, 4702, 2757, 4665, 4710, 4746, 2856,
+    2941, 2942, 2943, 2944, 220,  2527, 4649, 2648, 4658, 4703, 2758, 4666,
+    4711, 4747, 2857, 4673, 4718, 4754, 4782, 2945, 3018, 3019, 3020, 3021,
+    3022, 232,  239,  2006, 240,  2007, 2017, 241,  2008, 2018, 2027, 242,
+    2009, 2019, 2028, 2036, 243,  2010, 2020, 2029, 2037, 2044, 244,  83,
+    84,   85,   86,   87,   88,   17,   1615, 2473, 1681, 29,   1625, 3330,
+    3550, 1691, 2484, 3770, 2605, 1747, 1757, 41,   1634, 3339, 3559, 1700,
+    3384, 6188, 3604, 3779, 3824, 1766, 2495, 3990, 2616, 3999, 4044, 2726,
+    1813, 1823, 1832, 53,   1642, 3347, 3567, 1708, 3392, 6196, 3612, 3787,
+    3832, 1774, 3428, 6232, 3648, 6352, 6680, 3868, 4007, 4052, 4088, 1840,
+    2506, 4210, 2627, 4219, 4264, 2737, 4227, 4272, 4308, 2836, 1879, 1889,
+    1898, 1906, 65,   1649, 3354, 3574, 1715, 3399, 6203, 3619, 3794, 3839,
+    1781, 3435, 6239, 3655, 6359, 6687, 3875, 4014, 4059, 4095, 1847, 3463,
+    6267, 3683, 6387, 6715, 3903, 6471, 6799, 7008, 4123, 4234, 4279, 4315,
+    4343, 1913, 2517, 4430, 2638, 4439, 4484, 2748, 4447, 4492, 4528, 2847,
+    4454, 4499, 4535, 4563, 2935, 1945, 1955, 1964, 1972, 1979, 77,   1655,
+    3360, 3580, 1721, 3405, 6209, 3625, 3800, 3845, 1787, 3441, 6245, 3661,
+    6365, 6693, 3881, 4020, 4065, 4101, 1853, 3469, 6273, 3689, 6393, 6721,
+    3909, 6477, 6805, 7014, 4129, 4240, 4285, 4321, 4349, 1919, 3490, 6294,
+    3710, 6414, 6742, 3930, 6498, 6826, 7035, 4150, 6554, 6882, 7091, 1603,
+    4370, 4460, 4505, 4541, 4569, 4590, 1985, 2528, 4650, 2649, 4659, 4704,
+    2759, 4667, 4712, 4748, 2858, 4674, 4719, 4755, 4783, 2946, 4680, 4725,
+    4761, 4789, 4810, 3023, 2011, 2021, 2030, 2038, 2045, 2051, 89,   173,
+    2534, 2655, 185,  2535, 4866, 2656, 2765, 2766, 197,  2536, 4867, 2657,
+    4876, 4921, 2767, 2864, 2865, 2866, 209,  2537, 4868, 2658, 4877, 4922,
+    2768, 4885, 4930, 4966, 2867, 2952, 2953, 2954, 2955, 221,  2538, 4869,
+    2659, 4878, 4923, 2769, 4886, 4931, 4967, 2868, 4893, 4938, 4974, 5002,
+    2956, 3029, 3030, 3031, 3032, 3033, 233,  2539, 4870, 2660, 4879, 4924,
+    2770, 4887, 4932, 4968, 2869, 4894, 4939, 4975, 5003, 2957, 4900, 4945,
+    4981, 5009, 5030, 3034, 3095, 3096, 3097, 3098, 3099, 3100, 245,  251,
+    2072, 252,  2073, 2083, 253,  2074, 2084, 2093, 254,  2075, 2085, 2094,
+    2102, 255,  2076, 2086, 2095, 2103, 2110, 256,  2077, 2087, 2096, 2104,
+    2111, 2117, 257,  95,   96,   97,   98,   99,   100,  101,  18,   1616,
+    2474, 1682, 30,   1626, 3331, 3551, 1692, 2485, 3771, 2606, 1748, 1758,
+    42,   1635, 3340, 3560, 1701, 3385, 6189, 3605, 3780, 3825, 1767, 2496,
+    3991, 2617, 4000, 4045, 2727, 1814, 1824, 1833, 54,   1643, 3348, 3568,
+    1709, 3393, 6197, 3613, 3788, 3833, 1775, 3429, 6233, 3649, 6353, 6681,
+    3869, 4008, 4053, 4089, 1841, 2507, 4211, 2628, 4220, 4265, 2738, 4228,
+    4273, 4309, 2837, 1880, 1890, 1899, 1907, 66,   1650, 3355, 3575, 1716,
+    3400, 6204, 3620, 3795, 3840, 1782, 3436, 6240, 3656, 6360, 6688, 3876,
+    4015, 4060, 4096, 1848, 3464, 6268, 3684, 6388, 6716, 3904, 6472, 6800,
+    7009, 4124, 4235, 4280, 4316, 4344, 1914, 2518, 4431, 2639, 4440, 4485,
+    2749, 4448, 4493, 4529, 2848, 4455, 4500, 4536, 4564, 2936, 1946, 1956,
+    1965, 1973, 1980, 78,   1656, 3361, 3581, 1722, 3406, 6210, 3626, 3801,
+    3846, 1788, 3442, 6246, 3662, 6366, 6694, 3882, 4021, 4066, 4102, 1854,
+    3470, 6274, 3690, 6394, 6722, 3910, 6478, 6806, 7015, 4130, 4241, 4286,
+    4322, 4350, 1920, 3491, 6295, 3711, 6415, 6743, 3931, 6499, 6827, 7036,
+    4151, 6555, 6883, 7092, 7217, 4371, 4461, 4506, 4542, 4570, 4591, 1986,
+    2529, 4651, 2650, 4660, 4705, 2760, 4668, 4713, 4749, 2859, 4675, 4720,
+    4756, 4784, 2947, 4681, 4726, 4762, 4790, 4811, 3024, 2012, 2022, 2031,
+    2039, 2046, 2052, 90,   1661, 3366, 3586, 1727, 3411, 6215, 3631, 3806,
+    3851, 1793, 3447, 6251, 3667, 6371, 6699, 3887, 4026, 4071, 4107, 1859,
+    3475, 6279, 3695, 6399, 6727, 3915, 6483, 6811, 7020, 4135, 4246, 4291,
+    4327, 4355, 1925, 3496, 6300, 3716, 6420, 6748, 3936, 6504, 6832, 7041,
+    4156, 6560, 6888, 7097, 7222, 4376, 4466, 4511, 4547, 4575, 4596, 1991,
+    3511, 6315, 3731, 6435, 6763, 3951, 6519, 6847, 7056, 4171, 6575, 6903,
+    7112, 7237, 4391, 1605, 1605, 1605, 1605, 1604, 1605, 4686, 4731, 4767,
+    4795, 4816, 1605, 2057, 2540, 4871, 2661, 4880, 4925, 2771, 4888, 4933,
+    4969, 2870, 4895, 4940, 4976, 5004, 2958, 4901, 4946, 4982, 5010, 5031,
+    3035, 4906, 4951, 4987, 5015, 5036, 1605, 3101, 2078, 2088, 2097, 2105,
+    2112, 2118, 2123, 102,  174,  2545, 2666, 186,  2546, 5086, 2667, 2776,
+    2777, 198,  2547, 5087, 2668, 5096, 5141, 2778, 2875, 2876, 2877, 210,
+    2548, 5088, 2669, 5097, 5142, 2779, 5105, 5150, 5186, 2878, 2963, 2964,
+    2965, 2966, 222,  2549, 5089, 2670, 5098, 5143, 2780, 5106, 5151, 5187,
+    2879, 5113, 5158, 5194, 5222, 2967, 3040, 3041, 3042, 3043, 3044, 234,
+    2550, 5090, 2671, 5099, 5144, 2781, 5107, 5152, 5188, 2880, 5114, 5159,
+    5195, 5223, 2968, 5120, 5165, 5201, 5229, 5250, 3045, 3106, 3107, 3108,
+    3109, 3110, 3111, 246,  2551, 5091, 2672, 5100, 5145, 2782, 5108, 5153,
+    5189, 2881, 5115, 5160, 5196, 5224, 2969, 5121, 5166, 5202, 5230, 5251,
+    3046, 5126, 5171, 5207, 5235, 5256, 1605, 3112, 3161, 3162, 3163, 3164,
+    3165, 3166, 3167, 258,  263,  2138, 264,  2139, 2149, 265,  2140, 2150,
+    2159, 266,  2141, 2151, 2160, 2168, 267,  2142, 2152, 2161, 2169, 2176,
+    268,  2143, 2153, 2162, 2170, 2177, 2183, 269,  2144, 2154, 2163, 2171,
+    2178, 2184, 2189, 270,  107,  108,  109,  110,  111,  112,  113,  114,
+    19,   175,  2475, 187,  31,   175,  2556, 2677, 187,  2486, 2787, 2607,
+    199,  199,  43,   175,  2556, 2677, 187,  2557, 5306, 2678, 2787, 2788,
+    199,  2497, 2886, 2618, 2886, 2887, 2728, 211,  211,  211,  55,   175,
+    2556, 2677, 187,  2557, 5306, 2678, 2787, 2788, 199,  2558, 5307, 2679,
+    5316, 5361, 2789, 2886, 2887, 2888, 211,  2508, 2974, 2629, 2974, 2975,
+    2739, 2974, 2975, 2976, 2838, 223,  223,  223,  223,  67,   175,  2556,
+    2677, 187,  2557, 5306, 2678, 2787, 2788, 199,  2558, 5307, 2679, 5316,
+    5361, 2789, 2886, 2887, 2888, 211,  2559, 5308, 2680, 5317, 5362, 2790,
+    5325, 5370, 5406, 2889, 2974, 2975, 2976, 2977, 223,  2519, 3051, 2640,
+    3051, 3052, 2750, 3051, 3052, 3053, 2849, 3051, 3052, 3053, 3054, 2937,
+    235,  235,  235,  235,  235,  79,   175,  2556, 2677, 187,  2557, 5306,
+    2678, 2787, 2788, 199,  2558, 5307, 2679, 5316, 5361, 2789, 2886, 2887,
+    2888, 211,  2559, 5308, 2680, 5317, 5362, 2790, 5325, 5370, 5406, 2889,
+    2974, 2975, 2976, 2977, 223,  2560, 5309, 2681, 5318, 5363, 2791, 5326,
+    5371, 5407, 2890, 5333, 5378, 5414, 5442, 2978, 3051, 3052, 3053, 3054,
+    3055, 235,  2530, 3117, 2651, 3117, 3118, 2761, 3117, 3118, 3119, 2860,
+    3117, 3118, 3119, 3120, 2948, 3117, 3118, 3119, 3120, 3121, 3025, 247,
+    247,  247,  247,  247,  247,  91,   175,  2556, 2677, 187,  2557, 5306,
+    2678, 2787, 2788, 199,  2558, 5307, 2679, 5316, 5361, 2789, 2886, 2887,
+    2888, 211,  2559, 5308, 2680, 5317, 5362, 2790, 5325, 5370, 5406, 2889,
+    2974, 2975, 2976, 2977, 223,  2560, 5309, 2681, 5318, 5363, 2791, 5326,
+    5371, 5407, 2890, 5333, 5378, 5414, 5442, 2978, 3051, 3052, 3053, 3054,
+    3055, 235,  2561, 5310, 2682, 5319, 5364, 2792, 5327, 5372, 5408, 2891,
+    5334, 5379, 5415, 5443, 2979, 5340, 5385, 5421, 5449, 5470, 3056, 3117,
+    3118, 3119, 3120, 3121, 3122, 247,  2541, 3172, 2662, 3172, 3173, 2772,
+    3172, 3173, 3174, 2871, 3172, 3173, 3174, 3175, 2959, 3172, 3173, 3174,
+    3175, 3176, 3036, 3172, 3173, 3174, 3175, 3176, 3177, 3102, 259,  259,
+    259,  259,  259,  259,  259,  103,  175,  2556, 2677, 187,  2557, 5306,
+    2678, 2787, 2788, 199,  2558, 5307, 2679, 5316, 5361, 2789, 2886, 2887,
+    2888, 211,  2559, 5308, 2680, 5317, 5362, 2790, 5325, 5370, 5406, 2889,
+    2974, 2975, 2976, 2977, 223,  2560, 5309, 2681, 5318, 5363, 2791, 5326,
+    5371, 5407, 2890, 5333, 5378, 5414, 5442, 2978, 3051, 3052, 3053, 3054,
+    3055, 235,  2561, 5310, 2682, 5319, 5364, 2792, 5327, 5372, 5408, 2891,
+    5334, 5379, 5415, 5443, 2979, 5340, 5385, 5421, 5449, 5470, 3056, 3117,
+    3118, 3119, 3120, 3121, 3122, 247,  2562, 5311, 2683, 5320, 5365, 2793,
+    5328, 5373, 5409, 2892, 5335, 5380, 5416, 5444, 2980, 5341, 5386, 5422,
+    5450, 5471, 3057, 5346, 5391, 5427, 5455, 5476, 1605, 3123, 3172, 3173,
+    3174, 3175, 3176, 3177, 3178, 259,  2552, 3216, 2673, 3216, 3217, 2783,
+    3216, 3217, 3218, 2882, 3216, 3217, 3218, 3219, 2970, 3216, 3217, 3218,
+    3219, 3220, 3047, 3216, 3217, 3218, 3219, 3220, 3221, 3113, 3216, 3217,
+    3218, 3219, 3220, 3221, 3222, 3168, 271,  271,  271,  271,  271,  271,
+    271,  271,  115,  175,  275,  276,  187,  275,  2204, 276,  277,  277,
+    199,  275,  2204, 276,  2205, 2215, 277,  278,  278,  278,  211,  275,
+    2204, 276,  2205, 2215, 277,  2206, 2216, 2225, 278,  279,  279,  279,
+    279,  223,  275,  2204, 276,  2205, 2215, 277,  2206, 2216, 2225, 278,
+    2207, 2217, 2226, 2234, 279,  280,  280,  280,  280,  280,  235,  275,
+    2204, 276,  2205, 2215, 277,  2206, 2216, 2225, 278,  2207, 2217, 2226,
+    2234, 279,  2208, 2218, 2227, 2235, 2242, 280,  281,  281,  281,  281,
+    281,  281,  247,  275,  2204, 276,  2205, 2215, 277,  2206, 2216, 2225,
+    278,  2207, 2217, 2226, 2234, 279,  2208, 2218, 2227, 2235, 2242, 280,
+    2209, 2219, 2228, 2236, 2243, 2249, 281,  282,  282,  282,  282,  282,
+    282,  282,  259,  275,  2204, 276,  2205, 2215, 277,  2206, 2216, 2225,
+    278,  2207, 2217, 2226, 2234, 279,  2208, 2218, 2227, 2235, 2242, 280,
+    2209, 2219, 2228, 2236, 2243, 2249, 281,  2210, 2220, 2229, 2237, 2244,
+    2250, 2255, 282,  283,  283,  283,  283,  283,  283,  283,  283,  271,
+    119,  119,  120,  119,  120,  121,  119,  120,  121,  122,  119,  120,
+    121,  122,  123,  119,  120,  121,  122,  123,  124,  119,  120,  121,
+    122,  123,  124,  125,  119,  120,  121,  122,  123,  124,  125,  126,
+    119,  120,  121,  122,  123,  124,  125,  126,  127,  11,   167,  179,
+    23,   12,   1610, 2468, 1676, 24,   168,  2479, 2600, 180,  191,  1742,
+    192,  35,   36,   13,   1611, 2469, 1677, 25,   1621, 3326, 3546, 1687,
+    2480, 3766, 2601, 1743, 1753, 37,   169,  2490, 2611, 181,  2491, 3986,
+    2612, 2721, 2722, 193,  203,  1808, 204,  1809, 1819, 205,  47,   48,
+    49,   14,   1612, 2470, 1678, 26,   1622, 3327, 3547, 1688, 2481, 3767,
+    2602, 1744, 1754, 38,   1631, 3336, 3556, 1697, 3381, 1600, 3601, 3776,
+    3821, 1763, 2492, 3987, 2613, 3996, 4041, 2723, 1810, 1820, 1829, 50,
+    170,  2501, 2622, 182,  2502, 4206, 2623, 2732, 2733, 194,  2503, 4207,
+    2624, 4216, 4261, 2734, 2831, 2832, 2833, 206,  215,  1874, 216,  1875,
+    1885, 217,  1876, 1886, 1895, 218,  59,   60,   61,   62,   15,   1613,
+    2471, 1679, 27,   1623, 3328, 3548, 1689, 2482, 3768, 2603, 1745, 1755,
+    39,   1632, 3337, 3557, 1698, 3382, 6186, 3602, 3777, 3822, 1764, 2493,
+    3988, 2614, 3997, 4042, 2724, 1811, 1821, 1830, 51,   1640, 3345, 3565,
+    1706, 3390, 6194, 3610, 3785, 3830, 1772, 3426, 6230, 3646, 6350, 1601,
+    3866, 4005, 4050, 4086, 1838, 2504, 4208, 2625, 4217, 4262, 2735, 4225,
+    4270, 4306, 2834, 1877, 1887, 1896, 1904, 63,   171,  2512, 2633, 183,
+    2513, 4426, 2634, 2743, 2744, 195,  2514, 4427, 2635, 4436, 4481, 2745,
+    2842, 2843, 2844, 207,  2515, 4428, 2636, 4437, 4482, 2746, 4445, 4490,
+    4526, 2845, 2930, 2931, 2932, 2933, 219,  227,  1940, 228,  1941, 1951,
+    229,  1942, 1952, 1961, 230,  1943, 1953, 1962, 1970, 231,  71,   72,
+    73,   74,   75,   16,   1614, 2472, 1680, 28,   1624, 3329, 3549, 1690,
+    2483, 3769, 2604, 1746, 1756, 40,   1633, 3338, 3558, 1699, 3383, 6187,
+    3603, 3778, 3823, 1765, 2494, 3989, 2615, 3998, 4043, 2725, 1812, 1822,
+    1831, 52,   1641, 3346, 3566, 1707, 3391, 6195, 3611, 3786, 3831, 1773,
+    3427, 6231, 3647, 6351, 6679, 3867, 4006, 4051, 4087, 1839, 2505, 4209,
+    2626, 4218, 4263, 2736, 4226, 4271, 4307, 2835, 1878, 1888, 1897, 1905,
+    64,   1648, 3353, 3573, 1714, 3398, 6202, 3618, 3793, 3838, 1780, 3434,
+    6238, 3654, 6358, 6686, 3874, 4013, 4058, 4094, 1846, 3462, 6266, 3682,
+    6386, 6714, 3902, 6470, 6798, 1602, 4122, 4233, 4278, 4314, 4342, 1912,
+    2516, 4429, 2637, 4438, 4483, 2747, 4446, 4491, 4527, 2846, 4453, 4498,
+    4534, 4562, 2934, 1944, 1954, 1963, 1971, 1978, 76,   172,  2523, 2644,
+    184,  2524, 4646, 2645, 2754, 2755, 196,  2525, 4647, 2646, 4656, 4701,
+    2756, 2853, 2854, 2855, 208,  2526, 4648, 2647, 4657, 4702, 2757, 4665,
+    4710, 4746, 2856, 2941, 2942, 2943, 2944, 220,  2527, 4649, 2648, 4658,
+    4703, 2758, 4666, 4711, 4747, 2857, 4673, 4718, 4754, 4782, 2945, 3018,
+    3019, 3020, 3021, 3022, 232,  239,  2006, 240,  2007, 2017, 241,  2008,
+    2018, 2027, 242,  2009, 2019, 2028, 2036, 243,  2010, 2020, 2029, 2037,
+    2044, 244,  83,   84,   85,   86,   87,   88,   17,   1615, 2473, 1681,
+    29,   1625, 3330, 3550, 1691, 2484, 3770, 2605, 1747, 1757, 41,   1634,
+    3339, 3559, 1700, 3384, 6188, 3604, 3779, 3824, 1766, 2495, 3990, 2616,
+    3999, 4044, 2726, 1813, 1823, 1832, 53,   1642, 3347, 3567, 1708, 3392,
+    6196, 3612, 3787, 3832, 1774, 3428, 6232, 3648, 6352, 6680, 3868, 4007,
+    4052, 4088, 1840, 2506, 4210, 2627, 4219, 4264, 2737, 4227, 4272, 4308,
+    2836, 1879, 1889, 1898, 1906, 65,   1649, 3354, 3574, 1715, 3399, 6203,
+    3619, 3794, 3839, 1781, 3435, 6239, 3655, 6359, 6687, 3875, 4014, 4059,
+    4095, 1847, 3463, 6267, 3683, 6387, 6715, 3903, 6471, 6799, 7008, 4123,
+    4234, 4279, 4315, 4343, 1913, 2517, 4430, 2638, 4439, 4484, 2748, 4447,
+    4492, 4528, 2847, 4454, 4499, 4535, 4563, 2935, 1945, 1955, 1964, 1972,
+    1979, 77,   1655, 3360, 3580, 1721, 3405, 6209, 3625, 3800, 3845, 1787,
+    3441, 6245, 3661, 6365, 6693, 3881, 4020, 4065, 4101, 1853, 3469, 6273,
+    3689, 6393, 6721, 3909, 6477, 6805, 7014, 4129, 4240, 4285, 4321, 4349,
+    1919, 3490, 6294, 3710, 6414, 6742, 3930, 6498, 6826, 7035, 4150, 6554,
+    6882, 7091, 1603, 4370, 4460, 4505, 4541, 4569, 4590, 1985, 2528, 4650,
+    2649, 4659, 4704, 2759, 4667, 4712, 4748, 2858, 4674, 4719, 4755, 4783,
+    2946, 4680, 4725, 4761, 4789, 4810, 3023, 2011, 2021, 2030, 2038, 2045,
+    2051, 89,   173,  2534, 2655, 185,  2535, 4866, 2656, 2765, 2766, 197,
+    2536, 4867, 2657, 4876, 4921, 2767, 2864, 2865, 2866, 209,  2537, 4868,
+    2658, 4877, 4922, 2768, 4885, 4930, 4966, 2867, 2952, 2953, 2954, 2955,
+    221,  2538, 4869, 2659, 4878, 4923, 2769, 4886, 4931, 4967, 2868, 4893,
+    4938, 4974, 5002, 2956, 3029, 3030, 3031, 3032, 3033, 233,  2539, 4870,
+    2660, 4879, 4924, 2770, 4887, 4932, 4968, 2869, 4894, 4939, 4975, 5003,
+    2957, 4900, 4945, 4981, 5009, 5030, 3034, 3095, 3096, 3097, 3098, 3099,
+    3100, 245,  251,  2072, 252,  2073, 2083, 253,  2074, 2084, 2093, 254,
+    2075, 2085, 2094, 2102, 255,  2076, 2086, 2095, 2103, 2110, 256,  2077,
+    2087, 2096, 2104, 2111, 2117, 257,  95,   96,   97,   98,   99,   100,
+    101,  18,   1616, 2474, 1682, 30,   1626, 3331, 3551, 1692, 2485, 3771,
+    2606, 1748, 1758, 42,   1635, 3340, 3560, 1701, 3385, 6189, 3605, 3780,
+    3825, 1767, 2496, 3991, 2617, 4000, 4045, 2727, 1814, 1824, 1833, 54,
+    1643, 3348, 3568, 1709, 3393, 6197, 3613, 3788, 3833, 1775, 3429, 6233,
+    3649, 6353, 6681, 3869, 4008, 4053, 4089, 1841, 2507, 4211, 2628, 4220,
+    4265, 2738, 4228, 4273, 4309, 2837, 1880, 1890, 1899, 1907, 66,   1650,
+    3355, 3575, 1716, 3400, 6204, 3620, 3795, 3840, 1782, 3436, 6240, 3656,
+    6360, 6688, 3876, 4015, 4060, 4096, 1848, 3464, 6268, 3684, 6388, 6716,
+    3904, 6472, 6800, 7009, 4124, 4235, 4280, 4316, 4344, 1914, 2518, 4431,
+    2639, 4440, 4485, 2749, 4448, 4493, 4529, 2848, 4455, 4500, 4536, 4564,
+    2936, 1946, 1956, 1965, 1973, 1980, 78,   1656, 3361, 3581, 1722, 3406,
+    6210, 3626, 3801, 3846, 1788, 3442, 6246, 3662, 6366, 6694, 3882, 4021,
+    4066, 4102, 1854, 3470, 6274, 3690, 6394, 6722, 3910, 6478, 6806, 7015,
+    4130, 4241, 4286, 4322, 4350, 1920, 3491, 6295, 3711, 6415, 6743, 3931,
+    6499, 6827, 7036, 4151, 6555, 6883, 7092, 7217, 4371, 4461, 4506, 4542,
+    4570, 4591, 1986, 2529, 4651, 2650, 4660, 4705, 2760, 4668, 4713, 4749,
+    2859, 4675, 4720, 4756, 4784, 2947, 4681, 4726, 4762, 4790, 4811, 3024,
+    2012, 2022, 2031, 2039, 2046, 2052, 90,   1661, 3366, 3586, 1727, 3411,
+    6215, 3631, 3806, 3851, 1793, 3447, 6251, 3667, 6371, 6699, 3887, 4026,
+    4071, 4107, 1859, 3475, 6279, 3695, 6399, 6727, 3915, 6483, 6811, 7020,
+    4135, 4246, 4291, 4327, 4355, 1925, 3496, 6300, 3716, 6420, 6748, 3936,
+    6504, 6832, 7041, 4156, 6560, 6888, 7097, 7222, 4376, 4466, 4511, 4547,
+    4575, 4596, 1991, 3511, 6315, 3731, 6435, 6763, 3951, 6519, 6847, 7056,
+    4171, 6575, 6903, 7112, 7237, 4391, 6610, 6938, 7147, 7272, 1604, 4611,
+    4686, 4731, 4767, 4795, 4816, 4831, 2057, 2540, 4871, 2661, 4880, 4925,
+    2771, 4888, 4933, 4969, 2870, 4895, 4940, 4976, 5004, 2958, 4901, 4946,
+    4982, 5010, 5031, 3035, 4906, 4951, 4987, 5015, 5036, 5051, 3101, 2078,
+    2088, 2097, 2105, 2112, 2118, 2123, 102,  174,  2545, 2666, 186,  2546,
+    5086, 2667, 2776, 2777, 198,  2547, 5087, 2668, 5096, 5141, 2778, 2875,
+    2876, 2877, 210,  2548, 5088, 2669, 5097, 5142, 2779, 5105, 5150, 5186,
+    2878, 2963, 2964, 2965, 2966, 222,  2549, 5089, 2670, 5098, 5143, 2780,
+    5106, 5151, 5187, 2879, 5113, 5158, 5194, 5222, 2967, 3040, 3041, 3042,
+    3043, 3044, 234,  2550, 5090, 2671, 5099, 5144, 2781, 5107, 5152, 5188,
+    2880, 5114, 5159, 5195, 5223, 2968, 5120, 5165, 5201, 5229, 5250, 3045,
+    3106, 3107, 3108, 3109, 3110, 3111, 246,  2551, 5091, 2672, 5100, 5145,
+    2782, 5108, 5153, 5189, 2881, 5115, 5160, 5196, 5224, 2969, 5121, 5166,
+    5202, 5230, 5251, 3046, 5126, 5171, 5207, 5235, 5256, 5271, 3112, 3161,
+    3162, 3163, 3164, 3165, 3166, 3167, 258,  263,  2138, 264,  2139, 2149,
+    265,  2140, 2150, 2159, 266,  2141, 2151, 2160, 2168, 267,  2142, 2152,
+    2161, 2169, 2176, 268,  2143, 2153, 2162, 2170, 2177, 2183, 269,  2144,
+    2154, 2163, 2171, 2178, 2184, 2189, 270,  107,  108,  109,  110,  111,
+    112,  113,  114,  19,   1617, 2475, 1683, 31,   1627, 3332, 3552, 1693,
+    2486, 3772, 2607, 1749, 1759, 43,   1636, 3341, 3561, 1702, 3386, 6190,
+    3606, 3781, 3826, 1768, 2497, 3992, 2618, 4001, 4046, 2728, 1815, 1825,
+    1834, 55,   1644, 3349, 3569, 1710, 3394, 6198, 3614, 3789, 3834, 1776,
+    3430, 6234, 3650, 6354, 6682, 3870, 4009, 4054, 4090, 1842, 2508, 4212,
+    2629, 4221, 4266, 2739, 4229, 4274, 4310, 2838, 1881, 1891, 1900, 1908,
+    67,   1651, 3356, 3576, 1717, 3401, 6205, 3621, 3796, 3841, 1783, 3437,
+    6241, 3657, 6361, 6689, 3877, 4016, 4061, 4097, 1849, 3465, 6269, 3685,
+    6389, 6717, 3905, 6473, 6801, 7010, 4125, 4236, 4281, 4317, 4345, 1915,
+    2519, 4432, 2640, 4441, 4486, 2750, 4449, 4494, 4530, 2849, 4456, 4501,
+    4537, 4565, 2937, 1947, 1957, 1966, 1974, 1981, 79,   1657, 3362, 3582,
+    1723, 3407, 6211, 3627, 3802, 3847, 1789, 3443, 6247, 3663, 6367, 6695,
+    3883, 4022, 4067, 4103, 1855, 3471, 6275, 3691, 6395, 6723, 3911, 6479,
+    6807, 7016, 4131, 4242, 4287, 4323, 4351, 1921, 3492, 6296, 3712, 6416,
+    6744, 3932, 6500, 6828, 7037, 4152, 6556, 6884, 7093, 7218, 4372, 4462,
+    4507, 4543, 4571, 4592, 1987, 2530, 4652, 2651, 4661, 4706, 2761, 4669,
+    4714, 4750, 2860, 4676, 4721, 4757, 4785, 2948, 4682, 4727, 4763, 4791,
+    4812, 3025, 2013, 2023, 2032, 2040, 2047, 2053, 91,   1662, 3367, 3587,
+    1728, 3412, 6216, 3632, 3807, 3852, 1794, 3448, 6252, 3668, 6372, 6700,
+    3888, 4027, 4072, 4108, 1860, 3476, 6280, 3696, 6400, 6728, 3916, 6484,
+    6812, 7021, 4136, 4247, 4292, 4328, 4356, 1926, 3497, 6301, 3717, 6421,
+    6749, 3937, 6505, 6833, 7042, 4157, 6561, 6889, 7098, 7223, 4377, 4467,
+    4512, 4548, 4576, 4597, 1992, 3512, 6316, 3732, 6436, 6764, 3952, 6520,
+    6848, 7057, 4172, 6576, 6904, 7113, 7238, 4392, 6611, 6939, 7148, 7273,
+    7342, 4612, 4687, 4732, 4768, 4796, 4817, 4832, 2058, 2541, 4872, 2662,
+    4881, 4926, 2772, 4889, 4934, 4970, 2871, 4896, 4941, 4977, 5005, 2959,
+    4902, 4947, 4983, 5011, 5032, 3036, 4907, 4952, 4988, 5016, 5037, 5052,
+    3102, 2079, 2089, 2098, 2106, 2113, 2119, 2124, 103,  1666, 3371, 3591,
+    1732, 3416, 6220, 3636, 3811, 3856, 1798, 3452, 6256, 3672, 6376, 6704,
+    3892, 4031, 4076, 4112, 1864, 3480, 6284, 3700, 6404, 6732, 3920, 6488,
+    6816, 7025, 4140, 4251, 4296, 4332, 4360, 1930, 3501, 6305, 3721, 6425,
+    6753, 3941, 6509, 6837, 7046, 4161, 6565, 6893, 7102, 7227, 4381, 4471,
+    4516, 4552, 4580, 4601, 1996, 3516, 6320, 3736, 6440, 6768, 3956, 6524,
+    6852, 7061, 4176, 6580, 6908, 7117, 7242, 4396, 6615, 6943, 7152, 7277,
+    7346, 4616, 4691, 4736, 4772, 4800, 4821, 4836, 2062, 3526, 6330, 3746,
+    6450, 6778, 3966, 6534, 6862, 7071, 4186, 6590, 6918, 7127, 7252, 4406,
+    6625, 6953, 7162, 7287, 7356, 4626, 1606, 1606, 1606, 1606, 1606, 1605,
+    1606, 4911, 4956, 4992, 5020, 5041, 5056, 1606, 2128, 2552, 5092, 2673,
+    5101, 5146, 2783, 5109, 5154, 5190, 2882, 5116, 5161, 5197, 5225, 2970,
+    5122, 5167, 5203, 5231, 5252, 3047, 5127, 5172, 5208, 5236, 5257, 5272,
+    3113, 5131, 5176, 5212, 5240, 5261, 5276, 1606, 3168, 2145, 2155, 2164,
+    2172, 2179, 2185, 2190, 2194, 115,  175,  2556, 2677, 187,  2557, 5306,
+    2678, 2787, 2788, 199,  2558, 5307, 2679, 5316, 5361, 2789, 2886, 2887,
+    2888, 211,  2559, 5308, 2680, 5317, 5362, 2790, 5325, 5370, 5406, 2889,
+    2974, 2975, 2976, 2977, 223,  2560, 5309, 2681, 5318, 5363, 2791, 5326,
+    5371, 5407, 2890, 5333, 5378, 5414, 5442, 2978, 3051, 3052, 3053, 3054,
+    3055, 235,  2561, 5310, 2682, 5319, 5364, 2792, 5327, 5372, 5408, 2891,
+    5334, 5379, 5415, 5443, 2979, 5340, 5385, 5421, 5449, 5470, 3056, 3117,
+    3118, 3119, 3120, 3121, 3122, 247,  2562, 5311, 2683, 5320, 5365, 2793,
+    5328, 5373, 5409, 2892, 5335, 5380, 5416, 5444, 2980, 5341, 5386, 5422,
+    5450, 5471, 3057, 5346, 5391, 5427, 5455, 5476, 5491, 3123, 3172, 3173,
+    3174, 3175, 3176, 3177, 3178, 259,  2563, 5312, 2684, 5321, 5366, 2794,
+    5329, 5374, 5410, 2893, 5336, 5381, 5417, 5445, 2981, 5342, 5387, 5423,
+    5451, 5472, 3058, 5347, 5392, 5428, 5456, 5477, 5492, 3124, 5351, 5396,
+    5432, 5460, 5481, 5496, 1606, 3179, 3216, 3217, 3218, 3219, 3220, 3221,
+    3222, 3223, 271,  275,  2204, 276,  2205, 2215, 277,  2206, 2216, 2225,
+    278,  2207, 2217, 2226, 2234, 279,  2208, 2218, 2227, 2235, 2242, 280,
+    2209, 2219, 2228, 2236, 2243, 2249, 281,  2210, 2220, 2229, 2237, 2244,
+    2250, 2255, 282,  2211, 2221, 2230, 2238, 2245, 2251, 2256, 2260, 283,
+    119,  120,  121,  122,  123,  124,  125,  126,  127,  20,   176,  2476,
+    188,  32,   176,  2567, 2688, 188,  2487, 2798, 2608, 200,  200,  44,
+    176,  2567, 2688, 188,  2568, 5526, 2689, 2798, 2799, 200,  2498, 2897,
+    2619, 2897, 2898, 2729, 212,  212,  212,  56,   176,  2567, 2688, 188,
+    2568, 5526, 2689, 2798, 2799, 200,  2569, 5527, 2690, 5536, 5581, 2800,
+    2897, 2898, 2899, 212,  2509, 2985, 2630, 2985, 2986, 2740, 2985, 2986,
+    2987, 2839, 224,  224,  224,  224,  68,   176,  2567, 2688, 188,  2568,
+    5526, 2689, 2798, 2799, 200,  2569, 5527, 2690, 5536, 5581, 2800, 2897,
+    2898, 2899, 212,  2570, 5528, 2691, 5537, 5582, 2801, 5545, 5590, 5626,
+    2900, 2985, 2986, 2987, 2988, 224,  2520, 3062, 2641, 3062, 3063, 2751,
+    3062, 3063, 3064, 2850, 3062, 3063, 3064, 3065, 2938, 236,  236,  236,
+    236,  236,  80,   176,  2567, 2688, 188,  2568, 5526, 2689, 2798, 2799,
+    200,  2569, 5527, 2690, 5536, 5581, 2800, 2897, 2898, 2899, 212,  2570,
+    5528, 2691, 5537, 5582, 2801, 5545, 5590, 5626, 2900, 2985, 2986, 2987,
+    2988, 224,  2571, 5529, 2692, 5538, 5583, 2802, 5546, 5591, 5627, 2901,
+    5553, 5598, 5634, 5662, 2989, 3062, 3063, 3064, 3065, 3066, 236,  2531,
+    3128, 2652, 3128, 3129, 2762, 3128, 3129, 3130, 2861, 3128, 3129, 3130,
+    3131, 2949, 3128, 3129, 3130, 3131, 3132, 3026, 248,  248,  248,  248,
+    248,  248,  92,   176,  2567, 2688, 188,  2568, 5526, 2689, 2798, 2799,
+    200,  2569, 5527, 2690, 5536, 5581, 2800, 2897, 2898, 2899, 212,  2570,
+    5528, 2691, 5537, 5582, 2801, 5545, 5590, 5626, 2900, 2985, 2986, 2987,
+    2988, 224,  2571, 5529, 2692, 5538, 5583, 2802, 5546, 5591, 5627, 2901,
+    5553, 5598, 5634, 5662, 2989, 3062, 3063, 3064, 3065, 3066, 236,  2572,
+    5530, 2693, 5539, 5584, 2803, 5547, 5592, 5628, 2902, 5554, 5599, 5635,
+    5663, 2990, 5560, 5605, 5641, 5669, 5690, 3067, 3128, 3129, 3130, 3131,
+    3132, 3133, 248,  2542, 3183, 2663, 3183, 3184, 2773, 3183, 3184, 3185,
+    2872, 3183, 3184, 3185, 3186, 2960, 3183, 3184, 3185, 3186, 3187, 3037,
+    3183, 3184, 3185, 3186, 3187, 3188, 3103, 260,  260,  260,  260,  260,
+    260,  260,  104,  176,  2567, 2688, 188,  2568, 5526, 2689, 2798, 2799,
+    200,  2569, 5527, 2690, 5536, 5581, 2800, 2897, 2898, 2899, 212,  2570,
+    5528, 2691, 5537, 5582, 2801, 5545, 5590, 5626, 2900, 2985, 2986, 2987,
+    2988, 224,  2571, 5529, 2692, 5538, 5583, 2802, 5546, 5591, 5627, 2901,
+    5553, 5598, 5634, 5662, 2989, 3062, 3063, 3064, 3065, 3066, 236,  2572,
+    5530, 2693, 5539, 5584, 2803, 5547, 5592, 5628, 2902, 5554, 5599, 5635,
+    5663, 2990, 5560, 5605, 5641, 5669, 5690, 3067, 3128, 3129, 3130, 3131,
+    3132, 3133, 248,  2573, 5531, 2694, 5540, 5585, 2804, 5548, 5593, 5629,
+    2903, 5555, 5600, 5636, 5664, 2991, 5561, 5606, 5642, 5670, 5691, 3068,
+    5566, 5611, 5647, 5675, 5696, 5711, 3134, 3183, 3184, 3185, 3186, 3187,
+    3188, 3189, 260,  2553, 3227, 2674, 3227, 3228, 2784, 3227, 3228, 3229,
+    2883, 3227, 3228, 3229, 3230, 2971, 3227, 3228, 3229, 3230, 3231, 3048,
+    3227, 3228, 3229, 3230, 3231, 3232, 3114, 3227, 3228, 3229, 3230, 3231,
+    3232, 3233, 3169, 272,  272,  272,  272,  272,  272,  272,  272,  116,
+    176,  2567, 2688, 188,  2568, 5526, 2689, 2798, 2799, 200,  2569, 5527,
+    2690, 5536, 5581, 2800, 2897, 2898, 2899, 212,  2570, 5528, 2691, 5537,
+    5582, 2801, 5545, 5590, 5626, 2900, 2985, 2986, 2987, 2988, 224,  2571,
+    5529, 2692, 5538, 5583, 2802, 5546, 5591, 5627, 2901, 5553, 5598, 5634,
+    5662, 2989, 3062, 3063, 3064, 3065, 3066, 236,  2572, 5530, 2693, 5539,
+    5584, 2803, 5547, 5592, 5628, 2902, 5554, 5599, 5635, 5663, 2990, 5560,
+    5605, 5641, 5669, 5690, 3067, 3128, 3129, 3130, 3131, 3132, 3133, 248,
+    2573, 5531, 2694, 5540, 5585, 2804, 5548, 5593, 5629, 2903, 5555, 5600,
+    5636, 5664, 2991, 5561, 5606, 5642, 5670, 5691, 3068, 5566, 5611, 5647,
+    5675, 5696, 5711, 3134, 3183, 3184, 3185, 3186, 3187, 3188, 3189, 260,
+    2574, 5532, 2695, 5541, 5586, 2805, 5549, 5594, 5630, 2904, 5556, 5601,
+    5637, 5665, 2992, 5562, 5607, 5643, 5671, 5692, 3069, 5567, 5612, 5648,
+    5676, 5697, 5712, 3135, 5571, 5616, 5652, 5680, 5701, 5716, 1606, 3190,
+    3227, 3228, 3229, 3230, 3231, 3232, 3233, 3234, 272,  2564, 3260, 2685,
+    3260, 3261, 2795, 3260, 3261, 3262, 2894, 3260, 3261, 3262, 3263, 2982,
+    3260, 3261, 3262, 3263, 3264, 3059, 3260, 3261, 3262, 3263, 3264, 3265,
+    3125, 3260, 3261, 3262, 3263, 3264, 3265, 3266, 3180, 3260, 3261, 3262,
+    3263, 3264, 3265, 3266, 3267, 3224, 284,  284,  284,  284,  284,  284,
+    284,  284,  284,  128,  176,  287,  288,  188,  287,  2270, 288,  289,
+    289,  200,  287,  2270, 288,  2271, 2281, 289,  290,  290,  290,  212,
+    287,  2270, 288,  2271, 2281, 289,  2272, 2282, 2291, 290,  291,  291,
+    291,  291,  224,  287,  2270, 288,  2271, 2281, 289,  2272, 2282, 2291,
+    290,  2273, 2283, 2292, 2300, 291,  292,  292,  292,  292,  292,  236,
+    287,  2270, 288,  2271, 2281, 289,  2272, 2282, 2291, 290,  2273, 2283,
+    2292, 2300, 291,  2274, 2284, 2293, 2301, 2308, 292,  293,  293,  293,
+    293,  293,  293,  248,  287,  2270, 288,  2271, 2281, 289,  2272, 2282,
+    2291, 290,  2273, 2283, 2292, 2300, 291,  2274, 2284, 2293, 2301, 2308,
+    292,  2275, 2285, 2294, 2302, 2309, 2315, 293,  294,  294,  294,  294,
+    294,  294,  294,  260,  287,  2270, 288,  2271, 2281, 289,  2272, 2282,
+    2291, 290,  2273, 2283, 2292, 2300, 291,  2274, 2284, 2293, 2301, 2308,
+    292,  2275, 2285, 2294, 2302, 2309, 2315, 293,  2276, 2286, 2295, 2303,
+    2310, 2316, 2321, 294,  295,  295,  295,  295,  295,  295,  295,  295,
+    272,  287,  2270, 288,  2271, 2281, 289,  2272, 2282, 2291, 290,  2273,
+    2283, 2292, 2300, 291,  2274, 2284, 2293, 2301, 2308, 292,  2275, 2285,
+    2294, 2302, 2309, 2315, 293,  2276, 2286, 2295, 2303, 2310, 2316, 2321,
+    294,  2277, 2287, 2296, 2304, 2311, 2317, 2322, 2326, 295,  296,  296,
+    296,  296,  296,  296,  296,  296,  296,  284,  131,  131,  132,  131,
+    132,  133,  131,  132,  133,  134,  131,  132,  133,  134,  135,  131,
+    132,  133,  134,  135,  136,  131,  132,  133,  134,  135,  136,  137,
+    131,  132,  133,  134,  135,  136,  137,  138,  131,  132,  133,  134,
+    135,  136,  137,  138,  139,  131,  132,  133,  134,  135,  136,  137,
+    138,  139,  140,  11,   167,  179,  23,   12,   1610, 2468, 1676, 24,
+    168,  2479, 2600, 180,  191,  1742, 192,  35,   36,   13,   1611, 2469,
+    1677, 25,   1621, 3326, 3546, 1687, 2480, 3766, 2601, 1743, 1753, 37,
+    169,  2490, 2611, 181,  2491, 3986, 2612, 2721, 2722, 193,  203,  1808,
+    204,  1809, 1819, 205,  47,   48,   49,   14,   1612, 2470, 1678, 26,
+    1622, 3327, 3547, 1688, 2481, 3767, 2602, 1744, 1754, 38,   1631, 3336,
+    3556, 1697, 3381, 1600, 3601, 3776, 3821, 1763, 2492, 3987, 2613, 3996,
+    4041, 2723, 1810, 1820, 1829, 50,   170,  2501, 2622, 182,  2502, 4206,
+    2623, 2732, 2733, 194,  2503, 4207, 2624, 4216, 4261, 2734, 2831, 2832,
+    2833, 206,  215,  1874, 216,  1875, 1885, 217,  1876, 1886, 1895, 218,
+    59,   60,   61,   62,   15,   1613, 2471, 1679, 27,   1623, 3328, 3548,
+    1689, 2482, 3768, 2603, 1745, 1755, 39,   1632, 3337, 3557, 1698, 3382,
+    6186, 3602, 3777, 3822, 1764, 2493, 3988, 2614, 3997, 4042, 2724, 1811,
+    1821, 1830, 51,   1640, 3345, 3565, 1706, 3390, 6194, 3610, 3785, 3830,
+    1772, 3426, 6230, 3646, 6350, 1601, 3866, 4005, 4050, 4086, 1838, 2504,
+    4208, 2625, 4217, 4262, 2735, 4225, 4270, 4306, 2834, 1877, 1887, 1896,
+    1904, 63,   171,  2512, 2633, 183,  2513, 4426, 2634, 2743, 2744, 195,
+    2514, 4427, 2635, 4436, 4481, 2745, 2842, 2843, 2844, 207,  2515, 4428,
+    2636, 4437, 4482, 2746, 4445, 4490, 4526, 2845, 2930, 2931, 2932, 2933,
+    219,  227,  1940, 228,  1941, 1951, 229,  1942, 1952, 1961, 230,  1943,
+    1953, 1962, 1970, 231,  71,   72,   73,   74,   75,   16,   1614, 2472,
+    1680, 28,   1624, 3329, 3549, 1690, 2483, 3769, 2604, 1746, 1756, 40,
+    1633, 3338, 3558, 1699, 3383, 6187, 3603, 3778, 3823, 1765, 2494, 3989,
+    2615, 3998, 4043, 2725, 1812, 1822, 1831, 52,   1641, 3346, 3566, 1707,
+    3391, 6195, 3611, 3786, 3831, 1773, 3427, 6231, 3647, 6351, 6679, 3867,
+    4006, 4051, 4087, 1839, 2505, 4209, 2626, 4218, 4263, 2736, 4226, 4271,
+    4307, 2835, 1878, 1888, 1897, 1905, 64,   1648, 3353, 3573, 1714, 3398,
+    6202, 3618, 3793, 3838, 1780, 3434, 6238, 3654, 6358, 6686, 3874, 4013,
+    4058, 4094, 1846, 3462, 6266, 3682, 6386, 6714, 3902, 6470, 6798, 1602,
+    4122, 4233, 4278, 4314, 4342, 1912, 2516, 4429, 2637, 4438, 4483, 2747,
+    4446, 4491, 4527, 2846, 4453, 4498, 4534, 4562, 2934, 1944, 1954, 1963,
+    1971, 1978, 76,   172,  2523, 2644, 184,  2524, 4646, 2645, 2754, 2755,
+    196,  2525, 4647, 2646, 4656, 4701, 2756, 2853, 2854, 2855, 208,  2526,
+    4648, 2647, 4657, 4702, 2757, 4665, 4710, 4746, 2856, 2941, 2942, 2943,
+    2944, 220,  2527, 4649, 2648, 4658, 4703, 2758, 4666, 4711, 4747, 2857,
+    4673, 4718, 4754, 4782, 2945, 3018, 3019, 3020, 3021, 3022, 232,  239,
+    2006, 240,  2007, 2017, 241,  2008, 2018, 2027, 242,  2009, 2019, 2028,
+    2036, 243,  2010, 2020, 2029, 2037, 2044, 244,  83,   84,   85,   86,
+    87,   88,   17,   1615, 2473, 1681, 29,   1625, 3330, 3550, 1691, 2484,
+    3770, 2605, 1747, 1757, 41,   1634, 3339, 3559, 1700, 3384, 6188, 3604,
+    3779, 3824, 1766, 2495, 3990, 2616, 3999, 4044, 2726, 1813, 1823, 1832,
+    53,   1642, 3347, 3567, 1708, 3392, 6196, 3612, 3787, 3832, 1774, 3428,
+    6232, 3648, 6352, 6680, 3868, 4007, 4052, 4088, 1840, 2506, 4210, 2627,
+    4219, 4264, 2737, 4227, 4272, 4308, 2836, 1879, 1889, 1898, 1906, 65,
+    1649, 3354, 3574, 1715, 3399, 6203, 3619, 3794, 3839, 1781, 3435, 6239,
+    3655, 6359, 6687, 3875, 4014, 4059, 4095, 1847, 3463, 6267, 3683, 6387,
+    6715, 3903, 6471, 6799, 7008, 4123, 4234, 4279, 4315, 4343, 1913, 2517,
+    4430, 2638, 4439, 4484, 2748, 4447, 4492, 4528, 2847, 4454, 4499, 4535,
+    4563, 2935, 1945, 1955, 1964, 1972, 1979, 77,   1655, 3360, 3580, 1721,
+    3405, 6209, 3625, 3800, 3845, 1787, 3441, 6245, 3661, 6365, 6693, 3881,
+    4020, 4065, 4101, 1853, 3469, 6273, 3689, 6393, 6721, 3909, 6477, 6805,
+    7014, 4129, 4240, 4285, 4321, 4349, 1919, 3490, 6294, 3710, 6414, 6742,
+    3930, 6498, 6826, 7035, 4150, 6554, 6882, 7091, 1603, 4370, 4460, 4505,
+    4541, 4569, 4590, 1985, 2528, 4650, 2649, 4659, 4704, 2759, 4667, 4712,
+    4748, 2858, 4674, 4719, 4755, 4783, 2946, 4680, 4725, 4761, 4789, 4810,
+    3023, 2011, 2021, 2030, 2038, 2045, 2051, 89,   173,  2534, 2655, 185,
+    2535, 4866, 2656, 2765, 2766, 197,  2536, 4867, 2657, 4876, 4921, 2767,
+    2864, 2865, 2866, 209,  2537, 4868, 2658, 4877, 4922, 2768, 4885, 4930,
+    4966, 2867, 2952, 2953, 2954, 2955, 221,  2538, 4869, 2659, 4878, 4923,
+    2769, 4886, 4931, 4967, 2868, 4893, 4938, 4974, 5002, 2956, 3029, 3030,
+    3031, 3032, 3033, 233,  2539, 4870, 2660, 4879, 4924, 2770, 4887, 4932,
+    4968, 2869, 4894, 4939, 4975, 5003, 2957, 4900, 4945, 4981, 5009, 5030,
+    3034, 3095, 3096, 3097, 3098, 3099, 3100, 245,  251,  2072, 252,  2073,
+    2083, 253,  2074, 2084, 2093, 254,  2075, 2085, 2094, 2102, 255,  2076,
+    2086, 2095, 2103, 2110, 256,  2077, 2087, 2096, 2104, 2111, 2117, 257,
+    95,   96,   97,   98,   99,   100,  101,  18,   1616, 2474, 1682, 30,
+    1626, 3331, 3551, 1692, 2485, 3771, 2606, 1748, 1758, 42,   1635, 3340,
+    3560, 1701, 3385, 6189, 3605, 3780, 3825, 1767, 2496, 3991, 2617, 4000,
+    4045, 2727, 1814, 1824, 1833, 54,   1643, 3348, 3568, 1709, 3393, 6197,
+    3613, 3788, 3833, 1775, 3429, 6233, 3649, 6353, 6681, 3869, 4008, 4053,
+    4089, 1841, 2507, 4211, 2628, 4220, 4265, 2738, 4228, 4273, 4309, 2837,
+    1880, 1890, 1899, 1907, 66,   1650, 3355, 3575, 1716, 3400, 6204, 3620,
+    3795, 3840, 1782, 3436, 6240, 3656, 6360, 6688, 3876, 4015, 4060, 4096,
+    1848, 3464, 6268, 3684, 6388, 6716, 3904, 6472, 6800, 7009, 4124, 4235,
+    4280, 4316, 4344, 1914, 2518, 4431, 2639, 4440, 4485, 2749, 4448, 4493,
+    4529, 2848, 4455, 4500, 4536, 4564, 2936, 1946, 1956, 1965, 1973, 1980,
+    78,   1656, 3361, 3581, 1722, 3406, 6210, 3626, 3801, 3846, 1788, 3442,
+    6246, 3662, 6366, 6694, 3882, 4021, 4066, 4102, 1854, 3470, 6274, 3690,
+    6394, 6722, 3910, 6478, 6806, 7015, 4130, 4241, 4286, 4322, 4350, 1920,
+    3491, 6295, 3711, 6415, 6743, 3931, 6499, 6827, 7036, 4151, 6555, 6883,
+    7092, 7217, 4371, 4461, 4506, 4542, 4570, 4591, 1986, 2529, 4651, 2650,
+    4660, 4705, 2760, 4668, 4713, 4749, 2859, 4675, 4720, 4756, 4784, 2947,
+    4681, 4726, 4762, 4790, 4811, 3024, 2012, 2022, 2031, 2039, 2046, 2052,
+    90,   1661, 3366, 3586, 1727, 3411, 6215, 3631, 3806, 3851, 1793, 3447,
+    6251, 3667, 6371, 6699, 3887, 4026, 4071, 4107, 1859, 3475, 6279, 3695,
+    6399, 6727, 3915, 6483, 6811, 7020, 4135, 4246, 4291, 4327, 4355, 1925,
+    3496, 6300, 3716, 6420, 6748, 3936, 6504, 6832, 7041, 4156, 6560, 6888,
+    7097, 7222, 4376, 4466, 4511, 4547, 4575, 4596, 1991, 3511, 6315, 3731,
+    6435, 6763, 3951, 6519, 6847, 7056, 4171, 6575, 6903, 7112, 7237, 4391,
+    6610, 6938, 7147, 7272, 1604, 4611, 4686, 4731, 4767, 4795, 4816, 4831,
+    2057, 2540, 4871, 2661, 4880, 4925, 2771, 4888, 4933, 4969, 2870, 4895,
+    4940, 4976, 5004, 2958, 4901, 4946, 4982, 5010, 5031, 3035, 4906, 4951,
+    4987, 5015, 5036, 5051, 3101, 2078, 2088, 2097, 2105, 2112, 2118, 2123,
+    102,  174,  2545, 2666, 186,  2546, 5086, 2667, 2776, 2777, 198,  2547,
+    5087, 2668, 5096, 5141, 2778, 2875, 2876, 2877, 210,  2548, 5088, 2669,
+    5097, 5142, 2779, 5105, 5150, 5186, 2878, 2963, 2964, 2965, 2966, 222,
+    2549, 5089, 2670, 5098, 5143, 2780, 5106, 5151, 5187, 2879, 5113, 5158,
+    5194, 5222, 2967, 3040, 3041, 3042, 3043, 3044, 234,  2550, 5090, 2671,
+    5099, 5144, 2781, 5107, 5152, 5188, 2880, 5114, 5159, 5195, 5223, 2968,
+    5120, 5165, 5201, 5229, 5250, 3045, 3106, 3107, 3108, 3109, 3110, 3111,
+    246,  2551, 5091, 2672, 5100, 5145, 2782, 5108, 5153, 5189, 2881, 5115,
+    5160, 5196, 5224, 2969, 5121, 5166, 5202, 5230, 5251, 3046, 5126, 5171,
+    5207, 5235, 5256, 5271, 3112, 3161, 3162, 3163, 3164, 3165, 3166, 3167,
+    258,  263,  2138, 264,  2139, 2149, 265,  2140, 2150, 2159, 266,  2141,
+    2151, 2160, 2168, 267,  2142, 2152, 2161, 2169, 2176, 268,  2143, 2153,
+    2162, 2170, 2177, 2183, 269,  2144, 2154, 2163, 2171, 2178, 2184, 2189,
+    270,  107,  108,  109,  110,  111,  112,  113,  114,  19,   1617, 2475,
+    1683, 31,   1627, 3332, 3552, 1693, 2486, 3772, 2607, 1749, 1759, 43,
+    1636, 3341, 3561, 1702, 3386, 6190, 3606, 3781, 3826, 1768, 2497, 3992,
+    2618, 4001, 4046, 2728, 1815, 1825, 1834, 55,   1644, 3349, 3569, 1710,
+    3394, 6198, 3614, 3789, 3834, 1776, 3430, 6234, 3650, 6354, 6682, 3870,
+    4009, 4054, 4090, 1842, 2508, 4212, 2629, 4221, 4266, 2739, 4229, 4274,
+    4310, 2838, 1881, 1891, 1900, 1908, 67,   1651, 3356, 3576, 1717, 3401,
+    6205, 3621, 3796, 3841, 1783, 3437, 6241, 3657, 6361, 6689, 3877, 4016,
+    4061, 4097, 1849, 3465, 6269, 3685, 6389, 6717, 3905, 6473, 6801, 7010,
+    4125, 4236, 4281, 4317, 4345, 1915, 2519, 4432, 2640, 4441, 4486, 2750,
+    4449, 4494, 4530, 2849, 4456, 4501, 4537, 4565, 2937, 1947, 1957, 1966,
+    1974, 1981, 79,   1657, 3362, 3582, 1723, 3407, 6211, 3627, 3802, 3847,
+    1789, 3443, 6247, 3663, 6367, 6695, 3883, 4022, 4067, 4103, 1855, 3471,
+    6275, 3691, 6395, 6723, 3911, 6479, 6807, 7016, 4131, 4242, 4287, 4323,
+    4351, 1921, 3492, 6296, 3712, 6416, 6744, 3932, 6500, 6828, 7037, 4152,
+    6556, 6884, 7093, 7218, 4372, 4462, 4507, 4543, 4571, 4592, 1987, 2530,
+    4652, 2651, 4661, 4706, 2761, 4669, 4714, 4750, 2860, 4676, 4721, 4757,
+    4785, 2948, 4682, 4727, 4763, 4791, 4812, 3025, 2013, 2023, 2032, 2040,
+    2047, 2053, 91,   1662, 3367, 3587, 1728, 3412, 6216, 3632, 3807, 3852,
+    1794, 3448, 6252, 3668, 6372, 6700, 3888, 4027, 4072, 4108, 1860, 3476,
+    6280, 3696, 6400, 6728, 3916, 6484, 6812, 7021, 4136, 4247, 4292, 4328,
+    4356, 1926, 3497, 6301, 3717, 6421, 6749, 3937, 6505, 6833, 7042, 4157,
+    6561, 6889, 7098, 7223, 4377, 4467, 4512, 4548, 4576, 4597, 1992, 3512,
+    6316, 3732, 6436, 6764, 3952, 6520, 6848, 7057, 4172, 6576, 6904, 7113,
+    7238, 4392, 6611, 6939, 7148, 7273, 7342, 4612, 4687, 4732, 4768, 4796,
+    4817, 4832, 2058, 2541, 4872, 2662, 4881, 4926, 2772, 4889, 4934, 4970,
+    2871, 4896, 4941, 4977, 5005, 2959, 4902, 4947, 4983, 5011, 5032, 3036,
+    4907, 4952, 4988, 5016, 5037, 5052, 3102, 2079, 2089, 2098, 2106, 2113,
+    2119, 2124, 103,  1666, 3371, 3591, 1732, 3416, 6220, 3636, 3811, 3856,
+    1798, 3452, 6256, 3672, 6376, 6704, 3892, 4031, 4076, 4112, 1864, 3480,
+    6284, 3700, 6404, 6732, 3920, 6488, 6816, 7025, 4140, 4251, 4296, 4332,
+    4360, 1930, 3501, 6305, 3721, 6425, 6753, 3941, 6509, 6837, 7046, 4161,
+    6565, 6893, 7102, 7227, 4381, 4471, 4516, 4552, 4580, 4601, 1996, 3516,
+    6320, 3736, 6440, 6768, 3956, 6524, 6852, 7061, 4176, 6580, 6908, 7117,
+    7242, 4396, 6615, 6943, 7152, 7277, 7346, 4616, 4691, 4736, 4772, 4800,
+    4821, 4836, 2062, 3526, 6330, 3746, 6450, 6778, 3966, 6534, 6862, 7071,
+    4186, 6590, 6918, 7127, 7252, 4406, 6625, 6953, 7162, 7287, 7356, 4626,
+    6645, 6973, 7182, 7307, 7376, 1605, 4846, 4911, 4956, 4992, 5020, 5041,
+    5056, 5066, 2128, 2552, 5092, 2673, 5101, 5146, 2783, 5109, 5154, 5190,
+    2882, 5116, 5161, 5197, 5225, 2970, 5122, 5167, 5203, 5231, 5252, 3047,
+    5127, 5172, 5208, 5236, 5257, 5272, 3113, 5131, 5176, 5212, 5240, 5261,
+    5276, 5286, 3168, 2145, 2155, 2164, 2172, 2179, 2185, 2190, 2194, 115,
+    175,  2556, 2677, 187,  2557, 5306, 2678, 2787, 2788, 199,  2558, 5307,
+    2679, 5316, 5361, 2789, 2886, 2887, 2888, 211,  2559, 5308, 2680, 5317,
+    5362, 2790, 5325, 5370, 5406, 2889, 2974, 2975, 2976, 2977, 223,  2560,
+    5309, 2681, 5318, 5363, 2791, 5326, 5371, 5407, 2890, 5333, 5378, 5414,
+    5442, 2978, 3051, 3052, 3053, 3054, 3055, 235,  2561, 5310, 2682, 5319,
+    5364, 2792, 5327, 5372, 5408, 2891, 5334, 5379, 5415, 5443, 2979, 5340,
+    5385, 5421, 5449, 5470, 3056, 3117, 3118, 3119, 3120, 3121, 3122, 247,
+    2562, 5311, 2683, 5320, 5365, 2793, 5328, 5373, 5409, 2892, 5335, 5380,
+    5416, 5444, 2980, 5341, 5386, 5422, 5450, 5471, 3057, 5346, 5391, 5427,
+    5455, 5476, 5491, 3123, 3172, 3173, 3174, 3175, 3176, 3177, 3178, 259,
+    2563, 5312, 2684, 5321, 5366, 2794, 5329, 5374, 5410, 2893, 5336, 5381,
+    5417, 5445, 2981, 5342, 5387, 5423, 5451, 5472, 3058, 5347, 5392, 5428,
+    5456, 5477, 5492, 3124, 5351, 5396, 5432, 5460, 5481, 5496, 5506, 3179,
+    3216, 3217, 3218, 3219, 3220, 3221, 3222, 3223, 271,  275,  2204, 276,
+    2205, 2215, 277,  2206, 2216, 2225, 278,  2207, 2217, 2226, 2234, 279,
+    2208, 2218, 2227, 2235, 2242, 280,  2209, 2219, 2228, 2236, 2243, 2249,
+    281,  2210, 2220, 2229, 2237, 2244, 2250, 2255, 282,  2211, 2221, 2230,
+    2238, 2245, 2251, 2256, 2260, 283,  119,  120,  121,  122,  123,  124,
+    125,  126,  127,  20,   1618, 2476, 1684, 32,   1628, 3333, 3553, 1694,
+    2487, 3773, 2608, 1750, 1760, 44,   1637, 3342, 3562, 1703, 3387, 6191,
+    3607, 3782, 3827, 1769, 2498, 3993, 2619, 4002, 4047, 2729, 1816, 1826,
+    1835, 56,   1645, 3350, 3570, 1711, 3395, 6199, 3615, 3790, 3835, 1777,
+    3431, 6235, 3651, 6355, 6683, 3871, 4010, 4055, 4091, 1843, 2509, 4213,
+    2630, 4222, 4267, 2740, 4230, 4275, 4311, 2839, 1882, 1892, 1901, 1909,
+    68,   1652, 3357, 3577, 1718, 3402, 6206, 3622, 3797, 3842, 1784, 3438,
+    6242, 3658, 6362, 6690, 3878, 4017, 4062, 4098, 1850, 3466, 6270, 3686,
+    6390, 6718, 3906, 6474, 6802, 7011, 4126, 4237, 4282, 4318, 4346, 1916,
+    2520, 4433, 2641, 4442, 4487, 2751, 4450, 4495, 4531, 2850, 4457, 4502,
+    4538, 4566, 2938, 1948, 1958, 1967, 1975, 1982, 80,   1658, 3363, 3583,
+    1724, 3408, 6212, 3628, 3803, 3848, 1790, 3444, 6248, 3664, 6368, 6696,
+    3884, 4023, 4068, 4104, 1856, 3472, 6276, 3692, 6396, 6724, 3912, 6480,
+    6808, 7017, 4132, 4243, 4288, 4324, 4352, 1922, 3493, 6297, 3713, 6417,
+    6745, 3933, 6501, 6829, 7038, 4153, 6557, 6885, 7094, 7219, 4373, 4463,
+    4508, 4544, 4572, 4593, 1988, 2531, 4653, 2652, 4662, 4707, 2762, 4670,
+    4715, 4751, 2861, 4677, 4722, 4758, 4786, 2949, 4683, 4728, 4764, 4792,
+    4813, 3026, 2014, 2024, 2033, 2041, 2048, 2054, 92,   1663, 3368, 3588,
+    1729, 3413, 6217, 3633, 3808, 3853, 1795, 3449, 6253, 3669, 6373, 6701,
+    3889, 4028, 4073, 4109, 1861, 3477, 6281, 3697, 6401, 6729, 3917, 6485,
+    6813, 7022, 4137, 4248, 4293, 4329, 4357, 1927, 3498, 6302, 3718, 6422,
+    6750, 3938, 6506, 6834, 7043, 4158, 6562, 6890, 7099, 7224, 4378, 4468,
+    4513, 4549, 4577, 4598, 1993, 3513, 6317, 3733, 6437, 6765, 3953, 6521,
+    6849, 7058, 4173, 6577, 6905, 7114, 7239, 4393, 6612, 6940, 7149, 7274,
+    7343, 4613, 4688, 4733, 4769, 4797, 4818, 4833, 2059, 2542, 4873, 2663,
+    4882, 4927, 2773, 4890, 4935, 4971, 2872, 4897, 4942, 4978, 5006, 2960,
+    4903, 4948, 4984, 5012, 5033, 3037, 4908, 4953, 4989, 5017, 5038, 5053,
+    3103, 2080, 2090, 2099, 2107, 2114, 2120, 2125, 104,  1667, 3372, 3592,
+    1733, 3417, 6221, 3637, 3812, 3857, 1799, 3453, 6257, 3673, 6377, 6705,
+    3893, 4032, 4077, 4113, 1865, 3481, 6285, 3701, 6405, 6733, 3921, 6489,
+    6817, 7026, 4141, 4252, 4297, 4333, 4361, 1931, 3502, 6306, 3722, 6426,
+    6754, 3942, 6510, 6838, 7047, 4162, 6566, 6894, 7103, 7228, 4382, 4472,
+    4517, 4553, 4581, 4602, 1997, 3517, 6321, 3737, 6441, 6769, 3957, 6525,
+    6853, 7062, 4177, 6581, 6909, 7118, 7243, 4397, 6616, 6944, 7153, 7278,
+    7347, 4617, 4692, 4737, 4773, 4801, 4822, 4837, 2063, 3527, 6331, 3747,
+    6451, 6779, 3967, 6535, 6863, 7072, 4187, 6591, 6919, 7128, 7253, 4407,
+    6626, 6954, 7163, 7288, 7357, 4627, 6646, 6974, 7183, 7308, 7377, 7411,
+    4847, 4912, 4957, 4993, 5021, 5042, 5057, 5067, 2129, 2553, 5093, 2674,
+    5102, 5147, 2784, 5110, 5155, 5191, 2883, 5117, 5162, 5198, 5226, 2971,
+    5123, 5168, 5204, 5232, 5253, 3048, 5128, 5173, 5209, 5237, 5258, 5273,
+    3114, 5132, 5177, 5213, 5241, 5262, 5277, 5287, 3169, 2146, 2156, 2165,
+    2173, 2180, 2186, 2191, 2195, 116,  1670, 3375, 3595, 1736, 3420, 6224,
+    3640, 3815, 3860, 1802, 3456, 6260, 3676, 6380, 6708, 3896, 4035, 4080,
+    4116, 1868, 3484, 6288, 3704, 6408, 6736, 3924, 6492, 6820, 7029, 4144,
+    4255, 4300, 4336, 4364, 1934, 3505, 6309, 3725, 6429, 6757, 3945, 6513,
+    6841, 7050, 4165, 6569, 6897, 7106, 7231, 4385, 4475, 4520, 4556, 4584,
+    4605, 2000, 3520, 6324, 3740, 6444, 6772, 3960, 6528, 6856, 7065, 4180,
+    6584, 6912, 7121, 7246, 4400, 6619, 6947, 7156, 7281, 7350, 4620, 4695,
+    4740, 4776, 4804, 4825, 4840, 2066, 3530, 6334, 3750, 6454, 6782, 3970,
+    6538, 6866, 7075, 4190, 6594, 6922, 7131, 7256, 4410, 6629, 6957, 7166,
+    7291, 7360, 4630, 6649, 6977, 7186, 7311, 7380, 7414, 4850, 4915, 4960,
+    4996, 5024, 5045, 5060, 5070, 2132, 3536, 6340, 3756, 6460, 6788, 3976,
+    6544, 6872, 7081, 4196, 6600, 6928, 7137, 7262, 4416, 6635, 6963, 7172,
+    7297, 7366, 4636, 6655, 6983, 7192, 7317, 7386, 7420, 4856, 1607, 1607,
+    1607, 1607, 1607, 1607, 1606, 1607, 5135, 5180, 5216, 5244, 5265, 5280,
+    5290, 1607, 2198, 2564, 5313, 2685, 5322, 5367, 2795, 5330, 5375, 5411,
+    2894, 5337, 5382, 5418, 5446, 2982, 5343, 5388, 5424, 5452, 5473, 3059,
+    5348, 5393, 5429, 5457, 5478, 5493, 3125, 5352, 5397, 5433, 5461, 5482,
+    5497, 5507, 3180, 5355, 5400, 5436, 5464, 5485, 5500, 5510, 1607, 3224,
+    2212, 2222, 2231, 2239, 2246, 2252, 2257, 2261, 2264, 128,  176,  2567,
+    2688, 188,  2568, 5526, 2689, 2798, 2799, 200,  2569, 5527, 2690, 5536,
+    5581, 2800, 2897, 2898, 2899, 212,  2570, 5528, 2691, 5537, 5582, 2801,
+    5545, 5590, 5626, 2900, 2985, 2986, 2987, 2988, 224,  2571, 5529, 2692,
+    5538, 5583, 2802, 5546, 5591, 5627, 2901, 5553, 5598, 5634, 5662, 2989,
+    3062, 3063, 3064, 3065, 3066, 236,  2572, 5530, 2693, 5539, 5584, 2803,
+    5547, 5592, 5628, 2902, 5554, 5599, 5635, 5663, 2990, 5560, 5605, 5641,
+    5669, 5690, 3067, 3128, 3129, 3130, 3131, 3132, 3133, 248,  2573, 5531,
+    2694, 5540, 5585, 2804, 5548, 5593, 5629, 2903, 5555, 5600, 5636, 5664,
+    2991, 5561, 5606, 5642, 5670, 5691, 3068, 5566, 5611, 5647, 5675, 5696,
+    5711, 3134, 3183, 3184, 3185, 3186, 3187, 3188, 3189, 260,  2574, 5532,
+    2695, 5541, 5586, 2805, 5549, 5594, 5630, 2904, 5556, 5601, 5637, 5665,
+    2992, 5562, 5607, 5643, 5671, 5692, 3069, 5567, 5612, 5648, 5676, 5697,
+    5712, 3135, 5571, 5616, 5652, 5680, 5701, 5716, 5726, 3190, 3227, 3228,
+    3229, 3230, 3231, 3232, 3233, 3234, 272,  2575, 5533, 2696, 5542, 5587,
+    2806, 5550, 5595, 5631, 2905, 5557, 5602, 5638, 5666, 2993, 5563, 5608,
+    5644, 5672, 5693, 3070, 5568, 5613, 5649, 5677, 5698, 5713, 3136, 5572,
+    5617, 5653, 5681, 5702, 5717, 5727, 3191, 5575, 5620, 5656, 5684, 5705,
+    5720, 5730, 1607, 3235, 3260, 3261, 3262, 3263, 3264, 3265, 3266, 3267,
+    3268, 284,  287,  2270, 288,  2271, 2281, 289,  2272, 2282, 2291, 290,
+    2273, 2283, 2292, 2300, 291,  2274, 2284, 2293, 2301, 2308, 292,  2275,
+    2285, 2294, 2302, 2309, 2315, 293,  2276, 2286, 2295, 2303, 2310, 2316,
+    2321, 294,  2277, 2287, 2296, 2304, 2311, 2317, 2322, 2326, 295,  2278,
+    2288, 2297, 2305, 2312, 2318, 2323, 2327, 2330, 296,  131,  132,  133,
+    134,  135,  136,  137,  138,  139,  140,  21,   177,  2477, 189,  33,
+    177,  2578, 2699, 189,  2488, 2809, 2609, 201,  201,  45,   177,  2578,
+    2699, 189,  2579, 5746, 2700, 2809, 2810, 201,  2499, 2908, 2620, 2908,
+    2909, 2730, 213,  213,  213,  57,   177,  2578, 2699, 189,  2579, 5746,
+    2700, 2809, 2810, 201,  2580, 5747, 2701, 5756, 5801, 2811, 2908, 2909,
+    2910, 213,  2510, 2996, 2631, 2996, 2997, 2741, 2996, 2997, 2998, 2840,
+    225,  225,  225,  225,  69,   177,  2578, 2699, 189,  2579, 5746, 2700,
+    2809, 2810, 201,  2580, 5747, 2701, 5756, 5801, 2811, 2908, 2909, 2910,
+    213,  2581, 5748, 2702, 5757, 5802, 2812, 5765, 5810, 5846, 2911, 2996,
+    2997, 2998, 2999, 225,  2521, 3073, 2642, 3073, 3074, 2752, 3073, 3074,
+    3075, 2851, 3073, 3074, 3075, 3076, 2939, 237,  237,  237,  237,  237,
+    81,   177,  2578, 2699, 189,  2579, 5746, 2700, 2809, 2810, 201,  2580,
+    5747, 2701, 5756, 5801, 2811, 2908, 2909, 2910, 213,  2581, 5748, 2702,
+    5757, 5802, 2812, 5765, 5810, 5846, 2911, 2996, 2997, 2998, 2999, 225,
+    2582, 5749, 2703, 5758, 5803, 2813, 5766, 5811, 5847, 2912, 5773, 5818,
+    5854, 5882, 3000, 3073, 3074, 3075, 3076, 3077, 237,  2532, 3139, 2653,
+    3139, 3140, 2763, 3139, 3140, 3141, 2862, 3139, 3140, 3141, 3142, 2950,
+    3139, 3140, 3141, 3142, 3143, 3027, 249,  249,  249,  249,  249,  249,
+    93,   177,  2578, 2699, 189,  2579, 5746, 2700, 2809, 2810, 201,  2580,
+    5747, 2701, 5756, 5801, 2811, 2908, 2909, 2910, 213,  2581, 5748, 2702,
+    5757, 5802, 2812, 5765, 5810, 5846, 2911, 2996, 2997, 2998, 2999, 225,
+    2582, 5749, 2703, 5758, 5803, 2813, 5766, 5811, 5847, 2912, 5773, 5818,
+    5854, 5882, 3000, 3073, 3074, 3075, 3076, 3077, 237,  2583, 5750, 2704,
+    5759, 5804, 2814, 5767, 5812, 5848, 2913, 5774, 5819, 5855, 5883, 3001,
+    5780, 5825, 5861, 5889, 5910, 3078, 3139, 3140, 3141, 3142, 3143, 3144,
+    249,  2543, 3194, 2664, 3194, 3195, 2774, 3194, 3195, 3196, 2873, 3194,
+    3195, 3196, 3197, 2961, 3194, 3195, 3196, 3197, 3198, 3038, 3194, 3195,
+    3196, 3197, 3198, 3199, 3104, 261,  261,  261,  261,  261,  261,  261,
+    105,  177,  2578, 2699, 189,  2579, 5746, 2700, 2809, 2810, 201,  2580,
+    5747, 2701, 5756, 5801, 2811, 2908, 2909, 2910, 213,  2581, 5748, 2702,
+    5757, 5802, 2812, 5765, 5810, 5846, 2911, 2996, 2997, 2998, 2999, 225,
+    2582, 5749, 2703, 5758, 5803, 2813, 5766, 5811, 5847, 2912, 5773, 5818,
+    5854, 5882, 3000, 3073, 3074, 3075, 3076, 3077, 237,  2583, 5750, 2704,
+    5759, 5804, 2814, 5767, 5812, 5848, 2913, 5774, 5819, 5855, 5883, 3001,
+    5780, 5825, 5861, 5889, 5910, 3078, 3139, 3140, 3141, 3142, 3143, 3144,
+    249,  2584, 5751, 2705, 5760, 5805, 2815, 5768, 5813, 5849, 2914, 5775,
+    5820, 5856, 5884, 3002, 5781, 5826, 5862, 5890, 5911, 3079, 5786, 5831,
+    5867, 5895, 5916, 5931, 3145, 3194, 3195, 3196, 3197, 3198, 3199, 3200,
+    261,  2554, 3238, 2675, 3238, 3239, 2785, 3238, 3239, 3240, 2884, 3238,
+    3239, 3240, 3241, 2972, 3238, 3239, 3240, 3241, 3242, 3049, 3238, 3239,
+    3240, 3241, 3242, 3243, 3115, 3238, 3239, 3240, 3241, 3242, 3243, 3244,
+    3170, 273,  273,  273,  273,  273,  273,  273,  273,  117,  177,  2578,
+    2699, 189,  2579, 5746, 2700, 2809, 2810, 201,  2580, 5747, 2701, 5756,
+    5801, 2811, 2908, 2909, 2910, 213,  2581, 5748, 2702, 5757, 5802, 2812,
+    5765, 5810, 5846, 2911, 2996, 2997, 2998, 2999, 225,  2582, 5749, 2703,
+    5758, 5803, 2813, 5766, 5811, 5847, 2912, 5773, 5818, 5854, 5882, 3000,
+    3073, 3074, 3075, 3076, 3077, 237,  2583, 5750, 2704, 5759, 5804, 2814,
+    5767, 5812, 5848, 2913, 5774, 5819, 5855, 5883, 3001, 5780, 5825, 5861,
+    5889, 5910, 3078, 3139, 3140, 3141, 3142, 3143, 3144, 249,  2584, 5751,
+    2705, 5760, 5805, 2815, 5768, 5813, 5849, 2914, 5775, 5820, 5856, 5884,
+    3002, 5781, 5826, 5862, 5890, 5911, 3079, 5786, 5831, 5867, 5895, 5916,
+    5931, 3145, 3194, 3195, 3196, 3197, 3198, 3199, 3200, 261,  2585, 5752,
+    2706, 5761, 5806, 2816, 5769, 5814, 5850, 2915, 5776, 5821, 5857, 5885,
+    3003, 5782, 5827, 5863, 5891, 5912, 3080, 5787, 5832, 5868, 5896, 5917,
+    5932, 3146, 5791, 5836, 5872, 5900, 5921, 5936, 5946, 3201, 3238, 3239,
+    3240, 3241, 3242, 3243, 3244, 3245, 273,  2565, 3271, 2686, 3271, 3272,
+    2796, 3271, 3272, 3273, 2895, 3271, 3272, 3273, 3274, 2983, 3271, 3272,
+    3273, 3274, 3275, 3060, 3271, 3272, 3273, 3274, 3275, 3276, 3126, 3271,
+    3272, 3273, 3274, 3275, 3276, 3277, 3181, 3271, 3272, 3273, 3274, 3275,
+    3276, 3277, 3278, 3225, 285,  285,  285,  285,  285,  285,  285,  285,
+    285,  129,  177,  2578, 2699, 189,  2579, 5746, 2700, 2809, 2810, 201,
+    2580, 5747, 2701, 5756, 5801, 2811, 2908, 2909, 2910, 213,  2581, 5748,
+    2702, 5757, 5802, 2812, 5765, 5810, 5846, 2911, 2996, 2997, 2998, 2999,
+    225,  2582, 5749, 2703, 5758, 5803, 2813, 5766, 5811, 5847, 2912, 5773,
+    5818, 5854, 5882, 3000, 3073, 3074, 3075, 3076, 3077, 237,  2583, 5750,
+    2704, 5759, 5804, 2814, 5767, 5812, 5848, 2913, 5774, 5819, 5855, 5883,
+    3001, 5780, 5825, 5861, 5889, 5910, 3078, 3139, 3140, 3141, 3142, 3143,
+    3144, 249,  2584, 5751, 2705, 5760, 5805, 2815, 5768, 5813, 5849, 2914,
+    5775, 5820, 5856, 5884, 3002, 5781, 5826, 5862, 5890, 5911, 3079, 5786,
+    5831, 5867, 5895, 5916, 5931, 3145, 3194, 3195, 3196, 3197, 3198, 3199,
+    3200, 261,  2585, 5752, 2706, 5761, 5806, 2816, 5769, 5814, 5850, 2915,
+    5776, 5821, 5857, 5885, 3003, 5782, 5827, 5863, 5891, 5912, 3080, 5787,
+    5832, 5868, 5896, 5917, 5932, 3146, 5791, 5836, 5872, 5900, 5921, 5936,
+    5946, 3201, 3238, 3239, 3240, 3241, 3242, 3243, 3244, 3245, 273,  2586,
+    5753, 2707, 5762, 5807, 2817, 5770, 5815, 5851, 2916, 5777, 5822, 5858,
+    5886, 3004, 5783, 5828, 5864, 5892, 5913, 3081, 5788, 5833, 5869, 5897,
+    5918, 5933, 3147, 5792, 5837, 5873, 5901, 5922, 5937, 5947, 3202, 5795,
+    5840, 5876, 5904, 5925, 5940, 5950, 1607, 3246, 3271, 3272, 3273, 3274,
+    3275, 3276, 3277, 3278, 3279, 285,  2576, 3293, 2697, 3293, 3294, 2807,
+    3293, 3294, 3295, 2906, 3293, 3294, 3295, 3296, 2994, 3293, 3294, 3295,
+    3296, 3297, 3071, 3293, 3294, 3295, 3296, 3297, 3298, 3137, 3293, 3294,
+    3295, 3296, 3297, 3298, 3299, 3192, 3293, 3294, 3295, 3296, 3297, 3298,
+    3299, 3300, 3236, 3293, 3294, 3295, 3296, 3297, 3298, 3299, 3300, 3301,
+    3269, 297,  297,  297,  297,  297,  297,  297,  297,  297,  297,  141,
+    177,  299,  300,  189,  299,  2336, 300,  301,  301,  201,  299,  2336,
+    300,  2337, 2347, 301,  302,  302,  302,  213,  299,  2336, 300,  2337,
+    2347, 301,  2338, 2348, 2357, 302,  303,  303,  303,  303,  225,  299,
+    2336, 300,  2337, 2347, 301,  2338, 2348, 2357, 302,  2339, 2349, 2358,
+    2366, 303,  304,  304,  304,  304,  304,  237,  299,  2336, 300,  2337,
+    2347, 301,  2338, 2348, 2357, 302,  2339, 2349, 2358, 2366, 303,  2340,
+    2350, 2359, 2367, 2374, 304,  305,  305,  305,  305,  305,  305,  249,
+    299,  2336, 300,  2337, 2347, 301,  2338, 2348, 2357, 302,  2339, 2349,
+    2358, 2366, 303,  2340, 2350, 2359, 2367, 2374, 304,  2341, 2351, 2360,
+    2368, 2375, 2381, 305,  306,  306,  306,  306,  306,  306,  306,  261,
+    299,  2336, 300,  2337, 2347, 301,  2338, 2348, 2357, 302,  2339, 2349,
+    2358, 2366, 303,  2340, 2350, 2359, 2367, 2374, 304,  2341, 2351, 2360,
+    2368, 2375, 2381, 305,  2342, 2352, 2361, 2369, 2376, 2382, 2387, 306,
+    307,  307,  307,  307,  307,  307,  307,  307,  273,  299,  2336, 300,
+    2337, 2347, 301,  2338, 2348, 2357, 302,  2339, 2349, 2358, 2366, 303,
+    2340, 2350, 2359, 2367, 2374, 304,  2341, 2351, 2360, 2368, 2375, 2381,
+    305,  2342, 2352, 2361, 2369, 2376, 2382, 2387, 306,  2343, 2353, 2362,
+    2370, 2377, 2383, 2388, 2392, 307,  308,  308,  308,  308,  308,  308,
+    308,  308,  308,  285,  299,  2336, 300,  2337, 2347, 301,  2338, 2348,
+    2357, 302,  2339, 2349, 2358, 2366, 303,  2340, 2350, 2359, 2367, 2374,
+    304,  2341, 2351, 2360, 2368, 2375, 2381, 305,  2342, 2352, 2361, 2369,
+    2376, 2382, 2387, 306,  2343, 2353, 2362, 2370, 2377, 2383, 2388, 2392,
+    307,  2344, 2354, 2363, 2371, 2378, 2384, 2389, 2393, 2396, 308,  309,
+    309,  309,  309,  309,  309,  309,  309,  309,  309,  297,  143,  143,
+    144,  143,  144,  145,  143,  144,  145,  146,  143,  144,  145,  146,
+    147,  143,  144,  145,  146,  147,  148,  143,  144,  145,  146,  147,
+    148,  149,  143,  144,  145,  146,  147,  148,  149,  150,  143,  144,
+    145,  146,  147,  148,  149,  150,  151,  143,  144,  145,  146,  147,
+    148,  149,  150,  151,  152,  143,  144,  145,  146,  147,  148,  149,
+    150,  151,  152,  153,  11,   167,  179,  23,   12,   1610, 2468, 1676,
+    24,   168,  2479, 2600, 180,  191,  1742, 192,  35,   36,   13,   1611,
+    2469, 1677, 25,   1621, 3326, 3546, 1687, 2480, 3766, 2601, 1743, 1753,
+    37,   169,  2490, 2611, 181,  2491, 3986, 2612, 2721, 2722, 193,  203,
+    1808, 204,  1809, 1819, 205,  47,   48,   49,   14,   1612, 2470, 1678,
+    26,   1622, 3327, 3547, 1688, 2481, 3767, 2602, 1744, 1754, 38,   1631,
+    3336, 3556, 1697, 3381, 1600, 3601, 3776, 3821, 1763, 2492, 3987, 2613,
+    3996, 4041, 2723, 1810, 1820, 1829, 50,   170,  2501, 2622, 182,  2502,
+    4206, 2623, 2732, 2733, 194,  2503, 4207, 2624, 4216, 4261, 2734, 2831,
+    2832, 2833, 206,  215,  1874, 216,  1875, 1885, 217,  1876, 1886, 1895,
+    218,  59,   60,   61,   62,   15,   1613, 2471, 1679, 27,   1623, 3328,
+    3548, 1689, 2482, 3768, 2603, 1745, 1755, 39,   1632, 3337, 3557, 1698,
+    3382, 6186, 3602, 3777, 3822, 1764, 2493, 3988, 2614, 3997, 4042, 2724,
+    1811, 1821, 1830, 51,   1640, 3345, 3565, 1706, 3390, 6194, 3610, 3785,
+    3830, 1772, 3426, 6230, 3646, 6350, 1601, 3866, 4005, 4050, 4086, 1838,
+    2504, 4208, 2625, 4217, 4262, 2735, 4225, 4270, 4306, 2834, 1877, 1887,
+    1896, 1904, 63,   171,  2512, 2633, 183,  2513, 4426, 2634, 2743, 2744,
+    195,  2514, 4427, 2635, 4436, 4481, 2745, 2842, 2843, 2844, 207,  2515,
+    4428, 2636, 4437, 4482, 2746, 4445, 4490, 4526, 2845, 2930, 2931, 2932,
+    2933, 219,  227,  1940, 228,  1941, 1951, 229,  1942, 1952, 1961, 230,
+    1943, 1953, 1962, 1970, 231,  71,   72,   73,   74,   75,   16,   1614,
+    2472, 1680, 28,   1624, 3329, 3549, 1690, 2483, 3769, 2604, 1746, 1756,
+    40,   1633, 3338, 3558, 1699, 3383, 6187, 3603, 3778, 3823, 1765, 2494,
+    3989, 2615, 3998, 4043, 2725, 1812, 1822, 1831, 52,   1641, 3346, 3566,
+    1707, 3391, 6195, 3611, 3786, 3831, 1773, 3427, 6231, 3647, 6351, 6679,
+    3867, 4006, 4051, 4087, 1839, 2505, 4209, 2626, 4218, 4263, 2736, 4226,
+    4271, 4307, 2835, 1878, 1888, 1897, 1905, 64,   1648, 3353, 3573, 1714,
+    3398, 6202, 3618, 3793, 3838, 1780, 3434, 6238, 3654, 6358, 6686, 3874,
+    4013, 4058, 4094, 1846, 3462, 6266, 3682, 6386, 6714, 3902, 6470, 6798,
+    1602, 4122, 4233, 4278, 4314, 4342, 1912, 2516, 4429, 2637, 4438, 4483,
+    2747, 4446, 4491, 4527, 2846, 4453, 4498, 4534, 4562, 2934, 1944, 1954,
+    1963, 1971, 1978, 76,   172,  2523, 2644, 184,  2524, 4646, 2645, 2754,
+    2755, 196,  2525, 4647, 2646, 4656, 4701, 2756, 2853, 2854, 2855, 208,
+    2526, 4648, 2647, 4657, 4702, 2757, 4665, 4710, 4746, 2856, 2941, 2942,
+    2943, 2944, 220,  2527, 4649, 2648, 4658, 4703, 2758, 4666, 4711, 4747,
+    2857, 4673, 4718, 4754, 4782, 2945, 3018, 3019, 3020, 3021, 3022, 232,
+    239,  2006, 240,  2007, 2017, 241,  2008, 2018, 2027, 242,  2009, 2019,
+    2028, 2036, 243,  2010, 2020, 2029, 2037, 2044, 244,  83,   84,   85,
+    86,   87,   88,   17,   1615, 2473, 1681, 29,   1625, 3330, 3550, 1691,
+    2484, 3770, 2605, 1747, 1757, 41,   1634, 3339, 3559, 1700, 3384, 6188,
+    3604, 3779, 3824, 1766, 2495, 3990, 2616, 3999, 4044, 2726, 1813, 1823,
+    1832, 53,   1642, 3347, 3567, 1708, 3392, 6196, 3612, 3787, 3832, 1774,
+    3428, 6232, 3648, 6352, 6680, 3868, 4007, 4052, 4088, 1840, 2506, 4210,
+    2627, 4219, 4264, 2737, 4227, 4272, 4308, 2836, 1879, 1889, 1898, 1906,
+    65,   1649, 3354, 3574, 1715, 3399, 6203, 3619, 3794, 3839, 1781, 3435,
+    6239, 3655, 6359, 6687, 3875, 4014, 4059, 4095, 1847, 3463, 6267, 3683,
+    6387, 6715, 3903, 6471, 6799, 7008, 4123, 4234, 4279, 4315, 4343, 1913,
+    2517, 4430, 2638, 4439, 4484, 2748, 4447, 4492, 4528, 2847, 4454, 4499,
+    4535, 4563, 2935, 1945, 1955, 1964, 1972, 1979, 77,   1655, 3360, 3580,
+    1721, 3405, 6209, 3625, 3800, 3845, 1787, 3441, 6245, 3661, 6365, 6693,
+    3881, 4020, 4065, 4101, 1853, 3469, 6273, 3689, 6393, 6721, 3909, 6477,
+    6805, 7014, 4129, 4240, 4285, 4321, 4349, 1919, 3490, 6294, 3710, 6414,
+    6742, 3930, 6498, 6826, 7035, 4150, 6554, 6882, 7091, 1603, 4370, 4460,
+    4505, 4541, 4569, 4590, 1985, 2528, 4650, 2649, 4659, 4704, 2759, 4667,
+    4712, 4748, 2858, 4674, 4719, 4755, 4783, 2946, 4680, 4725, 4761, 4789,
+    4810, 3023, 2011, 2021, 2030, 2038, 2045, 2051, 89,   173,  2534, 2655,
+    185,  2535, 4866, 2656, 2765, 2766, 197,  2536, 4867, 2657, 4876, 4921,
+    2767, 2864, 2865, 2866, 209,  2537, 4868, 2658, 4877, 4922, 2768, 4885,
+    4930, 4966, 2867, 2952, 2953, 2954, 2955, 221,  2538, 4869, 2659, 4878,
+    4923, 2769, 4886, 4931, 4967, 2868, 4893, 4938, 4974, 5002, 2956, 3029,
+    3030, 3031, 3032, 3033, 233,  2539, 4870, 2660, 4879, 4924, 2770, 4887,
+    4932, 4968, 2869, 4894, 4939, 4975, 5003, 2957, 4900, 4945, 4981, 5009,
+    5030, 3034, 3095, 3096, 3097, 3098, 3099, 3100, 245,  251,  2072, 252,
+    2073, 2083, 253,  2074, 2084, 2093, 254,  2075, 2085, 2094, 2102, 255,
+    2076, 2086, 2095, 2103, 2110, 256,  2077, 2087, 2096, 2104, 2111, 2117,
+    257,  95,   96,   97,   98,   99,   100,  101,  18,   1616, 2474, 1682,
+    30,   1626, 3331, 3551, 1692, 2485, 3771, 2606, 1748, 1758, 42,   1635,
+    3340, 3560, 1701, 3385, 6189, 3605, 3780, 3825, 1767, 2496, 3991, 2617,
+    4000, 4045, 2727, 1814, 1824, 1833, 54,   1643, 3348, 3568, 1709, 3393,
+    6197, 3613, 3788, 3833, 1775, 3429, 6233, 3649, 6353, 6681, 3869, 4008,
+    4053, 4089, 1841, 2507, 4211, 2628, 4220, 4265, 2738, 4228, 4273, 4309,
+    2837, 1880, 1890, 1899, 1907, 66,   1650, 3355, 3575, 1716, 3400, 6204,
+    3620, 3795, 3840, 1782, 3436, 6240, 3656, 6360, 6688, 3876, 4015, 4060,
+    4096, 1848, 3464, 6268, 3684, 6388, 6716, 3904, 6472, 6800, 7009, 4124,
+    4235, 4280, 4316, 4344, 1914, 2518, 4431, 2639, 4440, 4485, 2749, 4448,
+    4493, 4529, 2848, 4455, 4500, 4536, 4564, 2936, 1946, 1956, 1965, 1973,
+    1980, 78,   1656, 3361, 3581, 1722, 3406, 6210, 3626, 3801, 3846, 1788,
+    3442, 6246, 3662, 6366, 6694, 3882, 4021, 4066, 4102, 1854, 3470, 6274,
+    3690, 6394, 6722, 3910, 6478, 6806, 7015, 4130, 4241, 4286, 4322, 4350,
+    1920, 3491, 6295, 3711, 6415, 6743, 3931, 6499, 6827, 7036, 4151, 6555,
+    6883, 7092, 7217, 4371, 4461, 4506, 4542, 4570, 4591, 1986, 2529, 4651,
+    2650, 4660, 4705, 2760, 4668, 4713, 4749, 2859, 4675, 4720, 4756, 4784,
+    2947, 4681, 4726, 4762, 4790, 4811, 3024, 2012, 2022, 2031, 2039, 2046,
+    2052, 90,   1661, 3366, 3586, 1727, 3411, 6215, 3631, 3806, 3851, 1793,
+    3447, 6251, 3667, 6371, 6699, 3887, 4026, 4071, 4107, 1859, 3475, 6279,
+    3695, 6399, 6727, 3915, 6483, 6811, 7020, 4135, 4246, 4291, 4327, 4355,
+    1925, 3496, 6300, 3716, 6420, 6748, 3936, 6504, 6832, 7041, 4156, 6560,
+    6888, 7097, 7222, 4376, 4466, 4511, 4547, 4575, 4596, 1991, 3511, 6315,
+    3731, 6435, 6763, 3951, 6519, 6847, 7056, 4171, 6575, 6903, 7112, 7237,
+    4391, 6610, 6938, 7147, 7272, 1604, 4611, 4686, 4731, 4767, 4795, 4816,
+    4831, 2057, 2540, 4871, 2661, 4880, 4925, 2771, 4888, 4933, 4969, 2870,
+    4895, 4940, 4976, 5004, 2958, 4901, 4946, 4982, 5010, 5031, 3035, 4906,
+    4951, 4987, 5015, 5036, 5051, 3101, 2078, 2088, 2097, 2105, 2112, 2118,
+    2123, 102,  174,  2545, 2666, 186,  2546, 5086, 2667, 2776, 2777, 198,
+    2547, 5087, 2668, 5096, 5141, 2778, 2875, 2876, 2877, 210,  2548, 5088,
+    2669, 5097, 5142, 2779, 5105, 5150, 5186, 2878, 2963, 2964, 2965, 2966,
+    222,  2549, 5089, 2670, 5098, 5143, 2780, 5106, 5151, 5187, 2879, 5113,
+    5158, 5194, 5222, 2967, 3040, 3041, 3042, 3043, 3044, 234,  2550, 5090,
+    2671, 5099, 5144, 2781, 5107, 5152, 5188, 2880, 5114, 5159, 5195, 5223,
+    2968, 5120, 5165, 5201, 5229, 5250, 3045, 3106, 3107, 3108, 3109, 3110,
+    3111, 246,  2551, 5091, 2672, 5100, 5145, 2782, 5108, 5153, 5189, 2881,
+    5115, 5160, 5196, 5224, 2969, 5121, 5166, 5202, 5230, 5251, 3046, 5126,
+    5171, 5207, 5235, 5256, 5271, 3112, 3161, 3162, 3163, 3164, 3165, 3166,
+    3167, 258,  263,  2138, 264,  2139, 2149, 265,  2140, 2150, 2159, 266,
+    2141, 2151, 2160, 2168, 267,  2142, 2152, 2161, 2169, 2176, 268,  2143,
+    2153, 2162, 2170, 2177, 2183, 269,  2144, 2154, 2163, 2171, 2178, 2184,
+    2189, 270,  107,  108,  109,  110,  111,  112,  113,  114,  19,   1617,
+    2475, 1683, 31,   1627, 3332, 3552, 1693, 2486, 3772, 2607, 1749, 1759,
+    43,   1636, 3341, 3561, 1702, 3386, 6190, 3606, 3781, 3826, 1768, 2497,
+    3992, 2618, 4001, 4046, 2728, 1815, 1825, 1834, 55,   1644, 3349, 3569,
+    1710, 3394, 6198, 3614, 3789, 3834, 1776, 3430, 6234, 3650, 6354, 6682,
+    3870, 4009, 4054, 4090, 1842, 2508, 4212, 2629, 4221, 4266, 2739, 4229,
+    4274, 4310, 2838, 1881, 1891, 1900, 1908, 67,   1651, 3356, 3576, 1717,
+    3401, 6205, 3621, 3796, 3841, 1783, 3437, 6241, 3657, 6361, 6689, 3877,
+    4016, 4061, 4097, 1849, 3465, 6269, 3685, 6389, 6717, 3905, 6473, 6801,
+    7010, 4125, 4236, 4281, 4317, 4345, 1915, 2519, 4432, 2640, 4441, 4486,
+    2750, 4449, 4494, 4530, 2849, 4456, 4501, 4537, 4565, 2937, 1947, 1957,
+    1966, 1974, 1981, 79,   1657, 3362, 3582, 1723, 3407, 6211, 3627, 3802,
+    3847, 1789, 3443, 6247, 3663, 6367, 6695, 3883, 4022, 4067, 4103, 1855,
+    3471, 6275, 3691, 6395, 6723, 3911, 6479, 6807, 7016, 4131, 4242, 4287,
+    4323, 4351, 1921, 3492, 6296, 3712, 6416, 6744, 3932, 6500, 6828, 7037,
+    4152, 6556, 6884, 7093, 7218, 4372, 4462, 4507, 4543, 4571, 4592, 1987,
+    2530, 4652, 2651, 4661, 4706, 2761, 4669, 4714, 4750, 2860, 4676, 4721,
+    4757, 4785, 2948, 4682, 4727, 4763, 4791, 4812, 3025, 2013, 2023, 2032,
+    2040, 2047, 2053, 91,   1662, 3367, 3587, 1728, 3412, 6216, 3632, 3807,
+    3852, 1794, 3448, 6252, 3668, 6372, 6700, 3888, 4027, 4072, 4108, 1860,
+    3476, 6280, 3696, 6400, 6728, 3916, 6484, 6812, 7021, 4136, 4247, 4292,
+    4328, 4356, 1926, 3497, 6301, 3717, 6421, 6749, 3937, 6505, 6833, 7042,
+    4157, 6561, 6889, 7098, 7223, 4377, 4467, 4512, 4548, 4576, 4597, 1992,
+    3512, 6316, 3732, 6436, 6764, 3952, 6520, 6848, 7057, 4172, 6576, 6904,
+    7113, 7238, 4392, 6611, 6939, 7148, 7273, 7342, 4612, 4687, 4732, 4768,
+    4796, 4817, 4832, 2058, 2541, 4872, 2662, 4881, 4926, 2772, 4889, 4934,
+    4970, 2871, 4896, 4941, 4977, 5005, 2959, 4902, 4947, 4983, 5011, 5032,
+    3036, 4907, 4952, 4988, 5016, 5037, 5052, 3102, 2079, 2089, 2098, 2106,
+    2113, 2119, 2124, 103,  1666, 3371, 3591, 1732, 3416, 6220, 3636, 3811,
+    3856, 1798, 3452, 6256, 3672, 6376, 6704, 3892, 4031, 4076, 4112, 1864,
+    3480, 6284, 3700, 6404, 6732, 3920, 6488, 6816, 7025, 4140, 4251, 4296,
+    4332, 4360, 1930, 3501, 6305, 3721, 6425, 6753, 3941, 6509, 6837, 7046,
+    4161, 6565, 6893, 7102, 7227, 4381, 4471, 4516, 4552, 4580, 4601, 1996,
+    3516, 6320, 3736, 6440, 6768, 3956, 6524, 6852, 7061, 4176, 6580, 6908,
+    7117, 7242, 4396, 6615, 6943, 7152, 7277, 7346, 4616, 4691, 4736, 4772,
+    4800, 4821, 4836, 2062, 3526, 6330, 3746, 6450, 6778, 3966, 6534, 6862,
+    7071, 4186, 6590, 6918, 7127, 7252, 4406, 6625, 6953, 7162, 7287, 7356,
+    4626, 6645, 6973, 7182, 7307, 7376, 1605, 4846, 4911, 4956, 4992, 5020,
+    5041, 5056, 5066, 2128, 2552, 5092, 2673, 5101, 5146, 2783, 5109, 5154,
+    5190, 2882, 5116, 5161, 5197, 5225, 2970, 5122, 5167, 5203, 5231, 5252,
+    3047, 5127, 5172, 5208, 5236, 5257, 5272, 3113, 5131, 5176, 5212, 5240,
+    5261, 5276, 5286, 3168, 2145, 2155, 2164, 2172, 2179, 2185, 2190, 2194,
+    115,  175,  2556, 2677, 187,  2557, 5306, 2678, 2787, 2788, 199,  2558,
+    5307, 2679, 5316, 5361, 2789, 2886, 2887, 2888, 211,  2559, 5308, 2680,
+    5317, 5362, 2790, 5325, 5370, 5406, 2889, 2974, 2975, 2976, 2977, 223,
+    2560, 5309, 2681, 5318, 5363, 2791, 5326, 5371, 5407, 2890, 5333, 5378,
+    5414, 5442, 2978, 3051, 3052, 3053, 3054, 3055, 235,  2561, 5310, 2682,
+    5319, 5364, 2792, 5327, 5372, 5408, 2891, 5334, 5379, 5415, 5443, 2979,
+    5340, 5385, 5421, 5449, 5470, 3056, 3117, 3118, 3119, 3120, 3121, 3122,
+    247,  2562, 5311, 2683, 5320, 5365, 2793, 5328, 5373, 5409, 2892, 5335,
+    5380, 5416, 5444, 2980, 5341, 5386, 5422, 5450, 5471, 3057, 5346, 5391,
+    5427, 5455, 5476, 5491, 3123, 3172, 3173, 3174, 3175, 3176, 3177, 3178,
+    259,  2563, 5312, 2684, 5321, 5366, 2794, 5329, 5374, 5410, 2893, 5336,
+    5381, 5417, 5445, 2981, 5342, 5387, 5423, 5451, 5472, 3058, 5347, 5392,
+    5428, 5456, 5477, 5492, 3124, 5351, 5396, 5432, 5460, 5481, 5496, 5506,
+    3179, 3216, 3217, 3218, 3219, 3220, 3221, 3222, 3223, 271,  275,  2204,
+    276,  2205, 2215, 277,  2206, 2216, 2225, 278,  2207, 2217, 2226, 2234,
+    279,  2208, 2218, 2227, 2235, 2242, 280,  2209, 2219, 2228, 2236, 2243,
+    2249, 281,  2210, 2220, 2229, 2237, 2244, 2250, 2255, 282,  2211, 2221,
+    2230, 2238, 2245, 2251, 2256, 2260, 283,  119,  120,  121,  122,  123,
+    124,  125,  126,  127,  20,   1618, 2476, 1684, 32,   1628, 3333, 3553,
+    1694, 2487, 3773, 2608, 1750, 1760, 44,   1637, 3342, 3562, 1703, 3387,
+    6191, 3607, 3782, 3827, 1769, 2498, 3993, 2619, 4002, 4047, 2729, 1816,
+    1826, 1835, 56,   1645, 3350, 3570, 1711, 3395, 6199, 3615, 3790, 3835,
+    1777, 3431, 6235, 3651, 6355, 6683, 3871, 4010, 4055, 4091, 1843, 2509,
+    4213, 2630, 4222, 4267, 2740, 4230, 4275, 4311, 2839, 1882, 1892, 1901,
+    1909, 68,   1652, 3357, 3577, 1718, 3402, 6206, 3622, 3797, 3842, 1784,
+    3438, 6242, 3658, 6362, 6690, 3878, 4017, 4062, 4098, 1850, 3466, 6270,
+    3686, 6390, 6718, 3906, 6474, 6802, 7011, 4126, 4237, 4282, 4318, 4346,
+    1916, 2520, 4433, 2641, 4442, 4487, 2751, 4450, 4495, 4531, 2850, 4457,
+    4502, 4538, 4566, 2938, 1948, 1958, 1967, 1975, 1982, 80,   1658, 3363,
+    3583, 1724, 3408, 6212, 3628, 3803, 3848, 1790, 3444, 6248, 3664, 6368,
+    6696, 3884, 4023, 4068, 4104, 1856, 3472, 6276, 3692, 6396, 6724, 3912,
+    6480, 6808, 7017, 4132, 4243, 4288, 4324, 4352, 1922, 3493, 6297, 3713,
+    6417, 6745, 3933, 6501, 6829, 7038, 4153, 6557, 6885, 7094, 7219, 4373,
+    4463, 4508, 4544, 4572, 4593, 1988, 2531, 4653, 2652, 4662, 4707, 2762,
+    4670, 4715, 4751, 2861, 4677, 4722, 4758, 4786, 2949, 4683, 4728, 4764,
+    4792, 4813, 3026, 2014, 2024, 2033, 2041, 2048, 2054, 92,   1663, 3368,
+    3588, 1729, 3413, 6217, 3633, 3808, 3853, 1795, 3449, 6253, 3669, 6373,
+    6701, 3889, 4028, 4073, 4109, 1861, 3477, 6281, 3697, 6401, 6729, 3917,
+    6485, 6813, 7022, 4137, 4248, 4293, 4329, 4357, 1927, 3498, 6302, 3718,
+    6422, 6750, 3938, 6506, 6834, 7043, 4158, 6562, 6890, 7099, 7224, 4378,
+    4468, 4513, 4549, 4577, 4598, 1993, 3513, 6317, 3733, 6437, 6765, 3953,
+    6521, 6849, 7058, 4173, 6577, 6905, 7114, 7239, 4393, 6612, 6940, 7149,
+    7274, 7343, 4613, 4688, 4733, 4769, 4797, 4818, 4833, 2059, 2542, 4873,
+    2663, 4882, 4927, 2773, 4890, 4935, 4971, 2872, 4897, 4942, 4978, 5006,
+    2960, 4903, 4948, 4984, 5012, 5033, 3037, 4908, 4953, 4989, 5017, 5038,
+    5053, 3103, 2080, 2090, 2099, 2107, 2114, 2120, 2125, 104,  1667, 3372,
+    3592, 1733, 3417, 6221, 3637, 3812, 3857, 1799, 3453, 6257, 3673, 6377,
+    6705, 3893, 4032, 4077, 4113, 1865, 3481, 6285, 3701, 6405, 6733, 3921,
+    6489, 6817, 7026, 4141, 4252, 4297, 4333, 4361, 1931, 3502, 6306, 3722,
+    6426, 6754, 3942, 6510, 6838, 7047, 4162, 6566, 6894, 7103, 7228, 4382,
+    4472, 4517, 4553, 4581, 4602, 1997, 3517, 6321, 3737, 6441, 6769, 3957,
+    6525, 6853, 7062, 4177, 6581, 6909, 7118, 7243, 4397, 6616, 6944, 7153,
+    7278, 7347, 4617, 4692, 4737, 4773, 4801, 4822, 4837, 2063, 3527, 6331,
+    3747, 6451, 6779, 3967, 6535, 6863, 7072, 4187, 6591, 6919, 7128, 7253,
+    4407, 6626, 6954, 7163, 7288, 7357, 4627, 6646, 6974, 7183, 7308, 7377,
+    7411, 4847, 4912, 4957, 4993, 5021, 5042, 5057, 5067, 2129, 2553, 5093,
+    2674, 5102, 5147, 2784, 5110, 5155, 5191, 2883, 5117, 5162, 5198, 5226,
+    2971, 5123, 5168, 5204, 5232, 5253, 3048, 5128, 5173, 5209, 5237, 5258,
+    5273, 3114, 5132, 5177, 5213, 5241, 5262, 5277, 5287, 3169, 2146, 2156,
+    2165, 2173, 2180, 2186, 2191, 2195, 116,  1670, 3375, 3595, 1736, 3420,
+    6224, 3640, 3815, 3860, 1802, 3456, 6260, 3676, 6380, 6708, 3896, 4035,
+    4080, 4116, 1868, 3484, 6288, 3704, 6408, 6736, 3924, 6492, 6820, 7029,
+    4144, 4255, 4300, 4336, 4364, 1934, 3505, 6309, 3725, 6429, 6757, 3945,
+    6513, 6841, 7050, 4165, 6569, 6897, 7106, 7231, 4385, 4475, 4520, 4556,
+    4584, 4605, 2000, 3520, 6324, 3740, 6444, 6772, 3960, 6528, 6856, 7065,
+    4180, 6584, 6912, 7121, 7246, 4400, 6619, 6947, 7156, 7281, 7350, 4620,
+    4695, 4740, 4776, 4804, 4825, 4840, 2066, 3530, 6334, 3750, 6454, 6782,
+    3970, 6538, 6866, 7075, 4190, 6594, 6922, 7131, 7256, 4410, 6629, 6957,
+    7166, 7291, 7360, 4630, 6649, 6977, 7186, 7311, 7380, 7414, 4850, 4915,
+    4960, 4996, 5024, 5045, 5060, 5070, 2132, 3536, 6340, 3756, 6460, 6788,
+    3976, 6544, 6872, 7081, 4196, 6600, 6928, 7137, 7262, 4416, 6635, 6963,
+    7172, 7297, 7366, 4636, 6655, 6983, 7192, 7317, 7386, 7420, 4856, 6665,
+    6993, 7202, 7327, 7396, 7430, 1606, 5076, 5135, 5180, 5216, 5244, 5265,
+    5280, 5290, 5296, 2198, 2564, 5313, 2685, 5322, 5367, 2795, 5330, 5375,
+    5411, 2894, 5337, 5382, 5418, 5446, 2982, 5343, 5388, 5424, 5452, 5473,
+    3059, 5348, 5393, 5429, 5457, 5478, 5493, 3125, 5352, 5397, 5433, 5461,
+    5482, 5497, 5507, 3180, 5355, 5400, 5436, 5464, 5485, 5500, 5510, 5516,
+    3224, 2212, 2222, 2231, 2239, 2246, 2252, 2257, 2261, 2264, 128,  176,
+    2567, 2688, 188,  2568, 5526, 2689, 2798, 2799, 200,  2569, 5527, 2690,
+    5536, 5581, 2800, 2897, 2898, 2899, 212,  2570, 5528, 2691, 5537, 5582,
+    2801, 5545, 5590, 5626, 2900, 2985, 2986, 2987, 2988, 224,  2571, 5529,
+    2692, 5538, 5583, 2802, 5546, 5591, 5627, 2901, 5553, 5598, 5634, 5662,
+    2989, 3062, 3063, 3064, 3065, 3066, 236,  2572, 5530, 2693, 5539, 5584,
+    2803, 5547, 5592, 5628, 2902, 5554, 5599, 5635, 5663, 2990, 5560, 5605,
+    5641, 5669, 5690, 3067, 3128, 3129, 3130, 3131, 3132, 3133, 248,  2573,
+    5531, 2694, 5540, 5585, 2804, 5548, 5593, 5629, 2903, 5555, 5600, 5636,
+    5664, 2991, 5561, 5606, 5642, 5670, 5691, 3068, 5566, 5611, 5647, 5675,
+    5696, 5711, 3134, 3183, 3184, 3185, 3186, 3187, 3188, 3189, 260,  2574,
+    5532, 2695, 5541, 5586, 2805, 5549, 5594, 5630, 2904, 5556, 5601, 5637,
+    5665, 2992, 5562, 5607, 5643, 5671, 5692, 3069, 5567, 5612, 5648, 5676,
+    5697, 5712, 3135, 5571, 5616, 5652, 5680, 5701, 5716, 5726, 3190, 3227,
+    3228, 3229, 3230, 3231, 3232, 3233, 3234, 272,  2575, 5533, 2696, 5542,
+    5587, 2806, 5550, 5595, 5631, 2905, 5557, 5602, 5638, 5666, 2993, 5563,
+    5608, 5644, 5672, 5693, 3070, 5568, 5613, 5649, 5677, 5698, 5713, 3136,
+    5572, 5617, 5653, 5681, 5702, 5717, 5727, 3191, 5575, 5620, 5656, 5684,
+    5705, 5720, 5730, 5736, 3235, 3260, 3261, 3262, 3263, 3264, 3265, 3266,
+    3267, 3268, 284,  287,  2270, 288,  2271, 2281, 289,  2272, 2282, 2291,
+    290,  2273, 2283, 2292, 2300, 291,  2274, 2284, 2293, 2301, 2308, 292,
+    2275, 2285, 2294, 2302, 2309, 2315, 293,  2276, 2286, 2295, 2303, 2310,
+    2316, 2321, 294,  2277, 2287, 2296, 2304, 2311, 2317, 2322, 2326, 295,
+    2278, 2288, 2297, 2305, 2312, 2318, 2323, 2327, 2330, 296,  131,  132,
+    133,  134,  135,  136,  137,  138,  139,  140,  21,   1619, 2477, 1685,
+    33,   1629, 3334, 3554, 1695, 2488, 3774, 2609, 1751, 1761, 45,   1638,
+    3343, 3563, 1704, 3388, 6192, 3608, 3783, 3828, 1770, 2499, 3994, 2620,
+    4003, 4048, 2730, 1817, 1827, 1836, 57,   1646, 3351, 3571, 1712, 3396,
+    6200, 3616, 3791, 3836, 1778, 3432, 6236, 3652, 6356, 6684, 3872, 4011,
+    4056, 4092, 1844, 2510, 4214, 2631, 4223, 4268, 2741, 4231, 4276, 4312,
+    2840, 1883, 1893, 1902, 1910, 69,   1653, 3358, 3578, 1719, 3403, 6207,
+    3623, 3798, 3843, 1785, 3439, 6243, 3659, 6363, 6691, 3879, 4018, 4063,
+    4099, 1851, 3467, 6271, 3687, 6391, 6719, 3907, 6475, 6803, 7012, 4127,
+    4238, 4283, 4319, 4347, 1917, 2521, 4434, 2642, 4443, 4488, 2752, 4451,
+    4496, 4532, 2851, 4458, 4503, 4539, 4567, 2939, 1949, 1959, 1968, 1976,
+    1983, 81,   1659, 3364, 3584, 1725, 3409, 6213, 3629, 3804, 3849, 1791,
+    3445, 6249, 3665, 6369, 6697, 3885, 4024, 4069, 4105, 1857, 3473, 6277,
+    3693, 6397, 6725, 3913, 6481, 6809, 7018, 4133, 4244, 4289, 4325, 4353,
+    1923, 3494, 6298, 3714, 6418, 6746, 3934, 6502, 6830, 7039, 4154, 6558,
+    6886, 7095, 7220, 4374, 4464, 4509, 4545, 4573, 4594, 1989, 2532, 4654,
+    2653, 4663, 4708, 2763, 4671, 4716, 4752, 2862, 4678, 4723, 4759, 4787,
+    2950, 4684, 4729, 4765, 4793, 4814, 3027, 2015, 2025, 2034, 2042, 2049,
+    2055, 93,   1664, 3369, 3589, 1730, 3414, 6218, 3634, 3809, 3854, 1796,
+    3450, 6254, 3670, 6374, 6702, 3890, 4029, 4074, 4110, 1862, 3478, 6282,
+    3698, 6402, 6730, 3918, 6486, 6814, 7023, 4138, 4249, 4294, 4330, 4358,
+    1928, 3499, 6303, 3719, 6423, 6751, 3939, 6507, 6835, 7044, 4159, 6563,
+    6891, 7100, 7225, 4379, 4469, 4514, 4550, 4578, 4599, 1994, 3514, 6318,
+    3734, 6438, 6766, 3954, 6522, 6850, 7059, 4174, 6578, 6906, 7115, 7240,
+    4394, 6613, 6941, 7150, 7275, 7344, 4614, 4689, 4734, 4770, 4798, 4819,
+    4834, 2060, 2543, 4874, 2664, 4883, 4928, 2774, 4891, 4936, 4972, 2873,
+    4898, 4943, 4979, 5007, 2961, 4904, 4949, 4985, 5013, 5034, 3038, 4909,
+    4954, 4990, 5018, 5039, 5054, 3104, 2081, 2091, 2100, 2108, 2115, 2121,
+    2126, 105,  1668, 3373, 3593, 1734, 3418, 6222, 3638, 3813, 3858, 1800,
+    3454, 6258, 3674, 6378, 6706, 3894, 4033, 4078, 4114, 1866, 3482, 6286,
+    3702, 6406, 6734, 3922, 6490, 6818, 7027, 4142, 4253, 4298, 4334, 4362,
+    1932, 3503, 6307, 3723, 6427, 6755, 3943, 6511, 6839, 7048, 4163, 6567,
+    6895, 7104, 7229, 4383, 4473, 4518, 4554, 4582, 4603, 1998, 3518, 6322,
+    3738, 6442, 6770, 3958, 6526, 6854, 7063, 4178, 6582, 6910, 7119, 7244,
+    4398, 6617, 6945, 7154, 7279, 7348, 4618, 4693, 4738, 4774, 4802, 4823,
+    4838, 2064, 3528, 6332, 3748, 6452, 6780, 3968, 6536, 6864, 7073, 4188,
+    6592, 6920, 7129, 7254, 4408, 6627, 6955, 7164, 7289, 7358, 4628, 6647,
+    6975, 7184, 7309, 7378, 7412, 4848, 4913, 4958, 4994, 5022, 5043, 5058,
+    5068, 2130, 2554, 5094, 2675, 5103, 5148, 2785, 5111, 5156, 5192, 2884,
+    5118, 5163, 5199, 5227, 2972, 5124, 5169, 5205, 5233, 5254, 3049, 5129,
+    5174, 5210, 5238, 5259, 5274, 3115, 5133, 5178, 5214, 5242, 5263, 5278,
+    5288, 3170, 2147, 2157, 2166, 2174, 2181, 2187, 2192, 2196, 117,  1671,
+    3376, 3596, 1737, 3421, 6225, 3641, 3816, 3861, 1803, 3457, 6261, 3677,
+    6381, 6709, 3897, 4036, 4081, 4117, 1869, 3485, 6289, 3705, 6409, 6737,
+    3925, 6493, 6821, 7030, 4145, 4256, 4301, 4337, 4365, 1935, 3506, 6310,
+    3726, 6430, 6758, 3946, 6514, 6842, 7051, 4166, 6570, 6898, 7107, 7232,
+    4386, 4476, 4521, 4557, 4585, 4606, 2001, 3521, 6325, 3741, 6445, 6773,
+    3961, 6529, 6857, 7066, 4181, 6585, 6913, 7122, 7247, 4401, 6620, 6948,
+    7157, 7282, 7351, 4621, 4696, 4741, 4777, 4805, 4826, 4841, 2067, 3531,
+    6335, 3751, 6455, 6783, 3971, 6539, 6867, 7076, 4191, 6595, 6923, 7132,
+    7257, 4411, 6630, 6958, 7167, 7292, 7361, 4631, 6650, 6978, 7187, 7312,
+    7381, 7415, 4851, 4916, 4961, 4997, 5025, 5046, 5061, 5071, 2133, 3537,
+    6341, 3757, 6461, 6789, 3977, 6545, 6873, 7082, 4197, 6601, 6929, 7138,
+    7263, 4417, 6636, 6964, 7173, 7298, 7367, 4637, 6656, 6984, 7193, 7318,
+    7387, 7421, 4857, 6666, 6994, 7203, 7328, 7397, 7431, 7445, 5077, 5136,
+    5181, 5217, 5245, 5266, 5281, 5291, 5297, 2199, 2565, 5314, 2686, 5323,
+    5368, 2796, 5331, 5376, 5412, 2895, 5338, 5383, 5419, 5447, 2983, 5344,
+    5389, 5425, 5453, 5474, 3060, 5349, 5394, 5430, 5458, 5479, 5494, 3126,
+    5353, 5398, 5434, 5462, 5483, 5498, 5508, 3181, 5356, 5401, 5437, 5465,
+    5486, 5501, 5511, 5517, 3225, 2213, 2223, 2232, 2240, 2247, 2253, 2258,
+    2262, 2265, 129,  1673, 3378, 3598, 1739, 3423, 6227, 3643, 3818, 3863,
+    1805, 3459, 6263, 3679, 6383, 6711, 3899, 4038, 4083, 4119, 1871, 3487,
+    6291, 3707, 6411, 6739, 3927, 6495, 6823, 7032, 4147, 4258, 4303, 4339,
+    4367, 1937, 3508, 6312, 3728, 6432, 6760, 3948, 6516, 6844, 7053, 4168,
+    6572, 6900, 7109, 7234, 4388, 4478, 4523, 4559, 4587, 4608, 2003, 3523,
+    6327, 3743, 6447, 6775, 3963, 6531, 6859, 7068, 4183, 6587, 6915, 7124,
+    7249, 4403, 6622, 6950, 7159, 7284, 7353, 4623, 4698, 4743, 4779, 4807,
+    4828, 4843, 2069, 3533, 6337, 3753, 6457, 6785, 3973, 6541, 6869, 7078,
+    4193, 6597, 6925, 7134, 7259, 4413, 6632, 6960, 7169, 7294, 7363, 4633,
+    6652, 6980, 7189, 7314, 7383, 7417, 4853, 4918, 4963, 4999, 5027, 5048,
+    5063, 5073, 2135, 3539, 6343, 3759, 6463, 6791, 3979, 6547, 6875, 7084,
+    4199, 6603, 6931, 7140, 7265, 4419, 6638, 6966, 7175, 7300, 7369, 4639,
+    6658, 6986, 7195, 7320, 7389, 7423, 4859, 6668, 6996, 7205, 7330, 7399,
+    7433, 7447, 5079, 5138, 5183, 5219, 5247, 5268, 5283, 5293, 5299, 2201,
+    1609, 1609, 3762, 1609, 6794, 3982, 1609, 6878, 7087, 4202, 1609, 6934,
+    7143, 7268, 4422, 1609, 6969, 7178, 7303, 7372, 4642, 1609, 6989, 7198,
+    7323, 7392, 7426, 4862, 1609, 6999, 7208, 7333, 7402, 7436, 7450, 5082,
+    1608, 1608, 1608, 1608, 1608, 1608, 1608, 1607, 1608, 1609, 5403, 5439,
+    5467, 5488, 5503, 5513, 5519, 1608, 2267, 2576, 5534, 2697, 5543, 5588,
+    2807, 5551, 5596, 5632, 2906, 5558, 5603, 5639, 5667, 2994, 5564, 5609,
+    5645, 5673, 5694, 3071, 5569, 5614, 5650, 5678, 5699, 5714, 3137, 5573,
+    5618, 5654, 5682, 5703, 5718, 5728, 3192, 5576, 5621, 5657, 5685, 5706,
+    5721, 5731, 5737, 3236, 1609, 5623, 5659, 5687, 5708, 5723, 5733, 5739,
+    1608, 3269, 2279, 2289, 2298, 2306, 2313, 2319, 2324, 2328, 2331, 2333,
+    141,  177,  2578, 2699, 189,  2579, 5746, 2700, 2809, 2810, 201,  2580,
+    5747, 2701, 5756, 5801, 2811, 2908, 2909, 2910, 213,  2581, 5748, 2702,
+    5757, 5802, 2812, 5765, 5810, 5846, 2911, 2996, 2997, 2998, 2999, 225,
+    2582, 5749, 2703, 5758, 5803, 2813, 5766, 5811, 5847, 2912, 5773, 5818,
+    5854, 5882, 3000, 3073, 3074, 3075, 3076, 3077, 237,  2583, 5750, 2704,
+    5759, 5804, 2814, 5767, 5812, 5848, 2913, 5774, 5819, 5855, 5883, 3001,
+    5780, 5825, 5861, 5889, 5910, 3078, 3139, 3140, 3141, 3142, 3143, 3144,
+    249,  2584, 5751, 2705, 5760, 5805, 2815, 5768, 5813, 5849, 2914, 5775,
+    5820, 5856, 5884, 3002, 5781, 5826, 5862, 5890, 5911, 3079, 5786, 5831,
+    5867, 5895, 5916, 5931, 3145, 3194, 3195, 3196, 3197, 3198, 3199, 3200,
+    261,  2585, 5752, 2706, 5761, 5806, 2816, 5769, 5814, 5850, 2915, 5776,
+    5821, 5857, 5885, 3003, 5782, 5827, 5863, 5891, 5912, 3080, 5787, 5832,
+    5868, 5896, 5917, 5932, 3146, 5791, 5836, 5872, 5900, 5921, 5936, 5946,
+    3201, 3238, 3239, 3240, 3241, 3242, 3243, 3244, 3245, 273,  2586, 5753,
+    2707, 5762, 5807, 2817, 5770, 5815, 5851, 2916, 5777, 5822, 5858, 5886,
+    3004, 5783, 5828, 5864, 5892, 5913, 3081, 5788, 5833, 5869, 5897, 5918,
+    5933, 3147, 5792, 5837, 5873, 5901, 5922, 5937, 5947, 3202, 5795, 5840,
+    5876, 5904, 5925, 5940, 5950, 5956, 3246, 3271, 3272, 3273, 3274, 3275,
+    3276, 3277, 3278, 3279, 285,  2587, 5754, 2708, 5763, 5808, 2818, 5771,
+    5816, 5852, 2917, 5778, 5823, 5859, 5887, 3005, 5784, 5829, 5865, 5893,
+    5914, 3082, 5789, 5834, 5870, 5898, 5919, 5934, 3148, 5793, 5838, 5874,
+    5902, 5923, 5938, 5948, 3203, 5796, 5841, 5877, 5905, 5926, 5941, 5951,
+    5957, 3247, 1609, 5843, 5879, 5907, 5928, 5943, 5953, 5959, 1608, 3280,
+    3293, 3294, 3295, 3296, 3297, 3298, 3299, 3300, 3301, 3302, 297,  299,
+    2336, 300,  2337, 2347, 301,  2338, 2348, 2357, 302,  2339, 2349, 2358,
+    2366, 303,  2340, 2350, 2359, 2367, 2374, 304,  2341, 2351, 2360, 2368,
+    2375, 2381, 305,  2342, 2352, 2361, 2369, 2376, 2382, 2387, 306,  2343,
+    2353, 2362, 2370, 2377, 2383, 2388, 2392, 307,  2344, 2354, 2363, 2371,
+    2378, 2384, 2389, 2393, 2396, 308,  2345, 2355, 2364, 2372, 2379, 2385,
+    2390, 2394, 2397, 2399, 309,  143,  144,  145,  146,  147,  148,  149,
+    150,  151,  152,  153,  22,   178,  2478, 190,  34,   178,  2589, 2710,
+    190,  2489, 2820, 2610, 202,  202,  46,   178,  2589, 2710, 190,  2590,
+    5966, 2711, 2820, 2821, 202,  2500, 2919, 2621, 2919, 2920, 2731, 214,
+    214,  214,  58,   178,  2589, 2710, 190,  2590, 5966, 2711, 2820, 2821,
+    202,  2591, 5967, 2712, 5976, 6021, 2822, 2919, 2920, 2921, 214,  2511,
+    3007, 2632, 3007, 3008, 2742, 3007, 3008, 3009, 2841, 226,  226,  226,
+    226,  70,   178,  2589, 2710, 190,  2590, 5966, 2711, 2820, 2821, 202,
+    2591, 5967, 2712, 5976, 6021, 2822, 2919, 2920, 2921, 214,  2592, 5968,
+    2713, 5977, 6022, 2823, 5985, 6030, 6066, 2922, 3007, 3008, 3009, 3010,
+    226,  2522, 3084, 2643, 3084, 3085, 2753, 3084, 3085, 3086, 2852, 3084,
+    3085, 3086, 3087, 2940, 238,  238,  238,  238,  238,  82,   178,  2589,
+    2710, 190,  2590, 5966, 2711, 2820, 2821, 202,  2591, 5967, 2712, 5976,
+    6021, 2822, 2919, 2920, 2921, 214,  2592, 5968, 2713, 5977, 6022, 2823,
+    5985, 6030, 6066, 2922, 3007, 3008, 3009, 3010, 226,  2593, 5969, 2714,
+    5978, 6023, 2824, 5986, 6031, 6067, 2923, 5993, 6038, 6074, 6102, 3011,
+    3084, 3085, 3086, 3087, 3088, 238,  2533, 3150, 2654, 3150, 3151, 2764,
+    3150, 3151, 3152, 2863, 3150, 3151, 3152, 3153, 2951, 3150, 3151, 3152,
+    3153, 3154, 3028, 250,  250,  250,  250,  250,  250,  94,   178,  2589,
+    2710, 190,  2590, 5966, 2711, 2820, 2821, 202,  2591, 5967, 2712, 5976,
+    6021, 2822, 2919, 2920, 2921, 214,  2592, 5968, 2713, 5977, 6022, 2823,
+    5985, 6030, 6066, 2922, 3007, 3008, 3009, 3010, 226,  2593, 5969, 2714,
+    5978, 6023, 2824, 5986, 6031, 6067, 2923, 5993, 6038, 6074, 6102, 3011,
+    3084, 3085, 3086, 3087, 3088, 238,  2594, 5970, 2715, 5979, 6024, 2825,
+    5987, 6032, 6068, 2924, 5994, 6039, 6075, 6103, 3012, 6000, 6045, 6081,
+    6109, 6130, 3089, 3150, 3151, 3152, 3153, 3154, 3155, 250,  2544, 3205,
+    2665, 3205, 3206, 2775, 3205, 3206, 3207, 2874, 3205, 3206, 3207, 3208,
+    2962, 3205, 3206, 3207, 3208, 3209, 3039, 3205, 3206, 3207, 3208, 3209,
+    3210, 3105, 262,  262,  262,  262,  262,  262,  262,  106,  178,  2589,
+    2710, 190,  2590, 5966, 2711, 2820, 2821, 202,  2591, 5967, 2712, 5976,
+    6021, 2822, 2919, 2920, 2921, 214,  2592, 5968, 2713, 5977, 6022, 2823,
+    5985, 6030, 6066, 2922, 3007, 3008, 3009, 3010, 226,  2593, 5969, 2714,
+    5978, 6023, 2824, 5986, 6031, 6067, 2923, 5993, 6038, 6074, 6102, 3011,
+    3084, 3085, 3086, 3087, 3088, 238,  2594, 5970, 2715, 5979, 6024, 2825,
+    5987, 6032, 6068, 2924, 5994, 6039, 6075, 6103, 3012, 6000, 6045, 6081,
+    6109, 6130, 3089, 3150, 3151, 3152, 3153, 3154, 3155, 250,  2595, 5971,
+    2716, 5980, 6025, 2826, 5988, 6033, 6069, 2925, 5995, 6040, 6076, 6104,
+    3013, 6001, 6046, 6082, 6110, 6131, 3090, 6006, 6051, 6087, 6115, 6136,
+    6151, 3156, 3205, 3206, 3207, 3208, 3209, 3210, 3211, 262,  2555, 3249,
+    2676, 3249, 3250, 2786, 3249, 3250, 3251, 2885, 3249, 3250, 3251, 3252,
+    2973, 3249, 3250, 3251, 3252, 3253, 3050, 3249, 3250, 3251, 3252, 3253,
+    3254, 3116, 3249, 3250, 3251, 3252, 3253, 3254, 3255, 3171, 274,  274,
+    274,  274,  274,  274,  274,  274,  118,  178,  2589, 2710, 190,  2590,
+    5966, 2711, 2820, 2821, 202,  2591, 5967, 2712, 5976, 6021, 2822, 2919,
+    2920, 2921, 214,  2592, 5968, 2713, 5977, 6022, 2823, 5985, 6030, 6066,
+    2922, 3007, 3008, 3009, 3010, 226,  2593, 5969, 2714, 5978, 6023, 2824,
+    5986, 6031, 6067, 2923, 5993, 6038, 6074, 6102, 3011, 3084, 3085, 3086,
+    3087, 3088, 238,  2594, 5970, 2715, 5979, 6024, 2825, 5987, 6032, 6068,
+    2924, 5994, 6039, 6075, 6103, 3012, 6000, 6045, 6081, 6109, 6130, 3089,
+    3150, 3151, 3152, 3153, 3154, 3155, 250,  2595, 5971, 2716, 5980, 6025,
+    2826, 5988, 6033, 6069, 2925, 5995, 6040, 6076, 6104, 3013, 6001, 6046,
+    6082, 6110, 6131, 3090, 6006, 6051, 6087, 6115, 6136, 6151, 3156, 3205,
+    3206, 3207, 3208, 3209, 3210, 3211, 262,  2596, 5972, 2717, 5981, 6026,
+    2827, 5989, 6034, 6070, 2926, 5996, 6041, 6077, 6105, 3014, 6002, 6047,
+    6083, 6111, 6132, 3091, 6007, 6052, 6088, 6116, 6137, 6152, 3157, 6011,
+    6056, 6092, 6120, 6141, 6156, 6166, 3212, 3249, 3250, 3251, 3252, 3253,
+    3254, 3255, 3256, 274,  2566, 3282, 2687, 3282, 3283, 2797, 3282, 3283,
+    3284, 2896, 3282, 3283, 3284, 3285, 2984, 3282, 3283, 3284, 3285, 3286,
+    3061, 3282, 3283, 3284, 3285, 3286, 3287, 3127, 3282, 3283, 3284, 3285,
+    3286, 3287, 3288, 3182, 3282, 3283, 3284, 3285, 3286, 3287, 3288, 3289,
+    3226, 286,  286,  286,  286,  286,  286,  286,  286,  286,  130,  178,
+    2589, 2710, 190,  2590, 5966, 2711, 2820, 2821, 202,  2591, 5967, 2712,
+    5976, 6021, 2822, 2919, 2920, 2921, 214,  2592, 5968, 2713, 5977, 6022,
+    2823, 5985, 6030, 6066, 2922, 3007, 3008, 3009, 3010, 226,  2593, 5969,
+    2714, 5978, 6023, 2824, 5986, 6031, 6067, 2923, 5993, 6038, 6074, 6102,
+    3011, 3084, 3085, 3086, 3087, 3088, 238,  2594, 5970, 2715, 5979, 6024,
+    2825, 5987, 6032, 6068, 2924, 5994, 6039, 6075, 6103, 3012, 6000, 6045,
+    6081, 6109, 6130, 3089, 3150, 3151, 3152, 3153, 3154, 3155, 250,  2595,
+    5971, 2716, 5980, 6025, 2826, 5988, 6033, 6069, 2925, 5995, 6040, 6076,
+    6104, 3013, 6001, 6046, 6082, 6110, 6131, 3090, 6006, 6051, 6087, 6115,
+    6136, 6151, 3156, 3205, 3206, 3207, 3208, 3209, 3210, 3211, 262,  2596,
+    5972, 2717, 5981, 6026, 2827, 5989, 6034, 6070, 2926, 5996, 6041, 6077,
+    6105, 3014, 6002, 6047, 6083, 6111, 6132, 3091, 6007, 6052, 6088, 6116,
+    6137, 6152, 3157, 6011, 6056, 6092, 6120, 6141, 6156, 6166, 3212, 3249,
+    3250, 3251, 3252, 3253, 3254, 3255, 3256, 274,  2597, 5973, 2718, 5982,
+    6027, 2828, 5990, 6035, 6071, 2927, 5997, 6042, 6078, 6106, 3015, 6003,
+    6048, 6084, 6112, 6133, 3092, 6008, 6053, 6089, 6117, 6138, 6153, 3158,
+    6012, 6057, 6093, 6121, 6142, 6157, 6167, 3213, 6015, 6060, 6096, 6124,
+    6145, 6160, 6170, 6176, 3257, 3282, 3283, 3284, 3285, 3286, 3287, 3288,
+    3289, 3290, 286,  2577, 3304, 2698, 3304, 3305, 2808, 3304, 3305, 3306,
+    2907, 3304, 3305, 3306, 3307, 2995, 3304, 3305, 3306, 3307, 3308, 3072,
+    3304, 3305, 3306, 3307, 3308, 3309, 3138, 3304, 3305, 3306, 3307, 3308,
+    3309, 3310, 3193, 3304, 3305, 3306, 3307, 3308, 3309, 3310, 3311, 3237,
+    3304, 3305, 3306, 3307, 3308, 3309, 3310, 3311, 3312, 3270, 298,  298,
+    298,  298,  298,  298,  298,  298,  298,  298,  142,  178,  2589, 2710,
+    190,  2590, 5966, 2711, 2820, 2821, 202,  2591, 5967, 2712, 5976, 6021,
+    2822, 2919, 2920, 2921, 214,  2592, 5968, 2713, 5977, 6022, 2823, 5985,
+    6030, 6066, 2922, 3007, 3008, 3009, 3010, 226,  2593, 5969, 2714, 5978,
+    6023, 2824, 5986, 6031, 6067, 2923, 5993, 6038, 6074, 6102, 3011, 3084,
+    3085, 3086, 3087, 3088, 238,  2594, 5970, 2715, 5979, 6024, 2825, 5987,
+    6032, 6068, 2924, 5994, 6039, 6075, 6103, 3012, 6000, 6045, 6081, 6109,
+    6130, 3089, 3150, 3151, 3152, 3153, 3154, 3155, 250,  2595, 5971, 2716,
+    5980, 6025, 2826, 5988, 6033, 6069, 2925, 5995, 6040, 6076, 6104, 3013,
+    6001, 6046, 6082, 6110, 6131, 3090, 6006, 6051, 6087, 6115, 6136, 6151,
+    3156, 3205, 3206, 3207, 3208, 3209, 3210, 3211, 262,  2596, 5972, 2717,
+    5981, 6026, 2827, 5989, 6034, 6070, 2926, 5996, 6041, 6077, 6105, 3014,
+    6002, 6047, 6083, 6111, 6132, 3091, 6007, 6052, 6088, 6116, 6137, 6152,
+    3157, 6011, 6056, 6092, 6120, 6141, 6156, 6166, 3212, 3249, 3250, 3251,
+    3252, 3253, 3254, 3255, 3256, 274,  2597, 5973, 2718, 5982, 6027, 2828,
+    5990, 6035, 6071, 2927, 5997, 6042, 6078, 6106, 3015, 6003, 6048, 6084,
+    6112, 6133, 3092, 6008, 6053, 6089, 6117, 6138, 6153, 3158, 6012, 6057,
+    6093, 6121, 6142, 6157, 6167, 3213, 6015, 6060, 6096, 6124, 6145, 6160,
+    6170, 6176, 3257, 3282, 3283, 3284, 3285, 3286, 3287, 3288, 3289, 3290,
+    286,  2598, 5974, 2719, 5983, 6028, 2829, 5991, 6036, 6072, 2928, 5998,
+    6043, 6079, 6107, 3016, 6004, 6049, 6085, 6113, 6134, 3093, 6009, 6054,
+    6090, 6118, 6139, 6154, 3159, 6013, 6058, 6094, 6122, 6143, 6158, 6168,
+    3214, 6016, 6061, 6097, 6125, 6146, 6161, 6171, 6177, 3258, 1609, 6063,
+    6099, 6127, 6148, 6163, 6173, 6179, 1608, 3291, 3304, 3305, 3306, 3307,
+    3308, 3309, 3310, 3311, 3312, 3313, 298,  2588, 3315, 2709, 3315, 3316,
+    2819, 3315, 3316, 3317, 2918, 3315, 3316, 3317, 3318, 3006, 3315, 3316,
+    3317, 3318, 3319, 3083, 3315, 3316, 3317, 3318, 3319, 3320, 3149, 3315,
+    3316, 3317, 3318, 3319, 3320, 3321, 3204, 3315, 3316, 3317, 3318, 3319,
+    3320, 3321, 3322, 3248, 3315, 3316, 3317, 3318, 3319, 3320, 3321, 3322,
+    3323, 3281, 3315, 3316, 3317, 3318, 3319, 3320, 3321, 3322, 3323, 3324,
+    3303, 310,  310,  310,  310,  310,  310,  310,  310,  310,  310,  310,
+    154,  178,  311,  312,  190,  311,  2402, 312,  313,  313,  202,  311,
+    2402, 312,  2403, 2413, 313,  314,  314,  314,  214,  311,  2402, 312,
+    2403, 2413, 313,  2404, 2414, 2423, 314,  315,  315,  315,  315,  226,
+    311,  2402, 312,  2403, 2413, 313,  2404, 2414, 2423, 314,  2405, 2415,
+    2424, 2432, 315,  316,  316,  316,  316,  316,  238,  311,  2402, 312,
+    2403, 2413, 313,  2404, 2414, 2423, 314,  2405, 2415, 2424, 2432, 315,
+    2406, 2416, 2425, 2433, 2440, 316,  317,  317,  317,  317,  317,  317,
+    250,  311,  2402, 312,  2403, 2413, 313,  2404, 2414, 2423, 314,  2405,
+    2415, 2424, 2432, 315,  2406, 2416, 2425, 2433, 2440, 316,  2407, 2417,
+    2426, 2434, 2441, 2447, 317,  318,  318,  318,  318,  318,  318,  318,
+    262,  311,  2402, 312,  2403, 2413, 313,  2404, 2414, 2423, 314,  2405,
+    2415, 2424, 2432, 315,  2406, 2416, 2425, 2433, 2440, 316,  2407, 2417,
+    2426, 2434, 2441, 2447, 317,  2408, 2418, 2427, 2435, 2442, 2448, 2453,
+    318,  319,  319,  319,  319,  319,  319,  319,  319,  274,  311,  2402,
+    312,  2403, 2413, 313,  2404, 2414, 2423, 314,  2405, 2415, 2424, 2432,
+    315,  2406, 2416, 2425, 2433, 2440, 316,  2407, 2417, 2426, 2434, 2441,
+    2447, 317,  2408, 2418, 2427, 2435, 2442, 2448, 2453, 318,  2409, 2419,
+    2428, 2436, 2443, 2449, 2454, 2458, 319,  320,  320,  320,  320,  320,
+    320,  320,  320,  320,  286,  311,  2402, 312,  2403, 2413, 313,  2404,
+    2414, 2423, 314,  2405, 2415, 2424, 2432, 315,  2406, 2416, 2425, 2433,
+    2440, 316,  2407, 2417, 2426, 2434, 2441, 2447, 317,  2408, 2418, 2427,
+    2435, 2442, 2448, 2453, 318,  2409, 2419, 2428, 2436, 2443, 2449, 2454,
+    2458, 319,  2410, 2420, 2429, 2437, 2444, 2450, 2455, 2459, 2462, 320,
+    321,  321,  321,  321,  321,  321,  321,  321,  321,  321,  298,  311,
+    2402, 312,  2403, 2413, 313,  2404, 2414, 2423, 314,  2405, 2415, 2424,
+    2432, 315,  2406, 2416, 2425, 2433, 2440, 316,  2407, 2417, 2426, 2434,
+    2441, 2447, 317,  2408, 2418, 2427, 2435, 2442, 2448, 2453, 318,  2409,
+    2419, 2428, 2436, 2443, 2449, 2454, 2458, 319,  2410, 2420, 2429, 2437,
+    2444, 2450, 2455, 2459, 2462, 320,  2411, 2421, 2430, 2438, 2445, 2451,
+    2456, 2460, 2463, 2465, 321,  322,  322,  322,  322,  322,  322,  322,
+    322,  322,  322,  322,  310,  155,  155,  156,  155,  156,  157,  155,
+    156,  157,  158,  155,  156,  157,  158,  159,  155,  156,  157,  158,
+    159,  160,  155,  156,  157,  158,  159,  160,  161,  155,  156,  157,
+    158,  159,  160,  161,  162,  155,  156,  157,  158,  159,  160,  161,
+    162,  163,  155,  156,  157,  158,  159,  160,  161,  162,  163,  164,
+    155,  156,  157,  158,  159,  160,  161,  162,  163,  164,  165,  155,
+    156,  157,  158,  159,  160,  161,  162,  163,  164,  165,  166,
+};
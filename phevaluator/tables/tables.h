@@ -31,12 +31,6 @@ extern const int dp[5][14][10];
 
 extern const char* rank_description[7463][2];
 
-extern const short noflush_plo4[11238500];
-extern const short flush_plo4[4099095];
-
-extern const short flush_plo5[4368 * 4368];
-extern const short noflush_plo5[6175 * 6175];
-
-extern const short flush_plo6[8192 * 8192];
-extern const short noflush_plo6[6175 * 18395];
+// The PLO4, PLO5 and PLO6 tables are generated at runtime, see
+// src/omaha_tables.h
 #endif  // TABLES_H
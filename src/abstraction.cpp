@@ -0,0 +1,436 @@
+// abstraction.cpp
+#include "abstraction.h"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+#include "evaluator_backend.h"
+#include "helper.h"
+
+using namespace std;
+
+// {EHS board1, EHS board2, EHS^2 board1, EHS^2 board2}
+static constexpr int NUM_FEATURES = 4;
+using Features = array<double, NUM_FEATURES>;
+
+// "BAP5". Files from before hands were keyed by hand_index were "BAP4".
+static constexpr uint32_t ABSTRACTION_FILE_MAGIC = 0x35504142;
+
+// Showdown of hero against villain on a single (complete) board.
+// Returns 1.0 for a win, 0.5 for a chop and 0.0 for a loss.
+static double showdown(const int* board, const int* hero, const int* villain) {
+  const int* hands[2] = {hero, villain};
+  int ranks[2];
+  showdown_evaluator_for(2).Evaluate(board, hands, 2, ranks);
+
+  if (ranks[0] == ranks[1]) {
+    return 0.5;
+  }
+  // lower ranks are stronger.
+  return ranks[0] < ranks[1] ? 1.0 : 0.0;
+}
+
+static double squared_distance(const Features& a, const Features& b) {
+  double d = 0.0;
+  for (int i = 0; i < NUM_FEATURES; i++) {
+    d += (a[i] - b[i]) * (a[i] - b[i]);
+  }
+  return d;
+}
+
+static int nearest_centroid(const Features& point,
+                            const vector<Features>& centroids) {
+  int best = 0;
+  double best_distance = numeric_limits<double>::max();
+  for (int c = 0; c < centroids.size(); c++) {
+    double d = squared_distance(point, centroids[c]);
+    if (d < best_distance) {
+      best_distance = d;
+      best = c;
+    }
+  }
+  return best;
+}
+
+// k-means++ initialisation followed by Lloyd iterations.
+// Returns the cluster of each point.
+static vector<int> kmeans(const vector<Features>& points, int k,
+                          int iterations, mt19937& gen) {
+  k = min<int>(k, points.size());
+  vector<Features> centroids;
+  vector<int> assignment(points.size(), 0);
+  if (k == 0) {
+    return assignment;
+  }
+
+  uniform_int_distribution<int> first(0, points.size() - 1);
+  centroids.push_back(points[first(gen)]);
+
+  vector<double> min_distance(points.size(), numeric_limits<double>::max());
+  while (centroids.size() < k) {
+    double total = 0.0;
+    for (int i = 0; i < points.size(); i++) {
+      min_distance[i] =
+          min(min_distance[i], squared_distance(points[i], centroids.back()));
+      total += min_distance[i];
+    }
+
+    if (total <= 0.0) {
+      // fewer distinct points than clusters.
+      break;
+    }
+
+    uniform_real_distribution<double> dis(0.0, total);
+    double chosen = dis(gen);
+    int idx = 0;
+    for (; idx < points.size() - 1; idx++) {
+      chosen -= min_distance[idx];
+      if (chosen <= 0.0) {
+        break;
+      }
+    }
+    centroids.push_back(points[idx]);
+  }
+
+  for (int it = 0; it < iterations; it++) {
+    bool changed = false;
+    for (int i = 0; i < points.size(); i++) {
+      int c = nearest_centroid(points[i], centroids);
+      if (c != assignment[i]) {
+        assignment[i] = c;
+        changed = true;
+      }
+    }
+
+    vector<Features> sums(centroids.size(), Features{});
+    vector<int> counts(centroids.size(), 0);
+    for (int i = 0; i < points.size(); i++) {
+      for (int f = 0; f < NUM_FEATURES; f++) {
+        sums[assignment[i]][f] += points[i][f];
+      }
+      counts[assignment[i]]++;
+    }
+
+    for (int c = 0; c < centroids.size(); c++) {
+      if (counts[c] == 0) {
+        continue;  // keep the old centroid
+      }
+      for (int f = 0; f < NUM_FEATURES; f++) {
+        centroids[c][f] = sums[c][f] / (double)counts[c];
+      }
+    }
+
+    if (!changed && it > 0) {
+      break;
+    }
+  }
+
+  return assignment;
+}
+
+void HandAbstraction::Build(const vector<int>& board1,
+                            const vector<int>& board2, int num_buckets,
+                            int num_runouts, int num_opponents,
+                            int kmeans_iterations, unsigned int seed) {
+  if (board1.size() != board2.size() || board1.size() < 3 ||
+      board1.size() > 5) {
+    throw runtime_error("Boards must both have between 3 and 5 cards.");
+  }
+  if (num_buckets <= 0 || num_buckets > MAX_BUCKETS) {
+    throw runtime_error("Number of buckets must be between 1 and " +
+                        to_string(MAX_BUCKETS) + ".");
+  }
+
+  mt19937 gen(seed);
+
+  uint64_t used = 0;
+  for (int c : board1) used |= 1ull << c;
+  for (int c : board2) used |= 1ull << c;
+
+  vector<int> remaining;
+  for (int c = 0; c < 52; c++) {
+    if (!(used & (1ull << c))) {
+      remaining.push_back(c);
+    }
+  }
+
+  const int missing = 5 - board1.size();  // cards to come on each board
+  vector<int> handhashes;
+  vector<Features> features;
+
+  vector<int> scratch;
+  array<int, 5> full1;
+  array<int, 5> full2;
+  copy(board1.begin(), board1.end(), full1.begin());
+  copy(board2.begin(), board2.end(), full2.begin());
+
+  const int n = remaining.size();
+  for (int a = 0; a < n; a++) {
+    for (int b = a + 1; b < n; b++) {
+      for (int c = b + 1; c < n; c++) {
+        for (int d = c + 1; d < n; d++) {
+          array<int, 4> hand = {remaining[a], remaining[b], remaining[c],
+                                remaining[d]};
+
+          // deck without the hand
+          scratch.clear();
+          for (int card : remaining) {
+            if (card != hand[0] && card != hand[1] && card != hand[2] &&
+                card != hand[3]) {
+              scratch.push_back(card);
+            }
+          }
+
+          Features f{};
+          for (int r = 0; r < num_runouts; r++) {
+            // partial Fisher-Yates: the last 2 * missing + 4 * num_opponents
+            // cards of scratch are the sample.
+            const int needed = 2 * missing + 4 * num_opponents;
+            for (int s = 0; s < needed; s++) {
+              int last = scratch.size() - 1 - s;
+              uniform_int_distribution<int> pick(0, last);
+              swap(scratch[pick(gen)], scratch[last]);
+            }
+
+            const int* sample = scratch.data() + scratch.size() - needed;
+            for (int m = 0; m < missing; m++) {
+              full1[board1.size() + m] = sample[m];
+              full2[board2.size() + m] = sample[missing + m];
+            }
+
+            const int* villains = sample + 2 * missing;
+            double hs1 = 0.0;
+            double hs2 = 0.0;
+            for (int o = 0; o < num_opponents; o++) {
+              hs1 += showdown(full1.data(), hand.data(), villains + 4 * o);
+              hs2 += showdown(full2.data(), hand.data(), villains + 4 * o);
+            }
+            hs1 /= (double)num_opponents;
+            hs2 /= (double)num_opponents;
+
+            f[0] += hs1;
+            f[1] += hs2;
+            f[2] += hs1 * hs1;
+            f[3] += hs2 * hs2;
+          }
+
+          for (auto& x : f) {
+            x /= (double)num_runouts;
+          }
+
+          handhashes.push_back(
+              hand_index((1ull << hand[0]) | (1ull << hand[1]) |
+                         (1ull << hand[2]) | (1ull << hand[3])));
+          features.push_back(f);
+        }
+      }
+    }
+  }
+
+  vector<int> assignment =
+      kmeans(features, num_buckets, kmeans_iterations, gen);
+
+  Table table;
+  table.board1 = board1;
+  table.board2 = board2;
+  table.num_buckets = num_buckets;
+  table.buckets.assign(NUM_HANDS, NO_BUCKET);
+  for (int i = 0; i < handhashes.size(); i++) {
+    table.buckets[handhashes[i]] = assignment[i];
+  }
+
+  const pair<uint64_t, uint64_t> key = BoardKey(board1, board2);
+  tables_[key] = move(table);
+  AddImages(key, tables_[key]);
+}
+
+pair<uint64_t, uint64_t> HandAbstraction::BoardKey(const vector<int>& board1,
+                                                   const vector<int>& board2) {
+  uint64_t mask1 = 0;
+  uint64_t mask2 = 0;
+  for (int c : board1) mask1 |= 1ull << c;
+  for (int c : board2) mask2 |= 1ull << c;
+  return {mask1, mask2};
+}
+
+void HandAbstraction::AddImages(const pair<uint64_t, uint64_t>& key,
+                                const Table& table) {
+  SuitPermutation perm = {0, 1, 2, 3};
+  do {
+    vector<int> board1 = table.board1, board2 = table.board2;
+    permute_cards(board1, perm);
+    permute_cards(board2, perm);
+
+    Image image;
+    image.table = key;
+    for (int s = 0; s < 4; s++) {
+      image.to_table[perm[s]] = s;
+    }
+    image.identity = perm == SuitPermutation{0, 1, 2, 3};
+    if (image.identity) {
+      images_[key] = image;
+    } else {
+      images_.emplace(BoardKey(board1, board2), image);
+    }
+  } while (next_permutation(perm.begin(), perm.end()));
+}
+
+const HandAbstraction::Table* HandAbstraction::FindTable(
+    const vector<int>& board1, const vector<int>& board2,
+    const Image** image) const {
+  if (images_.empty()) {
+    return nullptr;
+  }
+
+  auto it = images_.find(BoardKey(board1, board2));
+  if (it == images_.end()) {
+    return nullptr;
+  }
+  if (image != nullptr) {
+    *image = &it->second;
+  }
+  return &tables_.at(it->second.table);
+}
+
+bool HandAbstraction::HasTable(const vector<int>& board1,
+                               const vector<int>& board2) const {
+  return FindTable(board1, board2) != nullptr;
+}
+
+int HandAbstraction::GetBucket(const vector<int>& board1,
+                               const vector<int>& board2, int handhash) const {
+  const Image* image;
+  const Table* table = FindTable(board1, board2, &image);
+  if (table == nullptr || handhash < 0 || handhash >= NUM_HANDS) {
+    return -1;
+  }
+  if (!image->identity) {
+    uint64_t mask = 0;
+    for (int c : hand_from_index(handhash)) {
+      mask |= 1ull << permute_card(c, image->to_table);
+    }
+    handhash = hand_index(mask);
+  }
+
+  if (table->buckets[handhash] == NO_BUCKET) {
+    return -1;
+  }
+  return table->buckets[handhash];
+}
+
+int HandAbstraction::NumBuckets(const vector<int>& board1,
+                                const vector<int>& board2) const {
+  const Table* table = FindTable(board1, board2);
+  return table == nullptr ? 0 : table->num_buckets;
+}
+
+int HandAbstraction::InfosetKey(const vector<int>& board1,
+                                const vector<int>& board2,
+                                int handhash) const {
+  int bucket = GetBucket(board1, board2, handhash);
+  if (bucket == -1) {
+    return handhash;
+  }
+  return -bucket - 1;
+}
+
+// File layout (all little endian 32 bit ints):
+// magic, number of tables, then for each table:
+// board size, board1 cards, board2 cards, num_buckets, number of entries,
+// then {hand_index, bucket} pairs.
+void HandAbstraction::Save(const string& path) const {
+  ofstream out(path, ios::binary);
+  if (!out) {
+    throw runtime_error("Failed to open " + path + " for writing.");
+  }
+
+  auto write_int = [&](int32_t x) {
+    out.write(reinterpret_cast<const char*>(&x), sizeof(x));
+  };
+
+  write_int(ABSTRACTION_FILE_MAGIC);
+  write_int(tables_.size());
+  for (const auto& [key, table] : tables_) {
+    write_int(table.board1.size());
+    for (int c : table.board1) write_int(c);
+    for (int c : table.board2) write_int(c);
+    write_int(table.num_buckets);
+
+    int num_entries = 0;
+    for (int16_t bucket : table.buckets) {
+      num_entries += bucket != NO_BUCKET;
+    }
+    write_int(num_entries);
+    for (int handhash = 0; handhash < table.buckets.size(); handhash++) {
+      if (table.buckets[handhash] != NO_BUCKET) {
+        write_int(handhash);
+        write_int(table.buckets[handhash]);
+      }
+    }
+  }
+
+  if (!out) {
+    throw runtime_error("Failed to write " + path);
+  }
+}
+
+void HandAbstraction::Load(const string& path) {
+  ifstream in(path, ios::binary);
+  if (!in) {
+    throw runtime_error("Failed to open " + path + " for reading.");
+  }
+
+  auto read_int = [&]() {
+    int32_t x = 0;
+    in.read(reinterpret_cast<char*>(&x), sizeof(x));
+    if (!in) {
+      throw runtime_error("Abstraction file " + path + " is truncated.");
+    }
+    return x;
+  };
+
+  if (read_int() != (int32_t)ABSTRACTION_FILE_MAGIC) {
+    throw runtime_error(path + " is not an abstraction file.");
+  }
+
+  map<pair<uint64_t, uint64_t>, Table> tables;
+  int num_tables = read_int();
+  for (int t = 0; t < num_tables; t++) {
+    Table table;
+    int board_size = read_int();
+    if (board_size < 3 || board_size > 5) {
+      throw runtime_error("Abstraction file " + path + " is corrupt.");
+    }
+    for (int i = 0; i < board_size; i++) table.board1.push_back(read_int());
+    for (int i = 0; i < board_size; i++) table.board2.push_back(read_int());
+    table.num_buckets = read_int();
+
+    if (table.num_buckets < 0 || table.num_buckets > MAX_BUCKETS) {
+      throw runtime_error("Abstraction file " + path + " is corrupt.");
+    }
+
+    int num_entries = read_int();
+    table.buckets.assign(NUM_HANDS, NO_BUCKET);
+    for (int i = 0; i < num_entries; i++) {
+      int handhash = read_int();
+      int bucket = read_int();
+      if (handhash < 0 || handhash >= NUM_HANDS || bucket < 0 ||
+          bucket >= table.num_buckets) {
+        throw runtime_error("Abstraction file " + path + " is corrupt.");
+      }
+      table.buckets[handhash] = bucket;
+    }
+
+    tables[BoardKey(table.board1, table.board2)] = move(table);
+  }
+
+  tables_ = move(tables);
+  images_.clear();
+  for (const auto& [key, table] : tables_) {
+    AddImages(key, table);
+  }
+}
@@ -0,0 +1,110 @@
+// abstraction.h
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// HandAbstraction maps hands into a small number of buckets, so that strategy
+// and regrets are shared between hands that play similarly.
+//
+// A table is built for one specific pair of boards (i.e. one street of one
+// runout). Hands are described by double board equity features:
+// - EHS on each board (expected hand strength against a random hand)
+// - EHS^2 on each board (captures potential - draws have a high spread)
+// and clustered offline with k-means. The result is a lookup table
+// hand_index -> bucket, which can be saved and loaded.
+//
+// A table also serves every suit relabelling of its boards, with the hand
+// relabelled to match, since ChanceNode moves the game state to a canonical
+// representative of each deal. Boards without a table are not abstracted (the
+// hand is its own bucket).
+class HandAbstraction {
+ public:
+  HandAbstraction() {}
+
+  // Build clusters every hand that doesn't conflict with the boards into
+  // num_buckets buckets.
+  // Params:
+  // board1, board2 - boards to build the table for (3, 4 or 5 cards each).
+  // num_buckets - K, number of buckets for this street.
+  // num_runouts - runouts sampled per hand when computing features.
+  // num_opponents - opponent hands sampled per runout.
+  // kmeans_iterations - number of Lloyd iterations.
+  // seed - seed for sampling and centroid initialisation.
+  void Build(const vector<int>& board1, const vector<int>& board2,
+             int num_buckets, int num_runouts = 16, int num_opponents = 8,
+             int kmeans_iterations = 25, unsigned int seed = 0);
+
+  // Whether a table exists for these boards.
+  bool HasTable(const vector<int>& board1, const vector<int>& board2) const;
+
+  // Returns the bucket of a hand, or -1 if there is no table for these boards.
+  int GetBucket(const vector<int>& board1, const vector<int>& board2,
+                int handhash) const;
+
+  // Number of buckets in the table for these boards (0 if there is none).
+  int NumBuckets(const vector<int>& board1, const vector<int>& board2) const;
+
+  // Most buckets a table can have.
+  static constexpr int MAX_BUCKETS = 32767;
+
+  // InfosetKey replaces handhash (the hand_index of the hand) as the key into
+  // Node's tables.
+  // Buckets are encoded as negative numbers so they can never collide with a
+  // real handhash. If there is no table for these boards, returns handhash.
+  int InfosetKey(const vector<int>& board1, const vector<int>& board2,
+                 int handhash) const;
+
+  // Binary file format, so tables can be clustered offline.
+  void Save(const string& path) const;
+  void Load(const string& path);
+
+ private:
+  struct Table {
+    vector<int> board1;
+    vector<int> board2;
+    int num_buckets = 0;
+    // dense, indexed by hand_index. NO_BUCKET for hands that clash with the
+    // boards.
+    vector<int16_t> buckets;
+  };
+
+  static constexpr int16_t NO_BUCKET = -1;
+
+  // One suit relabelling of a table's boards. to_table[s] is the table's suit
+  // for suit s of the relabelled boards.
+  struct Image {
+    pair<uint64_t, uint64_t> table;
+    array<int, 4> to_table;
+    bool identity;
+  };
+
+  // Tables keyed by {mask of board1, mask of board2}.
+  map<pair<uint64_t, uint64_t>, Table> tables_;
+  // Every relabelling of every table's boards, keyed the same way.
+  map<pair<uint64_t, uint64_t>, Image> images_;
+
+  static pair<uint64_t, uint64_t> BoardKey(const vector<int>& board1,
+                                           const vector<int>& board2);
+
+  // Adds the relabellings of the table at key to images_. The table's own
+  // boards always map to it, relabellings don't replace another table's.
+  void AddImages(const pair<uint64_t, uint64_t>& key, const Table& table);
+
+  // The table for these boards, or one of their relabellings, and the image
+  // that maps a hand onto it.
+  const Table* FindTable(const vector<int>& board1, const vector<int>& board2,
+                         const Image** image = nullptr) const;
+};
+
+// Returns true if key was produced by HandAbstraction::InfosetKey from a
+// bucket, rather than being a plain handhash.
+inline bool is_bucket_key(int key) { return key < 0; }
+
+inline int bucket_from_key(int key) { return -key - 1; }
@@ -0,0 +1,81 @@
+// action_tree.cpp
+#include "action_tree.h"
+
+#include <stdexcept>
+
+#include "gamestate.h"
+
+using namespace std;
+
+void ActionTree::Build(const TreeConfig& config) {
+  // 6 flop cards + 4 turn/river cards + 4 cards per player must fit in a deck.
+  if (config.num_players < 2 || config.num_players > 10) {
+    throw runtime_error("Action tree supports between 2 and 10 players.");
+  }
+
+  *this = ActionTree();
+  num_players_ = config.num_players;
+
+  // Betting doesn't depend on the cards, so any boards will do.
+  GameState root({0, 1, 2}, {3, 4, 5}, config.num_players, config.stack_depth,
+                 config.ante, config.bet_sizing);
+
+  Expand(root);
+}
+
+// Expands state (which must not use a tree itself) depth first, returning the
+// id of the node created for it. Edges are reserved before the children are
+// expanded, so each node's edges are contiguous.
+int ActionTree::Expand(GameState& state) {
+  const int id = type_.size();
+  const int street = state.board1_.size() - 3;
+
+  uint16_t folded = 0;
+  for (int p = 0; p < num_players_; p++) {
+    if (state.players_[p].is_folded()) {
+      folded |= 1 << p;
+    }
+    stacks_.push_back(state.players_[p].get_money());
+  }
+
+  street_.push_back(street);
+  next_to_act_.push_back(state.get_next_to_act());
+  pot_.push_back(state.pot_);
+  folded_.push_back(folded);
+  first_action_.push_back(actions_.size());
+
+  if (state.end_of_game()) {
+    type_.push_back(TERMINAL);
+    num_actions_.push_back(0);
+    return id;
+  }
+
+  if (state.end_of_action()) {
+    type_.push_back(CHANCE);
+    num_actions_.push_back(1);
+    actions_.push_back(NOTHING);
+    children_.push_back(0);
+
+    const int edge = first_action_[id];
+    GameState next = state;
+    next.next_street();
+    children_[edge] = Expand(next);
+    return id;
+  }
+
+  vector<pair<HandAction, double>> available = state.GetUniformStrategy();
+  type_.push_back(DECISION);
+  num_actions_.push_back(available.size());
+  for (const auto& [action, probability] : available) {
+    actions_.push_back(action);
+    children_.push_back(0);
+  }
+
+  const int first = first_action_[id];
+  for (int i = 0; i < available.size(); i++) {
+    GameState next = state;
+    next.do_next_action(available[i].first);
+    children_[first + i] = Expand(next);
+  }
+  return id;
+}
@@ -0,0 +1,94 @@
+// action_tree.h
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "handaction.h"
+
+using namespace std;
+
+class GameState;
+
+// Betting configuration that the action tree is built for.
+struct TreeConfig {
+  int num_players = 2;
+  double stack_depth = 50.0;
+  double ante = 5.0;
+  BetSizing bet_sizing;
+};
+
+// ActionTree is the full betting tree for a configuration, enumerated before
+// solving. Betting doesn't depend on the cards, so every decision node of the
+// solver maps onto exactly one node of this tree.
+//
+// Nodes are stored as parallel arrays (struct of arrays), indexed by node id.
+// The root is node 0 (first action on the flop).
+// Edges of node i are actions_[first_action_[i] ... + num_actions_[i]], and
+// children_ holds the node reached by each edge.
+// A chance node (end of a betting round) has a single edge (NOTHING) to the
+// first node of the next street.
+class ActionTree {
+ public:
+  enum NodeType : uint8_t { DECISION, CHANCE, TERMINAL };
+
+  // Build enumerates the betting tree. Replaces any existing tree.
+  void Build(const TreeConfig& config);
+
+  int NumNodes() const { return type_.size(); }
+  int NumPlayers() const { return num_players_; }
+
+  NodeType Type(int node) const { return (NodeType)type_[node]; }
+  bool IsTerminal(int node) const { return type_[node] == TERMINAL; }
+  bool IsChance(int node) const { return type_[node] == CHANCE; }
+
+  // 0 = flop, 1 = turn, 2 = river
+  int Street(int node) const { return street_[node]; }
+  int NextToAct(int node) const { return next_to_act_[node]; }
+  double Pot(int node) const { return pot_[node]; }
+  double Stack(int node, int player) const {
+    return stacks_[node * num_players_ + player];
+  }
+  bool IsFolded(int node, int player) const {
+    return (folded_[node] >> player) & 1;
+  }
+
+  int NumActions(int node) const { return num_actions_[node]; }
+  HandAction Action(int node, int i) const {
+    return (HandAction)actions_[first_action_[node] + i];
+  }
+  int Child(int node, int i) const { return children_[first_action_[node] + i]; }
+
+  // Returns the child reached by taking action at node, or -1 if the action
+  // isn't legal there.
+  int ChildByAction(int node, HandAction action) const {
+    for (int i = 0; i < num_actions_[node]; i++) {
+      if (actions_[first_action_[node] + i] == action) {
+        return children_[first_action_[node] + i];
+      }
+    }
+    return -1;
+  }
+
+  // For chance nodes, the first node of the next street.
+  int ChanceChild(int node) const { return children_[first_action_[node]]; }
+
+ private:
+  int num_players_ = 0;
+
+  int Expand(GameState& state);
+
+  // per node
+  vector<uint8_t> type_;
+  vector<uint8_t> street_;
+  vector<int8_t> next_to_act_;
+  vector<float> pot_;
+  vector<float> stacks_;    // num_players_ entries per node
+  vector<uint16_t> folded_;  // bit i set if player i has folded
+  vector<uint32_t> first_action_;
+  vector<uint8_t> num_actions_;
+
+  // per edge
+  vector<uint8_t> actions_;
+  vector<uint32_t> children_;
+};
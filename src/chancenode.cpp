@@ -2,23 +2,68 @@
 #include "chancenode.h"
 
 #include <algorithm>
+#include <set>
 
 #include "gamestate.h"
 #include "node.h"
 
 using namespace std;
 
+int ChanceNode::Canonicalise(int top_card, int bottom_card) const {
+  int best = 0;
+  pair<int, int> best_deal = {top_card, bottom_card};
+  for (int i = 1; i < symmetries_.size(); i++) {
+    pair<int, int> deal = {permute_card(top_card, symmetries_[i]),
+                           permute_card(bottom_card, symmetries_[i])};
+    if (deal < best_deal) {
+      best_deal = deal;
+      best = i;
+    }
+  }
+  return best;
+}
+
+int ChanceNode::OrbitSize(int top_card, int bottom_card) const {
+  set<pair<int, int>> orbit;
+  for (const auto& perm : symmetries_) {
+    orbit.insert(
+        {permute_card(top_card, perm), permute_card(bottom_card, perm)});
+  }
+  return orbit.size();
+}
 
 Node* ChanceNode::GetNextNodeAndState(GameState* game_state) {
+  call_once(symmetries_once_, [&]() {
+    symmetries_ = board_symmetries(game_state->board1_, game_state->board2_);
+    symmetries_ready_.store(true, memory_order_release);
+  });
+
   pair<int, int> dealt_cards = game_state->next_street();
 
-  Node* child;
-  if (next_.find(dealt_cards) != next_.end()) {
-    child = next_[dealt_cards];
-  } else {
-    child = new Node(game_state->get_next_to_act());
-    child->parent = this;
-    next_[dealt_cards] = child;
+  int canonical = Canonicalise(dealt_cards.first, dealt_cards.second);
+  if (canonical != 0) {
+    const SuitPermutation& perm = symmetries_[canonical];
+    game_state->permute_suits(perm);
+    dealt_cards = {permute_card(dealt_cards.first, perm),
+                   permute_card(dealt_cards.second, perm)};
+  }
+
+  const int slot = SlotIndex(dealt_cards.first, dealt_cards.second);
+  Node* child = next_[slot].load(memory_order_acquire);
+  if (child == nullptr) {
+    Node* created = new Node(game_state->get_next_to_act());
+    created->parent = this;
+
+    // the weight is published by the release on the node pointer.
+    weights_[slot].store(OrbitSize(dealt_cards.first, dealt_cards.second),
+                         memory_order_relaxed);
+    if (next_[slot].compare_exchange_strong(child, created,
+                                            memory_order_acq_rel)) {
+      child = created;
+    } else {
+      // another thread expanded this runout first. child now holds its node.
+      delete created;
+    }
   }
 
   // have to update the state no matter what -
@@ -29,5 +74,50 @@ Node* ChanceNode::GetNextNodeAndState(GameState* game_state) {
 }
 
 Node* ChanceNode::GetNextNode(int next_top_card, int next_bottom_card) {
-  return next_[{next_top_card, next_bottom_card}];
-}
\ No newline at end of file
+  if (symmetries_ready_.load(memory_order_acquire)) {
+    const SuitPermutation& perm =
+        symmetries_[Canonicalise(next_top_card, next_bottom_card)];
+    next_top_card = permute_card(next_top_card, perm);
+    next_bottom_card = permute_card(next_bottom_card, perm);
+  }
+
+  return next_[SlotIndex(next_top_card, next_bottom_card)].load(
+      memory_order_acquire);
+}
+
+vector<Runout> ChanceNode::GetRunouts() const {
+  vector<Runout> runouts;
+  for (int slot = 0; slot < NUM_SLOTS; slot++) {
+    Node* node = next_[slot].load(memory_order_acquire);
+    if (node == nullptr) {
+      continue;
+    }
+
+    Runout runout;
+    runout.top_card = slot / 52;
+    runout.bottom_card = slot % 52;
+    runout.node = node;
+    runout.weight = weights_[slot].load(memory_order_relaxed);
+    runouts.push_back(runout);
+  }
+  return runouts;
+}
+
+vector<SuitPermutation> ChanceNode::DealPermutations(int top_card,
+                                                     int bottom_card) const {
+  if (!symmetries_ready_.load(memory_order_acquire)) {
+    // nothing dealt yet, so nothing was permuted.
+    return {SuitPermutation{0, 1, 2, 3}};
+  }
+
+  vector<SuitPermutation> permutations;
+  set<pair<int, int>> deals;
+  for (const auto& perm : symmetries_) {
+    const int top = permute_card(top_card, perm);
+    const int bottom = permute_card(bottom_card, perm);
+    if (deals.insert({top, bottom}).second) {
+      permutations.push_back(symmetries_[Canonicalise(top, bottom)]);
+    }
+  }
+  return permutations;
+}
@@ -1,29 +1,64 @@
 // chancenode.h
 #pragma once
-#include <unordered_map>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
 #include <utility>
+#include <vector>
 
 #include "gamestate.h"
+#include "helper.h"
 #include "node.h"
 
 using namespace std;
-struct PairHash {
-  size_t operator()(const std::pair<int, int>& p) const noexcept {
-    // very simple hash function
-    return (static_cast<size_t>(p.first) << 32) ^ static_cast<size_t>(p.second);
-  }
-};
-struct PairEq {
-  bool operator()(const std::pair<int, int>& a,
-                  const std::pair<int, int>& b) const noexcept {
-    return a.first == b.first && a.second == b.second;
-  }
+
+// Runout is a subtree after a chance node, for one isomorphism class of
+// dealt cards.
+struct Runout {
+  int top_card = -1;
+  int bottom_card = -1;
+  Node* node = nullptr;
+  // number of (top card, bottom card) deals that are suit-isomorphic to this
+  // one, including itself.
+  int weight = 0;
 };
 
 // ChanceNode allows us to handle turns and rivers
+//
+// Deals that are identical up to a relabelling of suits (e.g. when no card on
+// either board is a diamond or a spade, the turn 2d/3d is the same as 2s/3s)
+// share a single subtree. Each deal is mapped to a canonical representative,
+// and the game state is suit-permuted to match on the way down.
+//
+// Children are stored in a dense 52x52 array indexed by
+// top_card * 52 + bottom_card, populated lazily. Slots are atomic so that
+// several solver threads can expand the same chance node.
 class ChanceNode : public Node {
  private:
-  unordered_map<pair<int, int>, Node*, PairHash, PairEq> next_;
+  static constexpr int NUM_SLOTS = 52 * 52;
+
+  array<atomic<Node*>, NUM_SLOTS> next_{};
+  array<atomic<uint8_t>, NUM_SLOTS> weights_{};
+
+  // suit permutations that leave both boards unchanged at this node.
+  // computed on the first deal, inside call_once, then published by the
+  // release store to symmetries_ready_. Threads that don't deal (the GUI)
+  // must acquire symmetries_ready_ before reading them.
+  vector<SuitPermutation> symmetries_;
+  once_flag symmetries_once_;
+  atomic<bool> symmetries_ready_{false};
+
+  static int SlotIndex(int top_card, int bottom_card) {
+    return top_card * 52 + bottom_card;
+  }
+
+  // Returns the index into symmetries_ of the permutation that maps the deal
+  // to its canonical representative.
+  int Canonicalise(int top_card, int bottom_card) const;
+
+  // Number of distinct deals that are isomorphic to this one.
+  int OrbitSize(int top_card, int bottom_card) const;
 
  public:
   ChanceNode(int table_position) : Node(table_position) {}
@@ -31,5 +66,18 @@ class ChanceNode : public Node {
   // dealing out the next street
   Node* GetNextNodeAndState(GameState* game_state);
 
+  // Returns the subtree for this deal (or an isomorphic one). nullptr if it
+  // hasn't been reached yet.
   Node* GetNextNode(int next_top_card, int next_bottom_card);
+
+  // Returns every runout that has been expanded so far, ordered by
+  // {top card, bottom card}.
+  vector<Runout> GetRunouts() const;
+
+  // For each actual deal that lands on the runout {top_card, bottom_card},
+  // the suit permutation GetNextNodeAndState applied to the game state - i.e.
+  // the one that maps the deal (and every hand) onto the runout. One per
+  // distinct deal, so they are equally likely.
+  vector<SuitPermutation> DealPermutations(int top_card,
+                                           int bottom_card) const;
 };
@@ -1,30 +1,33 @@
 #pragma once
 
 #include <algorithm>
-#include <chrono>
+#include <cstdint>
 #include <iterator>
-#include <random>
 #include <stdexcept>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+#include "rng.h"
+
 using namespace std;
 
 class Deck {
  public:
   vector<int> cards;
-  mt19937 gen;
 
-  Deck() {
+  // All randomness comes from the thread's engine (thread_rng()), so a seeded
+  // solver deals the same cards every run.
+  Deck() { reset(); }
+
+  // reset refills and reshuffles the deck, reusing its storage.
+  void reset() {
+    cards.resize(52);
     for (int i = 0; i < 52; i++) {
-      cards.push_back(i);
+      cards[i] = i;
     }
 
     shuffle();
-
-    random_device rd;
-    gen = mt19937(rd());
   }
 
   // deal deals a singular card without replacement
@@ -42,16 +45,12 @@ class Deck {
   }
 
   void shuffle() {
-    // Create a random device for additional entropy
-    std::random_device rd;
-
-    // Combine the random device with the time-based seed
-    unsigned long long seed =
-        static_cast<unsigned long long>(rd()) ^
-        static_cast<unsigned long long>(
-            std::chrono::steady_clock::now().time_since_epoch().count());
-
-    std::shuffle(cards.begin(), cards.end(), std::default_random_engine(seed));
+    // Fisher-Yates. std::shuffle's output depends on the standard library, so
+    // do it by hand to get the same deck everywhere.
+    CounterRng& rng = thread_rng();
+    for (int i = cards.size() - 1; i > 0; i--) {
+      swap(cards[i], cards[rng.below(i + 1)]);
+    }
   }
   // deal_without_modification deals num_cards cards without modifying deck.
   // Param:
@@ -62,15 +61,16 @@ class Deck {
       throw runtime_error("ERROR: Not enough cards\n");
     }
 
-    uniform_int_distribution<int> dist(0, cards.size() - 1);
-    unordered_set<int> chosen_cards;
+    CounterRng& rng = thread_rng();
+    vector<int> result;
 
-    while (chosen_cards.size() != num_cards) {
-      chosen_cards.insert(cards[dist(gen)]);
+    while (result.size() != num_cards) {
+      int card = cards[rng.below(cards.size())];
+      if (find(result.begin(), result.end(), card) == result.end()) {
+        result.push_back(card);
+      }
     }
 
-    vector<int> result(chosen_cards.begin(), chosen_cards.end());
-
     return result;
   }
 
@@ -91,47 +91,48 @@ class Deck {
     return chosen_cards;
   }
 
+  // Same as above, but deals into out, reusing its storage.
+  void deal_with_modification(const int num_cards, vector<int>& out) {
+    if (num_cards > cards.size()) {
+      throw runtime_error("ERROR: Not enough cards\n");
+    }
+
+    out.assign(cards.end() - num_cards, cards.end());
+    cards.resize(cards.size() - num_cards);
+  }
+
   // erase removes specific cards from the deck. Throws error if they are not
   // found. Param: vector<int> cards_to_remove: vector of cards to remove.
   // cards_to_remove must be unique
   //(you wont ever have to remove cards that are the same anyways)
-  void erase(vector<int> cards_to_remove) {
-    // This is O(n), but its fine. I don't think erase() will be called often
-    // except for when initialising. If it is called
-
-    int p1 = 0;
-    int p2 = 0;
-
-    unordered_map<int, bool> should_remove;
-
+  void erase(const vector<int>& cards_to_remove) {
+    uint64_t mask = 0;
     for (const auto& c : cards_to_remove) {
-      should_remove[c] = true;
-    }
-
-    int num_removed = 0;
-    while (p2 < cards.size()) {
-      if (should_remove[cards[p2]]) {
-        num_removed++;
-        p2++;
-        continue;
-      }
-
-      cards[p1] = cards[p2];
-      p1++;
-      p2++;
+      mask |= 1ull << c;
     }
 
-    auto it = cards.begin();
-    advance(it, p1);
-    cards.erase(it, cards.end());
-
-    if (num_removed != cards_to_remove.size()) {
+    if (erase_mask(mask) != cards_to_remove.size()) {
       throw runtime_error(
           "Failed to remove some cards. Probably duplicate "
           "card error somewhere.");
     }
   }
 
+  // erase_mask removes every card whose bit is set in mask, keeping the order
+  // of the rest. Returns the number of cards removed.
+  int erase_mask(uint64_t mask) {
+    int p1 = 0;
+    for (int p2 = 0; p2 < cards.size(); p2++) {
+      if (!(mask & (1ull << cards[p2]))) {
+        cards[p1++] = cards[p2];
+      }
+    }
+
+    int num_removed = cards.size() - p1;
+    cards.resize(p1);
+    return num_removed;
+  }
+
   void replace(int card) {
     cards.push_back(card);
     shuffle();
@@ -1,11 +1,16 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cstdint>
 #include <iostream>
 #include <vector>
 
 #include "deck.h"
+#include "evaluator_backend.h"
 #include "helper.h"
-#include "include/phevaluator.h"
+#include "kernels.h"
 
 using namespace std;
 
@@ -15,32 +20,35 @@ inline vector<double> equity_calc(vector<vector<int>>& hands,
   int num_players = hands.size();
   vector<double> equity(num_players);
 
-  phevaluator::Rank board_one_best_rank = phevaluator::Rank(999999);
-  phevaluator::Rank board_two_best_rank = phevaluator::Rank(999999);
+  vector<const int*> holes(num_players);
+  for (int j = 0; j < num_players; j++) {
+    holes[j] = hands[j].data();
+  }
+  vector<int> board_one_ranks(num_players), board_two_ranks(num_players);
+  showdown_evaluator_for(num_players)
+      .EvaluateBoards(board1.data(), board2.data(), holes.data(), num_players,
+                      board_one_ranks.data(), board_two_ranks.data());
+
+  // lower ranks are stronger.
+  int board_one_best_rank = INT32_MAX;
+  int board_two_best_rank = INT32_MAX;
   vector<int> board_one_winners;
   vector<int> board_two_winners;
 
   for (int j = 0; j < num_players; j++) {
-    phevaluator::Rank board1_j = phevaluator::EvaluatePlo4Cards(
-        board1[0], board1[1], board1[2], board1[3], board1[4], hands[j][0],
-        hands[j][1], hands[j][2], hands[j][3]);
-    phevaluator::Rank board2_j = phevaluator::EvaluatePlo4Cards(
-        board2[0], board2[1], board2[2], board2[3], board2[4], hands[j][0],
-        hands[j][1], hands[j][2], hands[j][3]);
-
-    if (board1_j > board_one_best_rank) {
+    if (board_one_ranks[j] < board_one_best_rank) {
       board_one_winners.clear();
       board_one_winners.push_back(j);
-      board_one_best_rank = board1_j;
-    } else if (board1_j == board_one_best_rank) {
+      board_one_best_rank = board_one_ranks[j];
+    } else if (board_one_ranks[j] == board_one_best_rank) {
       board_one_winners.push_back(j);
     }
 
-    if (board2_j > board_two_best_rank) {
+    if (board_two_ranks[j] < board_two_best_rank) {
       board_two_winners.clear();
       board_two_winners.push_back(j);
-      board_two_best_rank = board2_j;
-    } else if (board2_j == board_two_best_rank) {
+      board_two_best_rank = board_two_ranks[j];
+    } else if (board_two_ranks[j] == board_two_best_rank) {
       board_two_winners.push_back(j);
     }
   }
@@ -56,90 +64,67 @@ inline vector<double> equity_calc(vector<vector<int>>& hands,
   return equity;
 }
 
-// this will probably be the most useful one.
-// given that we are at the flop, and I am holding a specific hand, calculate my
-// equity. void multiway_equity_calc(my_hand, flop1, flop2)
-inline void multiway_equity_calc(vector<int> hand, vector<int> flop1,
-                                 vector<int> flop2, Deck d) {
-  int num_players = 8;
-  int num_iterations = 100000;
-
-  double sum_eq = 0;
-
-  for (int i = 0; i < num_iterations; i++) {
-    vector<int> other_cards =
-        d.deal_without_modification((num_players - 1) * 4 + 4);
-
-    // If there are num_players players including us, then there are num_players
-    // - 1 other players. Cards [0,1,2,3], [4,5,6,7]... belong to those other
-    // people.
-
-    // Then the last 4 cards are for the 2 turn and rivers.
-    int t1 = other_cards[(num_players - 1) * 4];
-    int r1 = other_cards[(num_players - 1) * 4 + 1];
-    int t2 = other_cards[(num_players - 1) * 4 + 2];
-    int r2 = other_cards[(num_players - 1) * 4 + 3];
-
-    vector<int> board1 = {flop1[0], flop1[1], flop1[2], t1, r1};
-    vector<int> board2 = {flop2[0], flop2[1], flop2[2], t2, r2};
-
-    vector<vector<int>> hands;
-    hands.push_back(hand);
-
-    for (int j = 0; j < num_players - 1; j++) {
-      hands.push_back({other_cards[4 * j], other_cards[4 * j + 1],
-                       other_cards[4 * j + 2], other_cards[4 * j + 3]});
-    }
-
-    vector<double> showdown_equity = equity_calc(hands, board1, board2);
-
-    sum_eq += showdown_equity[0];
+// Adds each seat's share of a double board pot to equity[0..num_seats): each
+// board is worth half, split between its winners. Ranks are by seat, over
+// MAX_SEATS, with NO_SEAT_RANK for seats that are empty or folded.
+inline void showdown_equity(const int* board_one_ranks,
+                            const int* board_two_ranks, int num_seats,
+                            double* equity) {
+  // winners as bitmasks of seats.
+  const unsigned board_one_winners = showdown_winners(board_one_ranks);
+  const unsigned board_two_winners = showdown_winners(board_two_ranks);
+  const int num_board_one_winners =
+      bitset<MAX_SEATS>(board_one_winners).count();
+  const int num_board_two_winners =
+      bitset<MAX_SEATS>(board_two_winners).count();
+
+  const double board_one_share = 0.5 / (double)num_board_one_winners;
+  const double board_two_share = 0.5 / (double)num_board_two_winners;
+  for (int j = 0; j < num_seats; j++) {
+    if (board_one_winners & (1u << j)) equity[j] += board_one_share;
+    if (board_two_winners & (1u << j)) equity[j] += board_two_share;
   }
-
-  cout << "Iterations: " << num_iterations << endl;
-  cout << "Players: " << num_players << endl;
-
-  cout << "Flop1 : " << cards_to_string(flop1) << endl;
-  cout << "Flop2 : " << cards_to_string(flop2) << endl;
-
-  cout << "Hero Hand: " << cards_to_string(hand) << endl;
-
-  cout << "Equity: " << sum_eq / (double)num_iterations << endl;
 }
 
-inline void multiway_equity_calc() {
-  int num_players = 5;
-  int num_iterations = 100000;
-
-  // sum_eq[i] = cumulative equity of player i.
-  vector<double> sum_eq(num_players);
-
-  vector<vector<int>> hands(num_players);
-
-  Deck d;
-  for (int i = 0; i < num_players; i++) {
-    hands[i] = d.deal_with_modification(4);
-  }
-
-  for (int i = 0; i < num_iterations; i++) {
-    // b = both boards. First 5 is first board, second 5 is second board.
-    vector<int> b = d.deal_without_modification(10);
-
-    vector<int> board1 = {b[0], b[1], b[2], b[3], b[4]};
-    vector<int> board2 = {b[5], b[6], b[7], b[8], b[9]};
-    vector<double> showdown_equity = equity_calc(hands, board1, board2);
-
-    for (int j = 0; j < num_players; j++) {
-      sum_eq[j] += showdown_equity[j];
+// equity_calc for the solver's showdowns, with the number of seats fixed at
+// compile time so the player loops can be unrolled and nothing is allocated.
+// hands[j] points at player j's 4 cards, or is nullptr if they folded (their
+// equity is 0). Boards are 5 cards each.
+template <int MaxPlayers>
+inline array<double, MaxPlayers> equity_calc(
+    const array<const int*, MaxPlayers>& hands, const int* board1,
+    const int* board2) {
+  array<double, MaxPlayers> equity{};
+
+  // ranks by seat, for the showdown kernel. Folded seats never win.
+  static_assert(MaxPlayers <= MAX_SEATS, "too many seats for a showdown");
+  alignas(64) int board_one_ranks[MAX_SEATS];
+  alignas(64) int board_two_ranks[MAX_SEATS];
+  fill(board_one_ranks, board_one_ranks + MAX_SEATS, NO_SEAT_RANK);
+  fill(board_two_ranks, board_two_ranks + MAX_SEATS, NO_SEAT_RANK);
+
+  // the hands still in, ranked together.
+  const int* holes[MaxPlayers];
+  int seats[MaxPlayers];
+  int num_hands = 0;
+  for (int j = 0; j < MaxPlayers; j++) {
+    if (hands[j] != nullptr) {
+      holes[num_hands] = hands[j];
+      seats[num_hands++] = j;
     }
   }
 
-  cout << "Iterations: " << num_iterations << endl;
-  cout << "Players: " << num_players << endl;
-  for (int i = 0; i < num_players; i++) {
-    cout << "Player " << i << ": Hand = " << cards_to_string(hands[i])
-         << "| Equity = " << sum_eq[i] / (double)num_iterations << endl;
+  int ranks1[MaxPlayers], ranks2[MaxPlayers];
+  showdown_evaluator_for(num_hands).EvaluateBoards(
+      board1, board2, holes, num_hands, ranks1, ranks2);
+  for (int i = 0; i < num_hands; i++) {
+    board_one_ranks[seats[i]] = ranks1[i];
+    board_two_ranks[seats[i]] = ranks2[i];
   }
+
+  showdown_equity(board_one_ranks, board_two_ranks, MaxPlayers,
+                  equity.data());
+  return equity;
 }
 
 inline int equity_calc() {
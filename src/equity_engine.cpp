@@ -0,0 +1,232 @@
+// equity_engine.cpp
+#include "equity_engine.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "equity_calc.h"
+#include "evaluator_backend.h"
+#include "include/phevaluator.h"
+#include "rng.h"
+
+using namespace std;
+
+namespace {
+
+// Everything an iteration needs, laid out so a thread can copy it once.
+struct Deal {
+  int num_players = 0;
+  int num_known = 0;
+  array<int, 4 * MAX_SEATS> known_hands{};
+  array<int, 5> board1{}, board2{};
+  int board1_size = 0, board2_size = 0;
+  // cards nobody holds. Every iteration draws the random hands, then the
+  // rest of board1, then the rest of board2, from the front of it.
+  array<int, 52> deck{};
+  int deck_size = 0;
+  int num_drawn = 0;
+};
+
+// Per thread sums of each player's equity (and its square, for the standard
+// error). Padded to a cache line so threads don't share one.
+struct alignas(64) Accumulator {
+  array<double, MAX_SEATS> sum{};
+  array<double, MAX_SEATS> sum_squares{};
+};
+
+// Iterations are dealt in blocks of this many. The known hands are the same
+// in every iteration, so each is ranked on all of a block's boards at once,
+// through evaluate_plo4_boards' hole major tables.
+constexpr int BLOCK_SIZE = 256;
+
+void run_iterations(const Deal& deal, uint64_t seed, long long begin,
+                    long long end, Accumulator* accumulator) {
+  CounterRng rng(seed);
+  array<int, 52> deck;
+  const int num_random = deal.num_players - deal.num_known;
+  const int board_offset = 4 * num_random;
+
+  // the brute force backend is for machines that can't load the PLO4
+  // tables, so the known hands are only batched when the showdowns use them.
+  const bool batch_known =
+      showdown_evaluator_for(deal.num_players).Backend() !=
+      EVALUATOR_BRUTE_FORCE;
+  const int num_evaluated = batch_known ? num_random : deal.num_players;
+  const ShowdownEvaluator& evaluator =
+      showdown_evaluator_for(max(num_evaluated, 1));
+
+  // one block's boards and random hands, and the known hands' ranks on them.
+  vector<int> boards1(5 * BLOCK_SIZE), boards2(5 * BLOCK_SIZE);
+  vector<int> random_hands(board_offset * BLOCK_SIZE);
+  vector<int> known_ranks1(deal.num_known * BLOCK_SIZE);
+  vector<int> known_ranks2(deal.num_known * BLOCK_SIZE);
+
+  for (long long block = begin; block < end; block += BLOCK_SIZE) {
+    const int n = (int)min<long long>(BLOCK_SIZE, end - block);
+
+    for (int k = 0; k < n; k++) {
+      // restart from the same deck, so the deal only depends on i.
+      rng.Seek(seed, 0, block + k);
+      deck = deal.deck;
+      for (int d = 0; d < deal.num_drawn; d++) {
+        swap(deck[d], deck[d + rng.below(deal.deck_size - d)]);
+      }
+
+      copy(deck.begin(), deck.begin() + board_offset,
+           random_hands.begin() + board_offset * k);
+      int* board1 = &boards1[5 * k];
+      int* board2 = &boards2[5 * k];
+      copy(deal.board1.begin(), deal.board1.end(), board1);
+      copy(deal.board2.begin(), deal.board2.end(), board2);
+      int next = board_offset;
+      for (int b = deal.board1_size; b < 5; b++) board1[b] = deck[next++];
+      for (int b = deal.board2_size; b < 5; b++) board2[b] = deck[next++];
+    }
+
+    if (batch_known) {
+      for (int j = 0; j < deal.num_known; j++) {
+        const int* hole = &deal.known_hands[4 * j];
+        evaluate_plo4_boards(hole, boards1.data(), n,
+                             &known_ranks1[BLOCK_SIZE * j]);
+        evaluate_plo4_boards(hole, boards2.data(), n,
+                             &known_ranks2[BLOCK_SIZE * j]);
+      }
+    }
+
+    for (int k = 0; k < n; k++) {
+      alignas(64) int ranks1[MAX_SEATS];
+      alignas(64) int ranks2[MAX_SEATS];
+      fill(ranks1, ranks1 + MAX_SEATS, NO_SEAT_RANK);
+      fill(ranks2, ranks2 + MAX_SEATS, NO_SEAT_RANK);
+
+      // seats are the known hands, then the random ones.
+      const int* holes[MAX_SEATS];
+      for (int j = 0; j < deal.num_known; j++) {
+        holes[j] = &deal.known_hands[4 * j];
+      }
+      for (int j = 0; j < num_random; j++) {
+        holes[deal.num_known + j] = &random_hands[board_offset * k + 4 * j];
+      }
+
+      const int first = deal.num_players - num_evaluated;
+      if (num_evaluated > 0) {
+        evaluator.EvaluateBoards(&boards1[5 * k], &boards2[5 * k],
+                                 holes + first, num_evaluated, ranks1 + first,
+                                 ranks2 + first);
+      }
+      if (batch_known) {
+        for (int j = 0; j < deal.num_known; j++) {
+          ranks1[j] = known_ranks1[BLOCK_SIZE * j + k];
+          ranks2[j] = known_ranks2[BLOCK_SIZE * j + k];
+        }
+      }
+
+      array<double, MAX_SEATS> equity{};
+      showdown_equity(ranks1, ranks2, deal.num_players, equity.data());
+      for (int j = 0; j < deal.num_players; j++) {
+        accumulator->sum[j] += equity[j];
+        accumulator->sum_squares[j] += equity[j] * equity[j];
+      }
+    }
+  }
+}
+
+}  // namespace
+
+EquityResult monte_carlo_equity(const vector<vector<int>>& hands,
+                                const vector<int>& board1,
+                                const vector<int>& board2,
+                                int num_random_hands,
+                                const EquityConfig& config) {
+  Deal deal;
+  deal.num_known = hands.size();
+  deal.num_players = deal.num_known + num_random_hands;
+  if (num_random_hands < 0 || deal.num_players < 1 ||
+      deal.num_players > MAX_SEATS) {
+    throw runtime_error("monte_carlo_equity: bad number of players.");
+  }
+  if (board1.size() > 5 || board2.size() > 5) {
+    throw runtime_error("monte_carlo_equity: boards have at most 5 cards.");
+  }
+
+  uint64_t used = 0;
+  auto use = [&](int card) {
+    if (card < 0 || card >= 52 || (used & (1ull << card))) {
+      throw runtime_error("monte_carlo_equity: card used twice.");
+    }
+    used |= 1ull << card;
+  };
+  for (int j = 0; j < deal.num_known; j++) {
+    if (hands[j].size() != 4) {
+      throw runtime_error("monte_carlo_equity: hands have 4 cards.");
+    }
+    for (int k = 0; k < 4; k++) {
+      use(hands[j][k]);
+      deal.known_hands[4 * j + k] = hands[j][k];
+    }
+  }
+  for (int card : board1) use(card);
+  for (int card : board2) use(card);
+  copy(board1.begin(), board1.end(), deal.board1.begin());
+  copy(board2.begin(), board2.end(), deal.board2.begin());
+  deal.board1_size = board1.size();
+  deal.board2_size = board2.size();
+
+  for (int card = 0; card < 52; card++) {
+    if (!(used & (1ull << card))) deal.deck[deal.deck_size++] = card;
+  }
+  deal.num_drawn = 4 * num_random_hands + (5 - deal.board1_size) +
+                   (5 - deal.board2_size);
+  if (deal.num_drawn > deal.deck_size) {
+    throw runtime_error("monte_carlo_equity: not enough cards to deal.");
+  }
+
+  const long long num_iterations = max(config.num_iterations, 0ll);
+  int num_threads = config.num_threads > 0
+                        ? config.num_threads
+                        : max(1, (int)thread::hardware_concurrency());
+  num_threads = (int)max(1ll, min<long long>(num_threads, num_iterations));
+
+  // picks (and if need be benchmarks) the evaluator before the threads
+  // start, so none of them pays for it inside the loop.
+  showdown_evaluator_for(deal.num_players);
+
+  vector<Accumulator> accumulators(num_threads);
+  vector<thread> threads;
+  for (int t = 0; t < num_threads; t++) {
+    const long long begin = num_iterations * t / num_threads;
+    const long long end = num_iterations * (t + 1) / num_threads;
+    threads.emplace_back(run_iterations, cref(deal), config.seed, begin, end,
+                         &accumulators[t]);
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  EquityResult result;
+  result.num_iterations = num_iterations;
+  result.num_threads = num_threads;
+  result.equity.assign(deal.num_players, 0.0);
+  result.std_error.assign(deal.num_players, 0.0);
+  if (num_iterations == 0) {
+    return result;
+  }
+
+  for (int j = 0; j < deal.num_players; j++) {
+    double sum = 0.0, sum_squares = 0.0;
+    for (const auto& accumulator : accumulators) {
+      sum += accumulator.sum[j];
+      sum_squares += accumulator.sum_squares[j];
+    }
+    const double mean = sum / num_iterations;
+    const double variance =
+        max(0.0, sum_squares / num_iterations - mean * mean);
+    result.equity[j] = mean;
+    result.std_error[j] = sqrt(variance / num_iterations);
+  }
+  return result;
+}
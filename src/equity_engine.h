@@ -0,0 +1,52 @@
+// equity_engine.h
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+struct EquityConfig {
+  long long num_iterations = 100000;
+  // 0 uses every core.
+  int num_threads = 0;
+  // Iteration i draws its cards from (seed, i) alone, so a seed gives the same
+  // deals whatever the thread count.
+  uint64_t seed = 0;
+};
+
+struct EquityResult {
+  // Per player, known hands first then the random ones. Each board is worth
+  // half the pot, split between its winners.
+  vector<double> equity;
+  // Standard error of each equity.
+  vector<double> std_error;
+  long long num_iterations = 0;
+  int num_threads = 0;
+};
+
+// Monte Carlo equity of a double board PLO4 showdown.
+//
+// hands are the known 4 card hands, and num_random_hands more players get
+// random ones. Boards can have 0 to 5 cards - every iteration deals the rest
+// of both boards and the random hands from the cards nobody holds.
+//
+// Iterations are split across threads, each with its own engine, deck and
+// accumulators, which are merged at the end. Each thread deals its iterations
+// in blocks and ranks every known hand on the whole block's boards at once
+// (evaluate_plo4_boards), unless showdowns are pinned to brute force. Nothing
+// is allocated inside the loop. Throws if a card is used twice, there are more than MAX_SEATS
+// players, or there aren't enough cards left to deal.
+EquityResult monte_carlo_equity(const vector<vector<int>>& hands,
+                                const vector<int>& board1,
+                                const vector<int>& board2,
+                                int num_random_hands = 0,
+                                const EquityConfig& config = EquityConfig());
+
+// Equity of hand against num_players - 1 random hands, given both flops.
+inline EquityResult multiway_equity_calc(
+    const vector<int>& hand, const vector<int>& flop1,
+    const vector<int>& flop2, int num_players = 8,
+    const EquityConfig& config = EquityConfig()) {
+  return monte_carlo_equity({hand}, flop1, flop2, num_players - 1, config);
+}
@@ -0,0 +1,274 @@
+// evaluator_backend.cpp
+#include "evaluator_backend.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#include "include/phevaluator.h"
+#include "rng.h"
+
+using namespace std;
+
+namespace {
+
+class HashTableEvaluator : public ShowdownEvaluator {
+ public:
+  EvaluatorBackend Backend() const override { return EVALUATOR_HASH_TABLE; }
+
+  void Evaluate(const int* board, const int* const* hands, int num_hands,
+                int* ranks) const override {
+    for (int i = 0; i < num_hands; i++) {
+      const int* h = hands[i];
+      ranks[i] = evaluate_plo4_cards(board[0], board[1], board[2], board[3],
+                                     board[4], h[0], h[1], h[2], h[3]);
+    }
+  }
+};
+
+class BruteForceEvaluator : public ShowdownEvaluator {
+ public:
+  EvaluatorBackend Backend() const override { return EVALUATOR_BRUTE_FORCE; }
+
+  void Evaluate(const int* board, const int* const* hands, int num_hands,
+                int* ranks) const override {
+    for (int i = 0; i < num_hands; i++) {
+      const int* h = hands[i];
+      int best = INT32_MAX;
+      for (int a = 0; a < 4; a++) {
+        for (int b = a + 1; b < 4; b++) {
+          for (int c = 0; c < 5; c++) {
+            for (int d = c + 1; d < 5; d++) {
+              for (int e = d + 1; e < 5; e++) {
+                best = min(best, evaluate_5cards(h[a], h[b], board[c],
+                                                 board[d], board[e]));
+              }
+            }
+          }
+        }
+      }
+      ranks[i] = best;
+    }
+  }
+};
+
+class BoardContextEvaluator : public ShowdownEvaluator {
+ public:
+  EvaluatorBackend Backend() const override {
+    return EVALUATOR_BOARD_CONTEXT;
+  }
+
+  void Evaluate(const int* board, const int* const* hands, int num_hands,
+                int* ranks) const override {
+    plo4_board_context context;
+    init_plo4_board_context(&context, board);
+    for (int i = 0; i < num_hands; i++) {
+      ranks[i] = evaluate_plo4_hole(&context, plo4_hole_index(hands[i]));
+    }
+  }
+
+  // the hole's index is worked out once, for both boards.
+  void EvaluateBoards(const int* board1, const int* board2,
+                      const int* const* hands, int num_hands, int* ranks1,
+                      int* ranks2) const override {
+    plo4_board_context context1, context2;
+    init_plo4_board_context(&context1, board1);
+    init_plo4_board_context(&context2, board2);
+    for (int i = 0; i < num_hands; i++) {
+      const int hole = plo4_hole_index(hands[i]);
+      ranks1[i] = evaluate_plo4_hole(&context1, hole);
+      ranks2[i] = evaluate_plo4_hole(&context2, hole);
+    }
+  }
+};
+
+const HashTableEvaluator hash_table_evaluator;
+const BruteForceEvaluator brute_force_evaluator;
+const BoardContextEvaluator board_context_evaluator;
+
+const ShowdownEvaluator* const EVALUATORS[NUM_EVALUATOR_BACKENDS] = {
+    &hash_table_evaluator, &brute_force_evaluator, &board_context_evaluator};
+
+const char* const BACKEND_NAMES[NUM_EVALUATOR_BACKENDS + 1] = {
+    "hash", "brute", "context", "auto"};
+
+atomic<int> pinned_backend{EVALUATOR_AUTO};
+
+// Workload shapes are buckets of the number of hands at the showdown: heads
+// up, a few players, and a full table. Each is benchmarked with the number of
+// hands of its row.
+constexpr int NUM_SHAPES = 3;
+constexpr int SHAPE_HANDS[NUM_SHAPES] = {2, 4, 8};
+
+int shape_of(int num_hands) {
+  if (num_hands <= 2) return 0;
+  if (num_hands <= 5) return 1;
+  return 2;
+}
+
+// Random double board showdowns with num_hands hands each, from one deck so
+// no card is dealt twice in a showdown.
+struct Workload {
+  int num_hands;
+  vector<int> cards;  // 10 board cards then 4 per hand, per showdown
+  vector<const int*> hands;
+
+  Workload(int num_hands, int num_showdowns, CounterRng& rng)
+      : num_hands(num_hands) {
+    const int per_showdown = 10 + 4 * num_hands;
+    cards.resize(num_showdowns * per_showdown);
+    for (int s = 0; s < num_showdowns; s++) {
+      array<int, 52> deck;
+      for (int c = 0; c < 52; c++) deck[c] = c;
+      int* out = cards.data() + s * per_showdown;
+      for (int i = 0; i < per_showdown; i++) {
+        swap(deck[i], deck[i + rng.below(52 - i)]);
+        out[i] = deck[i];
+      }
+    }
+    for (int s = 0; s < num_showdowns; s++) {
+      for (int j = 0; j < num_hands; j++) {
+        hands.push_back(cards.data() + s * per_showdown + 10 + 4 * j);
+      }
+    }
+  }
+
+  int NumShowdowns() const { return hands.size() / num_hands; }
+
+  // Seconds for evaluator to rank every showdown, best of a few runs.
+  double Time(const ShowdownEvaluator& evaluator) const {
+    const int per_showdown = 10 + 4 * num_hands;
+    vector<int> ranks1(num_hands), ranks2(num_hands);
+    double best = 1e30;
+    for (int run = 0; run < 3; run++) {
+      const auto start = chrono::steady_clock::now();
+      for (int s = 0; s < NumShowdowns(); s++) {
+        const int* board = cards.data() + s * per_showdown;
+        evaluator.EvaluateBoards(board, board + 5, &hands[s * num_hands],
+                                 num_hands, ranks1.data(), ranks2.data());
+      }
+      const chrono::duration<double> elapsed =
+          chrono::steady_clock::now() - start;
+      best = min(best, elapsed.count());
+    }
+    return best;
+  }
+};
+
+// What the table backends need: the PLO4 tables (about 30MB), the hole major
+// copy of them and the hole keys, with some room to spare.
+constexpr long long TABLE_BACKEND_BYTES = 128ll << 20;
+
+// Bytes the system can still hand out without swapping, or -1 if it doesn't
+// say.
+long long available_memory() {
+  ifstream meminfo("/proc/meminfo");
+  string line;
+  while (getline(meminfo, line)) {
+    long long kb;
+    if (sscanf(line.c_str(), "MemAvailable: %lld kB", &kb) == 1) {
+      return kb * 1024;
+    }
+  }
+  return -1;
+}
+
+array<EvaluatorBackend, NUM_SHAPES> benchmark_shapes() {
+  CounterRng rng(0x5EED);
+
+  // brute needs no tables, so it's always there to fall back on. The table
+  // backends are only tried if their tables fit, and the first call of one
+  // loads (or generates) them, which mustn't count against it.
+  const Workload warmup(1, 1, rng);
+  warmup.Time(brute_force_evaluator);
+  vector<const ShowdownEvaluator*> candidates = {&brute_force_evaluator};
+  const long long available = available_memory();
+  if (available < 0 || available >= TABLE_BACKEND_BYTES) {
+    for (const ShowdownEvaluator* evaluator :
+         {(const ShowdownEvaluator*)&hash_table_evaluator,
+          (const ShowdownEvaluator*)&board_context_evaluator}) {
+      try {
+        warmup.Time(*evaluator);
+        candidates.push_back(evaluator);
+      } catch (const exception&) {
+        // e.g. out of memory: auto does without it.
+      }
+    }
+  }
+
+  array<EvaluatorBackend, NUM_SHAPES> fastest;
+  for (int shape = 0; shape < NUM_SHAPES; shape++) {
+    const Workload workload(SHAPE_HANDS[shape], 256, rng);
+    double best = 1e30;
+    for (const ShowdownEvaluator* evaluator : candidates) {
+      const double seconds = workload.Time(*evaluator);
+      if (seconds < best) {
+        best = seconds;
+        fastest[shape] = evaluator->Backend();
+      }
+    }
+  }
+  return fastest;
+}
+
+}  // namespace
+
+const ShowdownEvaluator& showdown_evaluator(EvaluatorBackend backend) {
+  if (backend < 0 || backend >= NUM_EVALUATOR_BACKENDS) {
+    throw runtime_error("Not an evaluator backend.");
+  }
+  return *EVALUATORS[backend];
+}
+
+EvaluatorBackend fastest_evaluator_backend(int num_hands) {
+  // benchmarked once, on first use. Static initialisation is thread safe.
+  static const array<EvaluatorBackend, NUM_SHAPES> fastest =
+      benchmark_shapes();
+  return fastest[shape_of(num_hands)];
+}
+
+void init_showdown_evaluators() {
+  if (evaluator_backend() == EVALUATOR_AUTO) {
+    fastest_evaluator_backend(2);
+  }
+}
+
+const ShowdownEvaluator& showdown_evaluator_for(int num_hands) {
+  const int pinned = pinned_backend.load(memory_order_relaxed);
+  if (pinned != EVALUATOR_AUTO) {
+    return *EVALUATORS[pinned];
+  }
+  return *EVALUATORS[fastest_evaluator_backend(num_hands)];
+}
+
+void set_evaluator_backend(EvaluatorBackend backend) {
+  if (backend < 0 || backend > EVALUATOR_AUTO) {
+    throw runtime_error("Not an evaluator backend.");
+  }
+  pinned_backend.store(backend, memory_order_relaxed);
+}
+
+EvaluatorBackend evaluator_backend() {
+  return (EvaluatorBackend)pinned_backend.load(memory_order_relaxed);
+}
+
+const char* evaluator_backend_name(EvaluatorBackend backend) {
+  if (backend < 0 || backend > EVALUATOR_AUTO) return "unknown";
+  return BACKEND_NAMES[backend];
+}
+
+bool parse_evaluator_backend(const string& name, EvaluatorBackend* backend) {
+  for (int b = 0; b <= EVALUATOR_AUTO; b++) {
+    if (name == BACKEND_NAMES[b]) {
+      *backend = (EvaluatorBackend)b;
+      return true;
+    }
+  }
+  return false;
+}
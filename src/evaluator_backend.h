@@ -0,0 +1,77 @@
+// evaluator_backend.h
+#pragma once
+
+#include <string>
+
+using namespace std;
+
+// PLO4 showdowns are ranked through a ShowdownEvaluator, so the way hands are
+// evaluated can be swapped without touching the callers. The backends trade
+// table memory for speed:
+// - HASH_TABLE: evaluate_plo4_cards per hand, i.e. two lookups in the PLO4
+//   tables (about 30MB once generated).
+// - BRUTE_FORCE: the best of the 60 (2 hole + 3 board) 5 card hands, from the
+//   5 card tables only. Much slower, but never loads the PLO4 tables, for
+//   machines that can't spare the memory.
+// - BOARD_CONTEXT: the board's hashes are computed once per board and each
+//   hand is looked up by its precomputed hole keys. Uses the PLO4 tables and
+//   a hole major copy of them.
+//
+// By default the backend is picked per workload shape (the number of hands at
+// the showdown) by timing every backend once, at startup. Where there isn't
+// the memory to spare for the tables, or loading them fails, only brute is
+// considered. set_evaluator_backend (or --evaluator on the command line) pins
+// one instead.
+enum EvaluatorBackend {
+  EVALUATOR_HASH_TABLE,
+  EVALUATOR_BRUTE_FORCE,
+  EVALUATOR_BOARD_CONTEXT,
+  NUM_EVALUATOR_BACKENDS,
+  // pick the fastest backend for each workload shape.
+  EVALUATOR_AUTO = NUM_EVALUATOR_BACKENDS
+};
+
+class ShowdownEvaluator {
+ public:
+  virtual ~ShowdownEvaluator() {}
+
+  virtual EvaluatorBackend Backend() const = 0;
+
+  // Ranks num_hands hands on one 5 card board. hands[i] points at 4 hole
+  // cards. Lower ranks are stronger, and every backend gives the same ranks.
+  virtual void Evaluate(const int* board, const int* const* hands,
+                        int num_hands, int* ranks) const = 0;
+
+  // Ranks the same hands on both boards of a double board showdown. Backends
+  // that do per hand work which doesn't depend on the board override this to
+  // do it only once.
+  virtual void EvaluateBoards(const int* board1, const int* board2,
+                              const int* const* hands, int num_hands,
+                              int* ranks1, int* ranks2) const {
+    Evaluate(board1, hands, num_hands, ranks1);
+    Evaluate(board2, hands, num_hands, ranks2);
+  }
+};
+
+// The evaluator for one backend (not EVALUATOR_AUTO).
+const ShowdownEvaluator& showdown_evaluator(EvaluatorBackend backend);
+
+// The evaluator to use for showdowns between num_hands hands. Thread safe.
+const ShowdownEvaluator& showdown_evaluator_for(int num_hands);
+
+// The backend the startup benchmark found fastest for num_hands hands. Runs
+// the benchmark the first time it is called.
+EvaluatorBackend fastest_evaluator_backend(int num_hands);
+
+// Runs the startup benchmark now, unless a backend is pinned, so it isn't
+// paid for inside the first showdown. main and Simulation::initialise call it.
+void init_showdown_evaluators();
+
+// Pins every showdown to backend, or goes back to picking per workload shape
+// with EVALUATOR_AUTO.
+void set_evaluator_backend(EvaluatorBackend backend);
+EvaluatorBackend evaluator_backend();
+
+// Names are "hash", "brute" and "context", and "auto" for EVALUATOR_AUTO.
+const char* evaluator_backend_name(EvaluatorBackend backend);
+bool parse_evaluator_backend(const string& name, EvaluatorBackend* backend);
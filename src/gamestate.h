@@ -1,34 +1,20 @@
 #pragma once
 #include <algorithm>
+#include <array>
 #include <exception>
 #include <iostream>
+#include <stdexcept>
 #include <utility>
 #include <vector>
 
+#include "action_tree.h"
 #include "deck.h"
 #include "equity_calc.h"
+#include "handaction.h"
 #include "player.h"
 
 using namespace std;
 
-// CHECK = CHECK
-// FOLD = FOLD
-// CALL = CALL
-// POT = POT
-// NOTHING = Cant do anything because all in, or folded
-enum HandAction { CHECK, FOLD, CALL, POT, NOTHING, MAX_HAND_ACTIONS };
-static constexpr const char* HandActionNames[] = {"CHECK", "FOLD", "CALL",
-                                                  "POT", "NOTHING"};
-
-inline string to_string(HandAction a) {
-  if (a >= 0 && a < MAX_HAND_ACTIONS) return HandActionNames[a];
-  return "UNKNOWN";
-}
-
-inline ostream& operator<<(ostream& os, HandAction a) {
-  return os << to_string(a);
-}
-
 class GameState {
  public:
   // Invariant: board1_[0] < board2_[0].
@@ -56,14 +42,28 @@ class GameState {
   // idx of the previous agressor. (-1 if no aggression this round yet)
   int previous_aggressor_ = -1;
 
+  // Bet sizes allowed, and the raises made so far this round.
+  BetSizing bet_sizing_;
+  int raises_this_round_ = 0;
+  double last_raise_ = 0.0;  // size of the largest raise this round (on top
+                             // of calling)
+
+  // Precompiled betting tree. When set, betting is read from the tree instead
+  // of being replayed: tree_node_ is the current node, and players_ only hold
+  // hands (pot_, bets_placed_, actioned_ and next_to_act_ are not updated).
+  const ActionTree* tree_ = nullptr;
+  int tree_node_ = 0;
+
   GameState() {}
   GameState(const vector<int>& board1, const vector<int>& board2,
-            int num_players, double stack_depth, double ante)
+            int num_players, double stack_depth, double ante,
+            const BetSizing& bet_sizing = BetSizing())
       : board1_(board1),
         board2_(board2),
         num_players_(num_players),
         stack_depth_(stack_depth),
-        ante_(ante) {
+        ante_(ante),
+        bet_sizing_(bet_sizing) {
     deck.erase(board1_);
     deck.erase(board2_);
     swap_boards_if_necessary();
@@ -79,24 +79,39 @@ class GameState {
     }
   }
 
-  // resets game state back to the flop
+  // resets game state back to the flop, and deals new hands.
+  // Reuses the existing storage, so resetting doesn't allocate.
   void reset() {
-    deck = Deck();
+    deck.reset();
     deck.erase(board1_);
     deck.erase(board2_);
 
-    players_.clear();
     next_to_act_ = 0;
     pot_ = 0.0;
-    bets_placed_.clear();
-    actioned_.clear();
+    players_.resize(num_players_, Player(vector<int>(), 0.0));
+    bets_placed_.assign(num_players_, 0.0);
+    actioned_.assign(num_players_, false);
     previous_aggressor_ = -1;
+    raises_this_round_ = 0;
+    last_raise_ = 0.0;
+    tree_node_ = 0;
 
-    for (int i = 0; i < num_players_; i++) {
-      add_player(stack_depth_, ante_);
+    // same as add_player, in place.
+    for (auto& player : players_) {
+      deck.deal_with_modification(4, player.hand);
+      player.money = stack_depth_ - ante_;
+      player.folded = false;
+      pot_ += ante_;
     }
   }
 
+  // Switches betting over to tree, which must be built for the same players,
+  // stack depth and ante. Should be called at the root (on the flop).
+  void use_action_tree(const ActionTree* tree) {
+    tree_ = tree;
+    tree_node_ = 0;
+  }
+
   void add_player(double stack_depth, double ante) {
     players_.push_back(
         Player(deck.deal_with_modification(4), stack_depth - ante));
@@ -108,6 +123,10 @@ class GameState {
 
   // Whether or not we are at game end (termination).
   bool end_of_game() {
+    if (tree_ != nullptr) {
+      return tree_->IsTerminal(tree_node_);
+    }
+
     if (board1_.size() == 5 && end_of_action()) {
       return true;
     }
@@ -133,6 +152,10 @@ class GameState {
   // whether or not we are at the end of action for a betting round
   // (flop/turn/river)
   bool end_of_action() {
+    if (tree_ != nullptr) {
+      return tree_->Type(tree_node_) != ActionTree::DECISION;
+    }
+
     for (int i = 0; i < players_.size(); i++) {
       if (!actioned_[i]) {
         return false;
@@ -175,16 +198,54 @@ class GameState {
     return pot_bet;
   }
 
+  // Calculates the amount player_idx puts in for an aggressive action
+  // (including calling), limited by the pot and their stack.
+  double calculate_bet(int player_idx, HandAction action) {
+    double call_amount = calculate_call(player_idx);
+    double pot_bet = calculate_pot_bet(player_idx);
+    double money = players_[player_idx].get_money();
+
+    double cost;
+    if (action == MIN_RAISE) {
+      // the ante plays the role of the big blind.
+      cost = call_amount + max(last_raise_, ante_);
+    } else {
+      cost = call_amount + pot_fraction(action) * (pot_ + call_amount);
+    }
+    cost = min(cost, pot_bet);
+
+    // all in is only possible if the pot limit allows it.
+    if (bet_sizing_.all_in_threshold > 0 && money <= pot_bet &&
+        cost >= bet_sizing_.all_in_threshold * money) {
+      cost = money;
+    }
+
+    return min(cost, money);
+  }
+
   // Deals out one card to each board.
   // Sets first to act to SB.
   // returns {card dealt to board1_, card dealt to board2_}
   pair<int, int> next_street() {
     int c1 = deck.deal();
     int c2 = deck.deal();
+    return deal_street(c1, c2);
+  }
 
+  // Same as next_street, but deals the given cards. Doesn't touch the deck,
+  // so the caller must make sure c1 and c2 aren't in it.
+  pair<int, int> deal_street(int c1, int c2) {
     board1_.push_back(c1);
     board2_.push_back(c2);
 
+    if (tree_ != nullptr) {
+      // calculate_ev also deals out the board from terminal nodes.
+      if (tree_->IsChance(tree_node_)) {
+        tree_node_ = tree_->ChanceChild(tree_node_);
+      }
+      return {c1, c2};
+    }
+
     for (int i = 0; i < players_.size(); i++) {
       pot_ += bets_placed_[i];
       bets_placed_[i] = 0;
@@ -205,9 +266,22 @@ class GameState {
     }
 
     previous_aggressor_ = -1;
+    raises_this_round_ = 0;
+    last_raise_ = 0.0;
     return {c1, c2};
   }
 
+  // Relabels suits of every card in the game (boards, hands and deck).
+  // Used to move into a suit-isomorphic representative of the current deal.
+  void permute_suits(const SuitPermutation& perm) {
+    permute_cards(board1_, perm);
+    permute_cards(board2_, perm);
+    permute_cards(deck.cards, perm);
+    for (auto& player : players_) {
+      permute_cards(player.hand, perm);
+    }
+  }
+
   // calculates who is next to act, and sets next_to_act_ to that person.
   void set_next_to_act() {
     if (end_of_action()) {
@@ -230,10 +304,41 @@ class GameState {
     }
   }
 
-  int get_next_to_act() const { return next_to_act_; }
+  int get_next_to_act() const {
+    if (tree_ != nullptr) {
+      return tree_->NextToAct(tree_node_);
+    }
+    return next_to_act_;
+  }
+
+  bool is_folded(int player_idx) {
+    if (tree_ != nullptr) {
+      return tree_->IsFolded(tree_node_, player_idx);
+    }
+    return players_[player_idx].is_folded();
+  }
+
+  double get_pot() const {
+    if (tree_ != nullptr) {
+      return tree_->Pot(tree_node_);
+    }
+    return pot_;
+  }
 
   // Performs a given action, on the current node.
+  // With an action tree, throws if the action isn't in the node's menu.
   void do_next_action(HandAction action) {
+    if (tree_ != nullptr) {
+      const int child = tree_->ChildByAction(tree_node_, action);
+      if (child < 0) {
+        throw runtime_error("Action " + to_string(action) +
+                            " isn't legal at action tree node " +
+                            std::to_string(tree_node_) + ".");
+      }
+      tree_node_ = child;
+      return;
+    }
+
     Player& player = players_[next_to_act_];  // MUST BE A REFERENCE
 
     switch (action) {
@@ -255,13 +360,19 @@ class GameState {
         pot_ += cost;
         break;
       }
-      case POT: {
-        double cost = min(player.get_money(), calculate_pot_bet(next_to_act_));
+      case POT:
+      case BET_33:
+      case BET_50:
+      case BET_75:
+      case MIN_RAISE: {
+        double cost = calculate_bet(next_to_act_, action);
+        last_raise_ = max(last_raise_, cost - calculate_call(next_to_act_));
 
         bets_placed_[next_to_act_] += cost;
         player.subtract_money(cost);
 
         previous_aggressor_ = next_to_act_;
+        raises_this_round_++;
         reopen_action(next_to_act_);
 
         pot_ += cost;
@@ -280,35 +391,32 @@ class GameState {
   // ev is the amount of chips that they should have at showdown.
   // terminal nodes aren't just river - if everyone folds on the flop to an
   // agressor that is also a terminal node.
-  vector<double> calculate_ev(bool debug = false) {
+  // MaxPlayers is the solver's compile time seat count (at least
+  // players_.size()); seats past players_.size() get 0.
+  template <int MaxPlayers>
+  array<double, MaxPlayers> calculate_ev(bool debug = false) {
     // deal out the remainder of the board if necessary
     while (board1_.size() != 5) {
       next_street();
     }
 
-    vector<vector<int>> hands;
-
-    for (auto& player : players_) {
-      if (!player.is_folded()) {
-        hands.push_back(player.get_hand());
+    array<const int*, MaxPlayers> hands{};
+    for (int j = 0; j < players_.size(); j++) {
+      if (!is_folded(j)) {
+        hands[j] = players_[j].hand.data();
       }
     }
 
-    vector<double> equities = equity_calc(hands, board1_, board2_);
-    vector<double> evs(players_.size());
+    array<double, MaxPlayers> evs =
+        equity_calc<MaxPlayers>(hands, board1_.data(), board2_.data());
 
-    int i = 0;
-    for (int j = 0; j < players_.size(); j++) {
-      if (!players_[j].is_folded()) {
-        evs[j] = equities[i] * pot_;
-        i++;
-      } else {
-        evs[j] = 0.0;
-      }
+    const double pot = get_pot();
+    for (int j = 0; j < MaxPlayers; j++) {
+      evs[j] *= pot;
     }
 
     if (debug) {
-      for (int j = 0; j < evs.size(); j++) {
+      for (int j = 0; j < players_.size(); j++) {
         cout << "Player " << j << " ev: " << evs[j] << endl;
       }
     }
@@ -318,6 +426,15 @@ class GameState {
   // Obtains the uniform (default) strategy for the current next-to-act player.
   // Each allowed action has equal probability
   vector<pair<HandAction, double>> GetUniformStrategy() {
+    if (tree_ != nullptr) {
+      const int n = tree_->NumActions(tree_node_);
+      vector<pair<HandAction, double>> strat;
+      for (int i = 0; i < n; i++) {
+        strat.push_back({tree_->Action(tree_node_, i), 1.0 / (double)n});
+      }
+      return strat;
+    }
+
     Player player = players_[next_to_act_];
 
     if (player.is_folded() || player.is_all_in()) {
@@ -326,10 +443,29 @@ class GameState {
 
     vector<HandAction> available;
 
-    // pot/repot (same thing).
+    // bets/raises from the bet size menu.
     // player can reraise as long as they can afford more than just calling.
-    if (player.get_money() >= calculate_call(next_to_act_)) {
-      available.push_back(POT);
+    // sizes that come to the same amount (e.g. both capped to all in) are
+    // only offered once.
+    if (player.get_money() >= calculate_call(next_to_act_) &&
+        raises_this_round_ < bet_sizing_.raise_cap) {
+      const int street = board1_.size() - 3;
+      uint16_t allowed = bet_sizing_.Allowed(street, raises_this_round_);
+
+      vector<double> costs;
+      // POT first, then the smaller sizes.
+      for (HandAction action : {POT, BET_75, BET_50, BET_33, MIN_RAISE}) {
+        if (!(allowed & action_bit(action))) {
+          continue;
+        }
+
+        double cost = calculate_bet(next_to_act_, action);
+        if (find(costs.begin(), costs.end(), cost) != costs.end()) {
+          continue;
+        }
+        costs.push_back(cost);
+        available.push_back(action);
+      }
     }
 
     if (previous_aggressor_ == -1) {
@@ -10,6 +10,7 @@
 
 #include "backends/imgui_impl_glfw.h"
 #include "backends/imgui_impl_opengl3.h"
+#include "chancenode.h"
 #include "imgui.h"
 #include "node.h"
 #include "simulation.h"
@@ -23,7 +24,8 @@ class View {
   // GUI node ID, to solver Node*
   unordered_map<int, Node*> gui_node_to_solver_node_;
 
-  unordered_map<int, vector<pair<int, HandAction>>> gui_node_children_;
+  // GUI node ID -> {child GUI node ID, label}
+  unordered_map<int, vector<pair<int, string>>> gui_node_children_;
   unordered_map<int, int> gui_node_parent_;
 
   // is the node in the dropdown open
@@ -111,26 +113,37 @@ class View {
     if (gui_node_is_open_[node_id] && is_open) {
       // draw children recursively if they exist
       if (!gui_node_children_[node_id].empty()) {
-        for (const auto& [child_id, action] : gui_node_children_[node_id]) {
-          string label = gui_node_to_solver_node_[node_id]->GetTablePosition() +
-                         ": " + to_string(action);
-
-          DrawNode(child_id, label);
+        for (const auto& [child_id, child_label] :
+             gui_node_children_[node_id]) {
+          DrawNode(child_id, child_label);
         }
       } else {
         // otherwise, this is a leaf node, and create new children (which are
         // closed)
         Node* solver_node = gui_node_to_solver_node_[node_id];
 
-        for (const auto& [action, child_node] : solver_node->children) {
+        auto add_child = [&](Node* child_node, const string& child_label) {
           int new_node_id = gui_node_to_solver_node_.size();
           gui_node_to_solver_node_[new_node_id] = child_node;
           gui_node_parent_[new_node_id] = node_id;
-          gui_node_children_[node_id].push_back({new_node_id, action});
-
-          string label = gui_node_to_solver_node_[node_id]->GetTablePosition() +
-                         ": " + to_string(action);
-          DrawNode(new_node_id, label);
+          gui_node_children_[node_id].push_back({new_node_id, child_label});
+          DrawNode(new_node_id, child_label);
+        };
+
+        if (auto chance_node = dynamic_cast<ChanceNode*>(solver_node)) {
+          // runouts dealt so far, in card order.
+          for (const auto& runout : chance_node->GetRunouts()) {
+            string child_label =
+                "Deal: " + cards_to_string({runout.top_card}) + " / " +
+                cards_to_string({runout.bottom_card}) + " (x" +
+                to_string(runout.weight) + ")";
+            add_child(runout.node, child_label);
+          }
+        } else {
+          for (const auto& [action, child_node] : solver_node->children) {
+            add_child(child_node, solver_node->GetTablePosition() + ": " +
+                                      to_string(action));
+          }
         }
       }
 
@@ -224,31 +237,35 @@ class View {
 
       Node* focus = simulation_.GetFocus();
 
-      // !!!
-      // reference, or directly iterating through focus->strategy is much faster
-      // copying, or using a mutex, is quite slow.
-      // fastest way is probably to use a mutex and iterate through the map
-      // (because we are only displaying like 50 at a time).
-      unordered_map<int, vector<pair<HandAction, double>>>& node_strategy =
-          focus->strategy;
-      //{
-      //	lock_guard<mutex> lock(focus->mtx);
-      //	node_strategy = focus->strategy;
-      //}
-
-      ImGui::Text("Current node: %s, hands: %d",
-                  focus->GetTablePosition().c_str(), node_strategy.size());
+      // the solver thread owns the node's rows, so read the focus's latest
+      // published snapshot. it's immutable, and only the rows displayed are
+      // touched.
+      shared_ptr<const StrategySnapshot> snapshot =
+          simulation_.GetStrategySnapshot();
+      static const vector<StrategySnapshot::Row> no_rows;
+      const vector<StrategySnapshot::Row>& rows =
+          (snapshot != nullptr && snapshot->node == focus) ? snapshot->rows
+                                                           : no_rows;
+
+      ImGui::Text("Current node: %s, hands: %d, iteration: %lld",
+                  focus->GetTablePosition().c_str(), (int)rows.size(),
+                  snapshot != nullptr ? snapshot->iteration : 0ll);
 
       static char buf_search[128] = "";
       ImGui::InputText("Search", buf_search, IM_ARRAYSIZE(buf_search));
       string search_term = string(buf_search);
 
-      if (ImGui::BeginTable("table1", 6)) {
+      if (ImGui::BeginTable("table1", 7)) {
         // Display the strategy for this node.
 
-        for (const auto& [handhash, strat] : node_strategy) {
+        for (const auto& row : rows) {
+          const int handhash = row.handhash;
+
           // search filter.
-          string hand_string = hand_hash_to_string(handhash);
+          string hand_string =
+              is_bucket_key(handhash)
+                  ? "Bucket " + to_string(bucket_from_key(handhash))
+                  : hand_index_to_string(handhash);
           if (hand_string.find(search_term) == string::npos) {
             continue;
           }
@@ -258,8 +275,7 @@ class View {
           ImGui::TableSetColumnIndex(0);
           ImGui::Text("Hand: %s", hand_string.c_str());
 
-          unordered_map<HandAction, double> strategymap(strat.begin(),
-                                                        strat.end());
+          const auto& strategymap = row.probability;
 
           ImGui::TableSetColumnIndex(1);
           ImGui::Text("Check/Call: %f", strategymap[HandAction::CHECK] +
@@ -268,17 +284,21 @@ class View {
           ImGui::TableSetColumnIndex(2);
           ImGui::Text("Pot: %f", strategymap[HandAction::POT]);
 
+          // smaller sizes from the bet size menu.
           ImGui::TableSetColumnIndex(3);
-          ImGui::Text("Fold: %f", strategymap[HandAction::FOLD]);
+          ImGui::Text("Bet: %f", strategymap[HandAction::BET_75] +
+                                     strategymap[HandAction::BET_50] +
+                                     strategymap[HandAction::BET_33] +
+                                     strategymap[HandAction::MIN_RAISE]);
 
           ImGui::TableSetColumnIndex(4);
-          ImGui::Text("Nothing: %f", strategymap[HandAction::NOTHING]);
+          ImGui::Text("Fold: %f", strategymap[HandAction::FOLD]);
 
           ImGui::TableSetColumnIndex(5);
-          auto it = focus->visit_count_.find(handhash);
+          ImGui::Text("Nothing: %f", strategymap[HandAction::NOTHING]);
 
-          ImGui::Text("Visits: %f",
-                      (it != focus->visit_count_.end()) ? it->second : 0.0f);
+          ImGui::TableSetColumnIndex(6);
+          ImGui::Text("Visits: %f", row.visits);
 
           strategy_rows_displayed++;
           if (strategy_rows_displayed >= strategy_max_rows) {
@@ -290,6 +310,20 @@ class View {
       }
     }
 
+    const string focus_error = simulation_.GetFocusError();
+    if (!focus_error.empty()) {
+      ImGui::Text("Solving from the root, the focus failed: %s",
+                  focus_error.c_str());
+    }
+
+    // Pruning counters
+    PruningStats pruning = simulation_.GetPruningStats();
+    if (pruning.pruned_decisions > 0) {
+      ImGui::Text("Pruned: %lld / %lld decisions, %lld subtrees skipped",
+                  pruning.pruned_decisions, pruning.decisions,
+                  pruning.pruned_subtrees);
+    }
+
     // FPS counter
     float fps = ImGui::GetIO().Framerate;
     ImGui::Text("FPS: %.1f", fps);
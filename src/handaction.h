@@ -0,0 +1,106 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+// CHECK = CHECK
+// FOLD = FOLD
+// CALL = CALL
+// POT = POT
+// NOTHING = Cant do anything because all in, or folded
+// BET_33/BET_50/BET_75 = bet/raise a fraction of the pot (after calling)
+// MIN_RAISE = smallest legal bet/raise
+enum HandAction {
+  CHECK,
+  FOLD,
+  CALL,
+  POT,
+  NOTHING,
+  BET_33,
+  BET_50,
+  BET_75,
+  MIN_RAISE,
+  MAX_HAND_ACTIONS
+};
+static constexpr const char* HandActionNames[] = {
+    "CHECK", "FOLD", "CALL", "POT", "NOTHING", "BET33", "BET50", "BET75",
+    "MINRAISE"};
+
+inline string to_string(HandAction a) {
+  if (a >= 0 && a < MAX_HAND_ACTIONS) return HandActionNames[a];
+  return "UNKNOWN";
+}
+
+inline ostream& operator<<(ostream& os, HandAction a) {
+  return os << to_string(a);
+}
+
+// Whether the action is a bet or raise (it reopens the action).
+inline bool is_aggressive(HandAction a) {
+  return a == POT || a == BET_33 || a == BET_50 || a == BET_75 ||
+         a == MIN_RAISE;
+}
+
+// Fraction of the pot (after calling) that a sized bet raises by.
+// 0 for actions that aren't pot fraction bets.
+inline double pot_fraction(HandAction a) {
+  switch (a) {
+    case BET_33:
+      return 1.0 / 3.0;
+    case BET_50:
+      return 0.5;
+    case BET_75:
+      return 0.75;
+    case POT:
+      return 1.0;
+    default:
+      return 0.0;
+  }
+}
+
+// Bit for an action in a BetSizing mask.
+constexpr uint16_t action_bit(HandAction a) { return 1 << a; }
+
+// BetSizing is the menu of bet sizes allowed, by street and raise depth.
+// Raise depth is the number of bets/raises already made in the betting
+// round (0 = opening bet, 1 = raise, 2 = reraise, ...). Depths past the last
+// row use the last row.
+//
+// Sizes are stored as bitmasks of aggressive HandActions, so the whole menu
+// is a few dozen bytes and can be copied with the game state.
+struct BetSizing {
+  static constexpr int NUM_STREETS = 3;
+  static constexpr int MAX_RAISE_DEPTH = 4;
+
+  // sizes[street][depth] = mask of allowed aggressive actions.
+  array<array<uint16_t, MAX_RAISE_DEPTH>, NUM_STREETS> sizes;
+
+  // no more bets/raises once this many have been made in a betting round.
+  uint8_t raise_cap = 255;
+
+  // A bet that would put in at least this fraction of the player's remaining
+  // stack is turned into an all in (if the pot limit allows it).
+  // 0 disables.
+  float all_in_threshold = 0.0f;
+
+  // Default is the POT only menu.
+  BetSizing() { SetAll(action_bit(POT)); }
+
+  // Allows mask on every street and raise depth.
+  void SetAll(uint16_t mask) {
+    for (auto& street : sizes) {
+      street.fill(mask);
+    }
+  }
+
+  uint16_t Allowed(int street, int raise_depth) const {
+    if (raise_depth >= MAX_RAISE_DEPTH) {
+      raise_depth = MAX_RAISE_DEPTH - 1;
+    }
+    return sizes[street][raise_depth];
+  }
+};
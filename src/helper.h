@@ -1,13 +1,19 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <cmath>
-#include <random>
+#include <cstdint>
 #include <stdexcept>
 #include <string>
 #include <vector>
 
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
 #include "include/phevaluator.h"
+#include "rng.h"
 
 using namespace std;
 
@@ -44,34 +50,125 @@ inline vector<int> string_to_cards(string s) {
   return cards;
 }
 
-// Random double range [min, max]
+// Random float range [0, 1). Uses the top 24 bits, which fill the mantissa.
+inline float rand_float() {
+  return (float)(thread_rng().next() >> 8) * (1.0f / 16777216.0f);
+}
+
+// Random double range [0, 1). Uses 53 bits from two draws, enough to pick
+// from a cumulative sum over every hand, which a float can't resolve.
+inline double rand_double() {
+  const uint64_t high = thread_rng().next() >> 5;  // 27 bits
+  const uint64_t low = thread_rng().next() >> 6;   // 26 bits
+  return (double)((high << 26) | low) * (1.0 / 9007199254740992.0);
+}
+
+// Random double range [min, max)
 inline double rand_double(double min, double max) {
-  static thread_local std::mt19937 gen(
-      std::random_device{}());  // Thread-local random engine
-  std::uniform_real_distribution<double> dis(min, max);  // Uniform distribution
-  return dis(gen);
+  return min + (max - min) * rand_double();
+}
+
+// Number of 4 card hands, C(52, 4).
+constexpr int NUM_HANDS = 270725;
+
+// HAND_CHOOSE[k][n] = C(n, k), for ranking 4 card hands.
+constexpr array<array<int, 53>, 5> make_hand_choose_table() {
+  array<array<int, 53>, 5> table{};
+  for (int n = 0; n <= 52; n++) {
+    table[0][n] = 1;
+    for (int k = 1; k <= 4; k++) {
+      table[k][n] = n == 0 ? 0 : table[k][n - 1] + table[k - 1][n - 1];
+    }
+  }
+  return table;
+}
+constexpr array<array<int, 53>, 5> HAND_CHOOSE = make_hand_choose_table();
+
+// Index of the lowest set bit. mask must not be 0.
+inline int lowest_card(uint64_t mask) {
+#ifdef _MSC_VER
+  unsigned long index;
+  _BitScanForward64(&index, mask);
+  return index;
+#else
+  return __builtin_ctzll(mask);
+#endif
 }
 
-// hashes hand to a unique number.
-// Hand should be length exactly 4.
-// todo: more efficient hashing system.
-inline int hand_hash(vector<int> hand) {
-  // sort ascending order.
-  sort(hand.begin(), hand.end());
+// hand_index ranks a 4 card hand, given as a mask with exactly 4 bits set, in
+// colex order: C(c0, 1) + C(c1, 2) + C(c2, 3) + C(c3, 4) for cards
+// c0 < c1 < c2 < c3. This is a bijection onto [0, NUM_HANDS), so it can index
+// dense tables. No branches - just 4 bit scans and table lookups.
+inline int hand_index(uint64_t mask) {
+  const int c0 = lowest_card(mask);
+  mask &= mask - 1;
+  const int c1 = lowest_card(mask);
+  mask &= mask - 1;
+  const int c2 = lowest_card(mask);
+  mask &= mask - 1;
+  const int c3 = lowest_card(mask);
+  return c0 + HAND_CHOOSE[2][c1] + HAND_CHOOSE[3][c2] + HAND_CHOOSE[4][c3];
+}
+
+// Hand should be length exactly 4 (any order).
+inline int hand_index(const vector<int>& hand) {
+  return hand_index((1ull << hand[0]) | (1ull << hand[1]) |
+                    (1ull << hand[2]) | (1ull << hand[3]));
+}
 
-  int hash =
-      hand[0] + 52 * hand[1] + 52 * 52 * hand[2] + 52 * 52 * 52 * hand[3];
+// hand_from_index is the inverse of hand_index. Cards are ascending.
+inline array<int, 4> hand_from_index(int index) {
+  array<int, 4> hand;
+  for (int k = 4; k >= 1; k--) {
+    // largest card c with C(c, k) <= index.
+    const auto& row = HAND_CHOOSE[k];
+    int c = upper_bound(row.begin(), row.begin() + 52, index) - row.begin() - 1;
+    hand[k - 1] = c;
+    index -= row[c];
+  }
+  return hand;
+}
 
-  return hash;
+inline string hand_index_to_string(int index) {
+  array<int, 4> hand = hand_from_index(index);
+  return cards_to_string(vector<int>(hand.begin(), hand.end()));
 }
 
-inline string hand_hash_to_string(int hash) {
-  vector<int> hand;
+// SuitPermutation maps suit s to suit perm[s].
+using SuitPermutation = array<int, 4>;
 
-  for (int i = 3; i >= 0; i--) {
-    hand.push_back(hash / (int)(pow(52, i)));
-    hash = hash % (int)pow(52, i);
+inline int permute_card(int card, const SuitPermutation& perm) {
+  return (card & ~0x3) | perm[card & 0x3];
+}
+
+inline void permute_cards(vector<int>& cards, const SuitPermutation& perm) {
+  for (auto& c : cards) {
+    c = permute_card(c, perm);
   }
+}
 
-  return cards_to_string(hand);
-}
\ No newline at end of file
+// board_symmetries returns every suit permutation that maps each board onto
+// itself (as a set of cards). The identity is always first.
+inline vector<SuitPermutation> board_symmetries(const vector<int>& board1,
+                                                const vector<int>& board2) {
+  auto mask = [](const vector<int>& cards, const SuitPermutation& perm) {
+    uint64_t m = 0;
+    for (int c : cards) {
+      m |= 1ull << permute_card(c, perm);
+    }
+    return m;
+  };
+
+  SuitPermutation perm = {0, 1, 2, 3};
+  const uint64_t mask1 = mask(board1, perm);
+  const uint64_t mask2 = mask(board2, perm);
+
+  vector<SuitPermutation> symmetries;
+  do {
+    if (mask(board1, perm) == mask1 && mask(board2, perm) == mask2) {
+      symmetries.push_back(perm);
+    }
+  } while (next_permutation(perm.begin(), perm.end()));
+
+  return symmetries;
+}
@@ -0,0 +1,229 @@
+// kernels.cpp
+#include "kernels.h"
+
+#include <algorithm>
+
+#ifdef PHEVALUATOR_X86_TARGETS
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+static unsigned showdown_winners_scalar(const int* ranks) {
+  int best = INT_MAX;
+  unsigned winners = 0;
+  for (int seat = 0; seat < MAX_SEATS; seat++) {
+    if (ranks[seat] < best) {
+      best = ranks[seat];
+      winners = 1u << seat;
+    } else if (ranks[seat] == best) {
+      winners |= 1u << seat;
+    }
+  }
+  return winners;
+}
+
+// Summed in order on every level, so the strategy is bit identical whichever
+// kernel runs: only the divide is vectorised.
+static inline double positive_regret_sum(const double* regrets, int n) {
+  double sum = 0.0;
+  for (int i = 0; i < n; i++) {
+    sum += max(regrets[i], 0.0);
+  }
+  return sum;
+}
+
+static bool regret_match_scalar(const double* regrets, int n,
+                                double* strategy) {
+  const double sum = positive_regret_sum(regrets, n);
+  if (sum <= 0.0) {
+    return false;
+  }
+
+  for (int i = 0; i < n; i++) {
+    strategy[i] = max(regrets[i], 0.0) / sum;
+  }
+  return true;
+}
+
+#ifdef PHEVALUATOR_X86_TARGETS
+
+#define SSE42_TARGET "sse4.2,popcnt"
+#define AVX2_TARGET "avx2,fma,bmi,bmi2"
+#define AVX512_TARGET AVX2_TARGET ",avx512f,avx512bw,avx512dq,avx512vl"
+
+// The best rank is found with a min reduction, then the winners are the
+// lanes equal to it.
+PHEVALUATOR_TARGET(SSE42_TARGET)
+static unsigned showdown_winners_sse42(const int* ranks) {
+  __m128i r[4];
+  for (int i = 0; i < 4; i++) {
+    r[i] = _mm_loadu_si128((const __m128i*)(ranks + i * 4));
+  }
+
+  __m128i best = _mm_min_epi32(_mm_min_epi32(r[0], r[1]),
+                               _mm_min_epi32(r[2], r[3]));
+  best = _mm_min_epi32(best, _mm_shuffle_epi32(best, 0x4E));
+  best = _mm_min_epi32(best, _mm_shuffle_epi32(best, 0xB1));
+
+  unsigned winners = 0;
+  for (int i = 0; i < 4; i++) {
+    winners |= (unsigned)_mm_movemask_ps(
+                   _mm_castsi128_ps(_mm_cmpeq_epi32(r[i], best)))
+               << (i * 4);
+  }
+  return winners;
+}
+
+PHEVALUATOR_TARGET(AVX2_TARGET)
+static unsigned showdown_winners_avx2(const int* ranks) {
+  const __m256i lo = _mm256_loadu_si256((const __m256i*)ranks);
+  const __m256i hi = _mm256_loadu_si256((const __m256i*)(ranks + 8));
+
+  __m256i best = _mm256_min_epi32(lo, hi);
+  best = _mm256_min_epi32(best, _mm256_permute2x128_si256(best, best, 0x01));
+  best = _mm256_min_epi32(best, _mm256_shuffle_epi32(best, 0x4E));
+  best = _mm256_min_epi32(best, _mm256_shuffle_epi32(best, 0xB1));
+
+  const unsigned winners_lo = _mm256_movemask_ps(
+      _mm256_castsi256_ps(_mm256_cmpeq_epi32(lo, best)));
+  const unsigned winners_hi = _mm256_movemask_ps(
+      _mm256_castsi256_ps(_mm256_cmpeq_epi32(hi, best)));
+  return winners_lo | (winners_hi << 8);
+}
+
+// GCC 12 warns that the undefined operand the AVX-512 intrinsics pass to
+// their unmasked builtins may be used uninitialized. It is never read.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+PHEVALUATOR_TARGET(AVX512_TARGET)
+static unsigned showdown_winners_avx512(const int* ranks) {
+  const __m512i r = _mm512_loadu_si512(ranks);
+  const __m512i best = _mm512_set1_epi32(_mm512_reduce_min_epi32(r));
+  return _mm512_cmpeq_epi32_mask(r, best);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+// max(0, r) keeps r when it isn't negative, like max(r, 0.0) does for -0.0
+// and NaN.
+PHEVALUATOR_TARGET(SSE42_TARGET)
+static bool regret_match_sse42(const double* regrets, int n,
+                               double* strategy) {
+  const double sum = positive_regret_sum(regrets, n);
+  if (sum <= 0.0) {
+    return false;
+  }
+
+  const __m128d zero = _mm_setzero_pd();
+  const __m128d total = _mm_set1_pd(sum);
+  int i = 0;
+  for (; i + 2 <= n; i += 2) {
+    _mm_storeu_pd(strategy + i,
+                  _mm_div_pd(_mm_max_pd(zero, _mm_loadu_pd(regrets + i)),
+                             total));
+  }
+  for (; i < n; i++) {
+    strategy[i] = max(regrets[i], 0.0) / sum;
+  }
+  return true;
+}
+
+// lanes [0, count) of a vector of 4 doubles.
+PHEVALUATOR_TARGET(AVX2_TARGET)
+static PHEVALUATOR_INLINE __m256i tail_avx2(int count) {
+  return _mm256_cmpgt_epi64(_mm256_set1_epi64x(count),
+                            _mm256_setr_epi64x(0, 1, 2, 3));
+}
+
+PHEVALUATOR_TARGET(AVX2_TARGET)
+static bool regret_match_avx2(const double* regrets, int n,
+                              double* strategy) {
+  const double sum = positive_regret_sum(regrets, n);
+  if (sum <= 0.0) {
+    return false;
+  }
+
+  const __m256d zero = _mm256_setzero_pd();
+  const __m256d total = _mm256_set1_pd(sum);
+  for (int i = 0; i < n; i += 4) {
+    const __m256i mask = tail_avx2(n - i);
+    const __m256d r = _mm256_maskload_pd(regrets + i, mask);
+    _mm256_maskstore_pd(strategy + i, mask,
+                        _mm256_div_pd(_mm256_max_pd(zero, r), total));
+  }
+  return true;
+}
+
+// lanes [0, count) of a vector of 8 doubles.
+static inline __mmask8 tail_avx512(int count) {
+  return (__mmask8)(count >= 8 ? 0xFF : (1u << count) - 1);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+PHEVALUATOR_TARGET(AVX512_TARGET)
+static bool regret_match_avx512(const double* regrets, int n,
+                                double* strategy) {
+  const double sum = positive_regret_sum(regrets, n);
+  if (sum <= 0.0) {
+    return false;
+  }
+
+  const __m512d zero = _mm512_setzero_pd();
+  const __m512d total = _mm512_set1_pd(sum);
+  for (int i = 0; i < n; i += 8) {
+    const __mmask8 mask = tail_avx512(n - i);
+    const __m512d r = _mm512_maskz_loadu_pd(mask, regrets + i);
+    _mm512_mask_storeu_pd(strategy + i, mask,
+                          _mm512_div_pd(_mm512_max_pd(zero, r), total));
+  }
+  return true;
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+static const phevaluator::DispatchedKernel<unsigned (*)(const int*)>
+    showdown_winners_kernel = {{showdown_winners_scalar,
+                                showdown_winners_sse42, showdown_winners_avx2,
+                                showdown_winners_avx512}};
+
+static const phevaluator::DispatchedKernel<bool (*)(const double*, int,
+                                                    double*)>
+    regret_match_kernel = {{regret_match_scalar, regret_match_sse42,
+                            regret_match_avx2, regret_match_avx512}};
+
+#else
+
+static const phevaluator::DispatchedKernel<unsigned (*)(const int*)>
+    showdown_winners_kernel = {{showdown_winners_scalar,
+                                showdown_winners_scalar,
+                                showdown_winners_scalar,
+                                showdown_winners_scalar}};
+
+static const phevaluator::DispatchedKernel<bool (*)(const double*, int,
+                                                    double*)>
+    regret_match_kernel = {{regret_match_scalar, regret_match_scalar,
+                            regret_match_scalar, regret_match_scalar}};
+
+#endif
+
+unsigned showdown_winners(const int* ranks) {
+  return showdown_winners_kernel.get()(ranks);
+}
+
+bool regret_match(const double* regrets, int n, double* strategy) {
+  return regret_match_kernel.get()(regrets, n, strategy);
+}
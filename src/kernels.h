@@ -0,0 +1,26 @@
+// kernels.h
+#pragma once
+
+#include <climits>
+
+#include "src/cpu_features.h"
+
+using namespace std;
+
+// Hot loops of the solver that have a version per cpu_level. Calls go to the
+// version for the current dispatch level, see
+// phevaluator/src/cpu_features.h.
+
+// Showdowns are done over a fixed row of seats, so every version does the
+// same (branch free) work. Seats that are empty or folded hold NO_SEAT_RANK.
+static constexpr int MAX_SEATS = 16;
+static constexpr int NO_SEAT_RANK = INT_MAX;
+
+// Seats with the best (lowest) rank in ranks[0..MAX_SEATS), as a bitmask.
+unsigned showdown_winners(const int* ranks);
+
+// Regret matching over n actions: strategy[i] = max(regrets[i], 0) / (sum of
+// the positive regrets). Returns false, and leaves strategy alone, if no
+// regret is positive. Every level adds the regrets up in the same order, so
+// the strategy is bit identical to the scalar one.
+bool regret_match(const double* regrets, int n, double* strategy);
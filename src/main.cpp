@@ -1,7 +1,38 @@
+#include <cstring>
+#include <iostream>
+
+#include "evaluator_backend.h"
 #include "gui.h"
+#include "include/phevaluator.h"
 
 using namespace std;
-int main() {
+int main(int argc, char** argv) {
+  // --isa=<scalar|sse4.2|avx2|avx512> caps the SIMD kernels, e.g. to compare
+  // them. Levels the cpu doesn't have fall back to the best one it does.
+  for (int i = 1; i < argc; i++) {
+    cpu_level level;
+    if (strncmp(argv[i], "--isa=", 6) == 0 &&
+        parse_cpu_level(argv[i] + 6, &level)) {
+      set_cpu_dispatch_level(level);
+      continue;
+    }
+
+    // --evaluator=<auto|hash|brute|context> pins the showdown evaluator.
+    // brute never loads the PLO4 tables, for machines short on memory.
+    EvaluatorBackend backend;
+    if (strncmp(argv[i], "--evaluator=", 12) == 0 &&
+        parse_evaluator_backend(argv[i] + 12, &backend)) {
+      set_evaluator_backend(backend);
+      continue;
+    }
+
+    cerr << "usage: " << argv[0] << " [--isa=scalar|sse4.2|avx2|avx512]"
+         << " [--evaluator=auto|hash|brute|context]" << endl;
+    return 1;
+  }
+
+  init_showdown_evaluators();
+
   View view;
   view.Start();
 
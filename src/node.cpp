@@ -10,83 +10,218 @@
 #include "chancenode.h"
 #include "equity_calc.h"
 #include "include/phevaluator.h"
+#include "kernels.h"
 
 using namespace std;
 
 // Adjust the strategy.
 // action_ev is the ev of various actions, performed by player_idx at this
-// node.
+// node, indexed by HandAction.
+// The row's current strategy is rematched here, the only place its regrets
+// change, so everything else reads it as it is.
 void Node::AdjustStrategy(GameState* game_state,
-                          unordered_map<HandAction, double>& action_ev,
-                          int handhash, double reach_probability) {
-  vector<pair<HandAction, double>> strat = GetStrategy(game_state, handhash);
+                          const array<double, MAX_HAND_ACTIONS>& action_ev,
+                          int handhash, double reach_probability,
+                          uint32_t pruned) {
+  array<double, MAX_HAND_ACTIONS> strat;
+  GetStrategy(game_state, handhash, strat);
 
   // weighted ev of this strategy.
   double strategy_ev = 0.0;
-  for (const auto& [action, probability] : strat) {
-    strategy_ev += probability * action_ev[action];
+  for (HandAction action : actions_) {
+    strategy_ev += strat[action] * action_ev[action];
   }
 
-  // Update regrets for each action
-  for (auto& [action, probability] : strat) {
+  // Update regrets and strategy sums for each action
+  InfosetRow& row = Row(handhash);
+  for (HandAction action : actions_) {
+    if (pruned & (1u << action)) {
+      continue;
+    }
     double regret = action_ev[action] - strategy_ev;  // CFR Regret formula
-    cumulative_regret_[handhash][action] += regret;
+    row.regret[action] += regret;
+    row.strategy_sum[action] += strat[action] * reach_probability;
   }
 
-  for (auto& [action, probability] : strat) {
-    cumulative_strategy_[handhash][action] += probability * reach_probability;
+  row.visits += reach_probability;
+  MatchRegrets(row);
+  updates_++;
+
+  if (average_cache_ != nullptr) {
+    CachedAverage& cached = (*average_cache_)[AverageCacheSlot(handhash)];
+    if (cached.handhash == handhash) {
+      cached.valid = false;
+    }
   }
+}
+
+const Node::InfosetRow* Node::FindRow(int handhash) const {
+  auto slot = slots_.find(handhash);
+  return slot == slots_.end() ? nullptr : &rows_[slot->second];
+}
 
-  double sum_pos_regret = 0.0;
-  for (auto& pr : cumulative_regret_[handhash]) {
-    if (pr.second > 0) {
-      sum_pos_regret += pr.second;
+Node::InfosetRow& Node::Row(int handhash) {
+  auto [slot, added] = slots_.try_emplace(handhash, (int)rows_.size());
+  if (added) {
+    rows_.emplace_back();
+    rows_.back().handhash = handhash;
+    MatchRegrets(rows_.back());
+  }
+  return rows_[slot->second];
+}
+
+// Regret matching: probabilities proportional to positive cumulative regret,
+// or uniform if no action has positive regret. Actions that aren't in
+// actions_ have regret 0, so they get probability 0.
+void Node::MatchRegrets(InfosetRow& row) const {
+  if (!regret_match(row.regret.data(), MAX_HAND_ACTIONS,
+                    row.strategy.data())) {
+    row.strategy.fill(0.0);
+    for (HandAction action : actions_) {
+      row.strategy[action] = 1.0 / (double)actions_.size();
     }
   }
+}
 
-  if (sum_pos_regret > 0) {
-    strat.clear();
-    for (const auto& [action, r] : cumulative_regret_[handhash]) {
-      double p = r > 0 ? r / sum_pos_regret : 0;
-      strat.push_back({action, p});
+// GetStrategy finds the strategy for a particular player at this node, or the
+// uniform strategy if they haven't been updated yet.
+void Node::GetStrategy(GameState* game_state, int handhash,
+                       array<double, MAX_HAND_ACTIONS>& strategy) {
+  if (actions_.empty()) {
+    for (const auto& [action, probability] :
+         game_state->GetUniformStrategy()) {
+      actions_.push_back(action);
     }
-    strategy[handhash] = strat;
-  } else {  // fall back to default
-    strategy[handhash] = game_state->GetUniformStrategy();
   }
 
-  visit_count_[handhash] += reach_probability;
+  if (!GetCurrentStrategy(handhash, strategy)) {
+    strategy.fill(0.0);
+    for (HandAction action : actions_) {
+      strategy[action] = 1.0 / (double)actions_.size();
+    }
+  }
 }
 
-// GetStrategy finds the strategy for a particular player at this node, or sets
-// it to the uniform strategy if it doesn't exist.
-vector<pair<HandAction, double>> Node::GetStrategy(GameState* game_state,
-                                                   int handhash) {
-  if (strategy.find(handhash) == strategy.end()) {
-    strategy[handhash] = game_state->GetUniformStrategy();
+bool Node::GetCurrentStrategy(int handhash,
+                              array<double, MAX_HAND_ACTIONS>& strategy) const {
+  const InfosetRow* row = FindRow(handhash);
+  if (row == nullptr) {
+    return false;
   }
 
-  return strategy[handhash];
+  strategy = row->strategy;
+  return true;
+}
+
+bool Node::GetAverageStrategy(int handhash,
+                              array<double, MAX_HAND_ACTIONS>& average) const {
+  if (average_cache_ == nullptr) {
+    average_cache_ =
+        make_unique<array<CachedAverage, 1 << AVERAGE_CACHE_BITS>>();
+  }
+
+  CachedAverage& cached = (*average_cache_)[AverageCacheSlot(handhash)];
+  if (cached.valid && cached.handhash == handhash) {
+    average = cached.average;
+    return true;
+  }
+
+  const InfosetRow* row = FindRow(handhash);
+  if (row == nullptr) {
+    return false;
+  }
+
+  double total = 0.0;
+  for (HandAction action : actions_) {
+    total += row->strategy_sum[action];
+  }
+  if (total <= 0.0) {
+    return false;
+  }
+
+  average.fill(0.0);
+  for (HandAction action : actions_) {
+    average[action] = row->strategy_sum[action] / total;
+  }
+  cached.valid = true;
+  cached.handhash = handhash;
+  cached.average = average;
+  return true;
+}
+
+int Node::NumCachedAverages() const {
+  if (average_cache_ == nullptr) {
+    return 0;
+  }
+
+  int num_cached = 0;
+  for (const CachedAverage& cached : *average_cache_) {
+    num_cached += cached.valid;
+  }
+  return num_cached;
 }
 
 // Randomises next action based on strategy probabilities.
 // Doesn't perform the action.
 // Returns {action to be performed, probability of choosing this action}.
+// Action menus are at most a handful of actions, so a linear scan beats
+// building a sampling table (which would be rebuilt on every visit anyway,
+// since each visit adjusts the strategy).
 pair<HandAction, double> Node::GetNextAction(GameState* game_state,
                                              int handhash) {
-  vector<pair<HandAction, double>> strat = GetStrategy(game_state, handhash);
+  array<double, MAX_HAND_ACTIONS> uniform;
+  const InfosetRow* row = FindRow(handhash);
+  if (row == nullptr) {
+    GetStrategy(game_state, handhash, uniform);
+  }
+  const array<double, MAX_HAND_ACTIONS>& strat =
+      row != nullptr ? row->strategy : uniform;
 
-  double chosen = rand_double(0.0, 1.0);
+  double chosen = rand_float();
   double cumulative = 0.0;
-  for (const auto& [action, probability] : strat) {
-    cumulative += probability;
+  for (HandAction action : actions_) {
+    cumulative += strat[action];
+
+    if (chosen < cumulative) {
+      return {action, strat[action]};
+    }
+  }
+
+  return {actions_.back(), strat[actions_.back()]};
+}
+
+uint32_t Node::PrunedActions(int handhash, double prune_threshold) const {
+  const InfosetRow* row = FindRow(handhash);
+  if (row == nullptr) {
+    // never updated, so nothing can be pruned.
+    return 0;
+  }
 
-    if (chosen <= cumulative) {
-      return {action, probability};
+  uint32_t pruned = 0;
+  bool any_positive = false;
+  for (HandAction action : actions_) {
+    const double regret = row->regret[action];
+    if (regret > 0.0) {
+      any_positive = true;
+    } else if (regret < prune_threshold) {
+      pruned |= 1u << action;
     }
   }
 
-  return strat.back();
+  // with no positive regret the strategy is uniform, so nothing has
+  // probability 0.
+  return any_positive ? pruned : 0;
+}
+
+double Node::AverageStrategyProbability(int handhash, HandAction action,
+                                        double fallback) const {
+  array<double, MAX_HAND_ACTIONS> strategy;
+  if (GetAverageStrategy(handhash, strategy) ||
+      GetCurrentStrategy(handhash, strategy)) {
+    return strategy[action];
+  }
+
+  return fallback;
 }
 
 Node* Node::GetNextNodeAndState(GameState* game_state, HandAction action) {
@@ -1,6 +1,9 @@
 // node.h
 #pragma once
 
+#include <array>
+#include <cstdint>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -10,8 +13,6 @@
 
 #include "gamestate.h"
 
-#define MAX_UNIQUE_HANDS 52 * 52 * 52 * 52
-
 using namespace std;
 class Node {
   // Define a node based on
@@ -21,22 +22,55 @@ class Node {
  public:
   // Strategy for each hand.
   // Define the strategy as the strategy for the person that action is on
-  // currently. Maps handhash to strategy. each pair<HandAction, double>
-  // represents the probability at which we do that action.
-  unordered_map<int, vector<pair<HandAction, double>>> strategy;
+  // currently. Each row keeps its current strategy (regret matching on its
+  // regret) next to the regrets, rematched whenever they change, so sampling
+  // reads it in place. The average strategy is strategy_sum normalised when
+  // needed.
+
+  // Actions available at this node, in GetUniformStrategy order. The same for
+  // every hand, so it is filled in on the first visit.
+  vector<HandAction> actions_;
 
   // concurrency
   mutex mtx;
 
-  // Cumulative positive regret for each info set (handhash -> action -> regret)
-  unordered_map<int, unordered_map<HandAction, double>> cumulative_regret_;
-
-  // Cumulative strategy sums for averaging (handhash -> action -> sum of
-  // prob_choice*reach)
-  unordered_map<int, unordered_map<HandAction, double>> cumulative_strategy_;
-
-  // How often you visited this info set (handhash -> total reach probability)
-  unordered_map<int, double> visit_count_;
+  // Accumulators of one info set (a hand, or a bucket of hands), indexed by
+  // HandAction. Actions that aren't in actions_ stay 0.
+  struct InfosetRow {
+    int handhash = 0;
+    // Cumulative regret of each action.
+    array<double, MAX_HAND_ACTIONS> regret{};
+    // Current strategy: regret matching on regret, or uniform over actions_
+    // while no regret is positive.
+    array<double, MAX_HAND_ACTIONS> strategy{};
+    // Cumulative strategy sums for averaging (sum of prob_choice*reach).
+    array<double, MAX_HAND_ACTIONS> strategy_sum{};
+    // How often you visited this info set (total reach probability).
+    double visits = 0.0;
+
+    bool operator==(const InfosetRow& other) const {
+      return handhash == other.handhash && regret == other.regret &&
+             strategy == other.strategy &&
+             strategy_sum == other.strategy_sum && visits == other.visits;
+    }
+    bool operator!=(const InfosetRow& other) const { return !(*this == other); }
+  };
+
+  // One contiguous row per info set that has been updated, in the order they
+  // were first updated. slots_ maps handhash to its index here, so a visit is
+  // one lookup however many actions there are.
+  vector<InfosetRow> rows_;
+
+  // Number of AdjustStrategy calls, so readers can tell whether rows_ has
+  // changed since they last looked.
+  long long updates_ = 0;
+
+  // The row of handhash, or nullptr if it hasn't been updated.
+  const InfosetRow* FindRow(int handhash) const;
+
+  // The row of handhash, added if there isn't one. A new row has no regret
+  // and plays uniformly.
+  InfosetRow& Row(int handhash);
 
   // Traversal
   unordered_map<HandAction, Node*> children;
@@ -55,16 +89,50 @@ class Node {
 
   virtual ~Node() = default;
 
-  void AdjustStrategy(GameState* game_state, unordered_map<HandAction, double>& action_ev, int handhash, double reach_probability);
-
-  // Gets the strategy for a particular hand at this node
-  vector<pair<HandAction, double>> GetStrategy(GameState* game_state, int handhash);
-
-  // Randomises next action based on strategy probabilities.
-  // Doesn't perform the action.
+  // Accumulates regrets and strategy sums, then rematches the row's current
+  // strategy from the new regrets.
+  // Actions whose bit is set in pruned (see PrunedActions) weren't evaluated,
+  // so their regret and strategy sum are left alone.
+  void AdjustStrategy(GameState* game_state, const array<double, MAX_HAND_ACTIONS>& action_ev, int handhash,
+                      double reach_probability, uint32_t pruned = 0);
+
+  // Gets the current strategy for a particular hand at this node, indexed by
+  // HandAction (0 for actions not in actions_). Hands that haven't been
+  // updated yet play uniformly.
+  void GetStrategy(GameState* game_state, int handhash, array<double, MAX_HAND_ACTIONS>& strategy);
+
+  // Same as above for a node that has been visited, without a game state.
+  // Returns false if the hand hasn't been updated at this node.
+  bool GetCurrentStrategy(int handhash, array<double, MAX_HAND_ACTIONS>& strategy) const;
+
+  // Average strategy for a hand, indexed by HandAction.
+  // Returns false if the hand has no cumulative strategy yet.
+  // Results are cached until the hand is next adjusted. Not thread safe: only
+  // the solver thread may call this.
+  bool GetAverageStrategy(int handhash, array<double, MAX_HAND_ACTIONS>& average) const;
+
+  // Number of hands whose average strategy is cached. Bounded, however many
+  // hands have been read.
+  int NumCachedAverages() const;
+
+  // Randomises next action based on strategy probabilities, read from the
+  // hand's row without copying or rematching. Doesn't perform the action.
   // Returns {action to be performed, probability of choosing this action}.
   pair<HandAction, double> GetNextAction(GameState* game_state, int handhash);
 
+  // Regret based pruning: the actions (as a bitmask of HandAction) whose
+  // subtrees can be skipped for handhash. An action is pruned if its
+  // cumulative regret is below prune_threshold and not positive, while some
+  // other action's is positive - regret matching then gives it probability
+  // exactly 0, so skipping it doesn't change the node's value.
+  uint32_t PrunedActions(int handhash, double prune_threshold) const;
+
+  // Probability that the average strategy for handhash takes action.
+  // Hands without a cumulative strategy use the current strategy, and hands
+  // that have never been visited use fallback.
+  double AverageStrategyProbability(int handhash, HandAction action,
+                                    double fallback) const;
+
   // GetNextNodeAndState advances both the game state, and the current node, by
   // performing an action.
   Node* GetNextNodeAndState(GameState* game_state, HandAction action);
@@ -72,4 +140,29 @@ class Node {
   // Returns position on table like UTG, BTN
   // only works for 6-handed right now
   string GetTablePosition() const;
+
+ private:
+  // Direct mapped cache of average strategies, so nodes that are read over
+  // and over (the focus, the path to a subgame) aren't renormalised every
+  // time. Allocated on the first read, so the rest of the tree pays nothing,
+  // and a fixed size however many hands are read. AdjustStrategy drops the
+  // entry of the hand it updates.
+  struct CachedAverage {
+    bool valid = false;
+    int handhash = 0;
+    array<double, MAX_HAND_ACTIONS> average;
+  };
+  static constexpr int AVERAGE_CACHE_BITS = 10;
+  mutable unique_ptr<array<CachedAverage, 1 << AVERAGE_CACHE_BITS>>
+      average_cache_;
+
+  // handhash -> index into rows_.
+  unordered_map<int, int> slots_;
+
+  // Sets row.strategy from row.regret.
+  void MatchRegrets(InfosetRow& row) const;
+
+  static int AverageCacheSlot(int handhash) {
+    return ((uint32_t)handhash * 2654435761u) >> (32 - AVERAGE_CACHE_BITS);
+  }
 };
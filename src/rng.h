@@ -0,0 +1,89 @@
+// rng.h
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <random>
+
+using namespace std;
+
+// CounterRng is a counter based PRNG (Philox4x32-10).
+//
+// The output is a pure function of (seed, stream, iteration, position), so
+// any thread can jump straight to the numbers of any iteration with Seek,
+// without having to replay the ones before it. The solver gives every thread
+// its own stream and reseeks at the start of every iteration, which makes a
+// seeded run reproducible regardless of how long each iteration takes.
+class CounterRng {
+ public:
+  // Unseeded engines draw a seed from random_device.
+  CounterRng()
+      : CounterRng(((uint64_t)random_device{}() << 32) | random_device{}()) {}
+
+  explicit CounterRng(uint64_t seed, uint32_t stream = 0,
+                      uint64_t iteration = 0) {
+    Seek(seed, stream, iteration);
+  }
+
+  // Seek restarts the engine at the start of (stream, iteration).
+  void Seek(uint64_t seed, uint32_t stream, uint64_t iteration) {
+    key_[0] = (uint32_t)seed;
+    key_[1] = (uint32_t)(seed >> 32);
+    counter_[0] = (uint32_t)iteration;
+    counter_[1] = (uint32_t)(iteration >> 32);
+    counter_[2] = 0;
+    counter_[3] = stream;
+    index_ = 4;
+  }
+
+  uint32_t next() {
+    if (index_ == 4) {
+      Generate();
+      counter_[2]++;
+      index_ = 0;
+    }
+    return output_[index_++];
+  }
+
+  // Uniform integer in [0, n). Multiply and shift (Lemire) - the bias is
+  // below 2^-25 for deck sized n, which is fine for sampling.
+  uint32_t below(uint32_t n) {
+    return (uint32_t)(((uint64_t)next() * n) >> 32);
+  }
+
+  // lets CounterRng be passed to <random> distributions and algorithms.
+  using result_type = uint32_t;
+  static constexpr uint32_t min() { return 0; }
+  static constexpr uint32_t max() { return UINT32_MAX; }
+  uint32_t operator()() { return next(); }
+
+ private:
+  void Generate() {
+    constexpr uint32_t M0 = 0xD2511F53, M1 = 0xCD9E8D57;
+    constexpr uint32_t W0 = 0x9E3779B9, W1 = 0xBB67AE85;
+
+    array<uint32_t, 4> x = counter_;
+    uint32_t k0 = key_[0], k1 = key_[1];
+    for (int round = 0; round < 10; round++) {
+      uint64_t p0 = (uint64_t)M0 * x[0];
+      uint64_t p1 = (uint64_t)M1 * x[2];
+      x = {(uint32_t)(p1 >> 32) ^ x[1] ^ k0, (uint32_t)p1,
+           (uint32_t)(p0 >> 32) ^ x[3] ^ k1, (uint32_t)p0};
+      k0 += W0;
+      k1 += W1;
+    }
+    output_ = x;
+  }
+
+  array<uint32_t, 2> key_;
+  array<uint32_t, 4> counter_;
+  array<uint32_t, 4> output_;
+  int index_ = 4;
+};
+
+// Thread-local random engine. Randomly seeded once per thread, until the
+// solver seeks it to a fixed (seed, stream, iteration).
+inline CounterRng& thread_rng() {
+  static thread_local CounterRng rng;
+  return rng;
+}
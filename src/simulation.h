@@ -1,16 +1,67 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <deque>
 #include <exception>
 #include <iostream>
+#include <limits>
 #include <mutex>
 #include <set>
+#include <stdexcept>
 #include <string>
 #include <thread>
 #include <vector>
 
+#include "abstraction.h"
+#include "action_tree.h"
 #include "chancenode.h"
+#include "evaluator_backend.h"
 #include "node.h"
+#include "rng.h"
+#include "strategy_snapshot.h"
+#include "subgame.h"
+
+// Regret based pruning settings.
+// With pruning enabled, each iteration picks a traverser (cycling through the
+// seats), who tries every action at their decision nodes while everyone else
+// samples one. After warmup_iterations, the traverser's actions with
+// cumulative regret below regret_threshold (see Node::PrunedActions) are
+// skipped: neither their subtree nor their regret is visited. Every
+// revisit_interval'th iteration nothing is pruned, so pruned actions can
+// recover.
+struct PruningConfig {
+  bool enabled = false;
+  double regret_threshold = -300.0;
+  int warmup_iterations = 1000;
+  int revisit_interval = 20;
+};
+
+// Counters for how much work pruning saved.
+struct PruningStats {
+  long long decisions = 0;         // traverser decisions, every action tried
+  long long pruned_decisions = 0;  // ...where at least one action was pruned
+  long long pruned_subtrees = 0;   // subtree walks skipped
+};
+
+// TraversalScratch holds the game state copies for one traversal thread.
+// Frame i is the copy made at decision depth i. Frames are kept between
+// iterations, so copying into them reuses their storage instead of
+// allocating.
+class TraversalScratch {
+ public:
+  GameState& Frame(int depth) {
+    // deque, so growing doesn't move the frames callers are pointing at.
+    while (frames_.size() <= depth) {
+      frames_.emplace_back();
+    }
+    return frames_[depth];
+  }
+
+ private:
+  deque<GameState> frames_;
+};
 
 class Simulation {
  private:
@@ -18,12 +69,65 @@ class Simulation {
 
   int num_players_;
 
+  // scratch space for the solver thread's traversals.
+  TraversalScratch scratch_;
+
+  // traversal for the number of players, chosen in initialise.
+  void (Simulation::*traverse_)(Node* node, GameState* game_state) = nullptr;
+
   Node* root_ = nullptr;   // root of the game tree (shouldn't change)
-  Node* focus_ = nullptr;  // node from which we are running computations and
-                           // are viewing strategy for
+  atomic<Node*> focus_{nullptr};  // node from which we are running
+                                  // computations and are viewing strategy for
   GameState* game_state_;  // gamestate. reset at each iteration, and passed
                            // through the game tree when recursing
 
+  // betting tree for this configuration, built in initialise.
+  ActionTree* action_tree_ = nullptr;
+
+  // When focus_ isn't the root, iterations are spent on the subtree under it,
+  // with ranges from the average strategy on the way there.
+  bool solve_from_focus_ = true;
+  Subgame subgame_;  // built (in the solver thread) when the focus changes.
+  GameState subgame_state_;
+  // focus whose subgame couldn't be built, so it isn't rebuilt every
+  // iteration.
+  Node* failed_focus_ = nullptr;
+  // why the last iteration from the focus failed, for the GUI. Empty if none
+  // has.
+  mutable mutex focus_error_mtx_;
+  string focus_error_;
+
+  void SetFocusError(const string& error) {
+    lock_guard<mutex> lock(focus_error_mtx_);
+    focus_error_ = error;
+  }
+
+  // optional card abstraction. hands are replaced by their bucket for boards
+  // that have a table.
+  const HandAbstraction* abstraction_ = nullptr;
+
+  // regret based pruning
+  PruningConfig pruning_;
+  // threshold for the current iteration (-inf when not pruning)
+  double prune_threshold_ = -numeric_limits<double>::infinity();
+  // seat that tries every action this iteration, or -1 to sample everywhere.
+  int traverser_ = -1;
+  atomic<long long> decisions_{0};
+  atomic<long long> pruned_decisions_{0};
+  atomic<long long> pruned_subtrees_{0};
+
+  // latest snapshot of the focused node's average strategy. only the solver
+  // thread stores it; readers atomically load it.
+  shared_ptr<const StrategySnapshot> snapshot_;
+  chrono::steady_clock::time_point last_snapshot_;
+  static constexpr chrono::milliseconds SNAPSHOT_INTERVAL{250};
+
+  // When seeded, every iteration reseeks the thread's engine to
+  // (seed_, thread index, iteration), so the same seed gives the same tree.
+  bool seeded_ = false;
+  uint64_t seed_ = 0;
+  long long iteration_ = 0;  // iterations run so far
+
   mutex mtx;
 
   State state_ = State::STOPPED;
@@ -43,41 +147,98 @@ class Simulation {
   // Params:
   // Node: node to recurse from.
   // reach_probability: probability of reaching node.
-  // Returns:
-  // Vector of EVs for each player.
-  vector<double> recurse(Node* node, GameState* game_state, double reach_probability) {
+  // depth: number of decision nodes above node - picks the scratch frame.
+  // ev: filled with the EVs for each player. MaxPlayers is the seat count the
+  // traversal was compiled for (see initialise); seats past num_players_ are
+  // always 0.
+  // Nothing is allocated once the scratch frames and the node's tables for the
+  // hands seen have been created.
+  template <int MaxPlayers>
+  void recurse(Node* node, GameState* game_state, double reach_probability, int depth,
+               array<double, MaxPlayers>& ev) {
     if (game_state->end_of_game()) {
       // If it is terminal, it is not a decision node.
       // So therefore just return EVs here.
-      return game_state->calculate_ev();
+      ev = game_state->calculate_ev<MaxPlayers>();
+      return;
     }
 
     if (auto chance_node = dynamic_cast<ChanceNode*>(node)) {
       // next_node is a decision node - after dealing cards.
       Node* next_node = chance_node->GetNextNodeAndState(game_state);
-      return recurse(next_node, game_state, reach_probability);
+      recurse<MaxPlayers>(next_node, game_state, reach_probability, depth, ev);
+      return;
     }
 
     // This returns the EVs for all players but we only calculate the regret for
     // hero here. The rest we just pass back.
-    vector<double> average_ev(num_players_);
+    ev.fill(0.0);
     int hero = game_state->get_next_to_act();
-    int handhash = hand_hash(game_state->players_[game_state->get_next_to_act()].get_hand());
+    int handhash = hand_index(game_state->players_[hero].hand);
+    if (abstraction_ != nullptr) {
+      handhash = abstraction_->InfosetKey(game_state->board1_,
+                                          game_state->board2_, handhash);
+    }
 
     // Calculate regret for hero.
-    unordered_map<HandAction, double> action_ev;
-    unordered_map<HandAction, int> action_count;
+    array<double, MAX_HAND_ACTIONS> action_ev{};
+    array<int, MAX_HAND_ACTIONS> action_count{};
+    array<double, MaxPlayers> sample_ev;
+
+    if (hero == traverser_) {
+      // every action that isn't pruned. the child's reach is the hero's own
+      // probability of playing the action; pruned actions have probability
+      // 0, so the node's ev is exact without them.
+      array<double, MAX_HAND_ACTIONS> strat;
+      node->GetStrategy(game_state, handhash, strat);
+      const uint32_t pruned = node->PrunedActions(handhash, prune_threshold_);
+      decisions_++;
+      if (pruned != 0) {
+        pruned_decisions_++;
+      }
+
+      for (HandAction action : node->actions_) {
+        if (pruned & (1u << action)) {
+          pruned_subtrees_++;
+          continue;
+        }
+
+        GameState& state_copy = scratch_.Frame(depth);
+        state_copy = *game_state;
+        Node* next = node->GetNextNodeAndState(&state_copy, action);
+        recurse<MaxPlayers>(next, &state_copy, reach_probability * strat[action], depth + 1, sample_ev);
+        for (int j = 0; j < MaxPlayers; j++) {
+          ev[j] += strat[action] * sample_ev[j];
+        }
+        action_ev[action] = sample_ev[hero];
+      }
+
+      node->AdjustStrategy(game_state, action_ev, handhash, reach_probability, pruned);
+      return;
+    }
+
+    if (traverser_ >= 0) {
+      // another player's node: sample their action from their whole
+      // strategy. Only the traverser's regrets are updated this iteration.
+      GameState& state_copy = scratch_.Frame(depth);
+      state_copy = *game_state;
+      HandAction next_action = node->GetNextAction(&state_copy, handhash).first;
+      Node* next = node->GetNextNodeAndState(&state_copy, next_action);
+      recurse<MaxPlayers>(next, &state_copy, reach_probability, depth + 1, ev);
+      return;
+    }
 
     int num_simulations = 1;
     for (int i = 0; i < num_simulations; i++) {
-      GameState state_copy = *game_state;
+      GameState& state_copy = scratch_.Frame(depth);
+      state_copy = *game_state;
 
       auto [next_action, action_probability] = node->GetNextAction(&state_copy, handhash);
       Node* next = node->GetNextNodeAndState(&state_copy, next_action);  // advances game_state
 
-      vector<double> sample_ev = recurse(next, &state_copy, reach_probability * action_probability);
-      for (int j = 0; j < num_players_; j++) {
-        average_ev[j] += sample_ev[j];
+      recurse<MaxPlayers>(next, &state_copy, reach_probability * action_probability, depth + 1, sample_ev);
+      for (int j = 0; j < MaxPlayers; j++) {
+        ev[j] += sample_ev[j];
       }
 
       action_ev[next_action] += sample_ev[hero];
@@ -85,23 +246,32 @@ class Simulation {
     }
 
     // Convert to average
-    for (int i = 0; i < num_players_; i++) {
-      average_ev[i] /= (double)num_simulations;
+    for (int i = 0; i < MaxPlayers; i++) {
+      ev[i] /= (double)num_simulations;
     }
 
     // Convert to average
-    for (const auto& [action, count] : action_count) {
-      action_ev[action] /= (double)count;
+    for (int action = 0; action < MAX_HAND_ACTIONS; action++) {
+      if (action_count[action] > 0) {
+        action_ev[action] /= (double)action_count[action];
+      }
     }
 
     // This is the strategy for 'next_to_act', at the current NODE.
     node->AdjustStrategy(game_state, action_ev, handhash, reach_probability);
+  }
 
-    return average_ev;
+  // Traverse runs one traversal from node, compiled for MaxPlayers seats.
+  template <int MaxPlayers>
+  void Traverse(Node* node, GameState* game_state) {
+    array<double, MaxPlayers> ev;
+    recurse<MaxPlayers>(node, game_state, 1.0, 0, ev);
   }
 
   // Entry point
-  void initialise(const string& flop1, const string& flop2, int num_players, double stack_depth, double ante) {
+  // bet_sizing is the menu of bet sizes to solve for (POT only by default).
+  void initialise(const string& flop1, const string& flop2, int num_players, double stack_depth, double ante,
+                  const BetSizing& bet_sizing = BetSizing()) {
     if (flop1.size() != 6) {
       throw exception("Flop 1 is not correctly specified.");
     }
@@ -122,16 +292,155 @@ class Simulation {
 
     num_players_ = num_players;
 
+    // pick the traversal once, so the player loops have a fixed trip count.
+    if (num_players <= 2) {
+      traverse_ = &Simulation::Traverse<2>;
+    } else if (num_players <= 3) {
+      traverse_ = &Simulation::Traverse<3>;
+    } else if (num_players <= 6) {
+      traverse_ = &Simulation::Traverse<6>;
+    } else if (num_players <= 9) {
+      traverse_ = &Simulation::Traverse<9>;
+    } else {
+      throw runtime_error("At most 9 players are supported.");
+    }
+
     // Node(flop1vec, flop2vec, num_players, stack_depth,
     // ante);
-    game_state_ = new GameState(flop1vec, flop2vec, num_players, stack_depth, ante);
+    game_state_ = new GameState(flop1vec, flop2vec, num_players, stack_depth, ante, bet_sizing);
+
+    // legal actions, pot and next to act are read from the precompiled tree
+    // during the solve.
+    TreeConfig config;
+    config.num_players = num_players;
+    config.stack_depth = stack_depth;
+    config.ante = ante;
+    config.bet_sizing = bet_sizing;
+    action_tree_ = new ActionTree();
+    action_tree_->Build(config);
+    game_state_->use_action_tree(action_tree_);
+
+    // benchmarks the showdown evaluators now rather than in the first
+    // iteration's showdown.
+    init_showdown_evaluators();
+
     root_ = new Node(game_state_->get_next_to_act());
     focus_ = root_;
   }
 
+  // SetAbstraction enables card abstraction for the boards that abstraction
+  // has tables for. Regrets are then shared by every hand in a bucket.
+  // Must be called before StartSolver, and abstraction must outlive the solve.
+  void SetAbstraction(const HandAbstraction* abstraction) { abstraction_ = abstraction; }
+
+  // SetSolveFromFocus chooses whether iterations start from the focused node
+  // (re-solving its subgame) or always from the root.
+  void SetSolveFromFocus(bool solve_from_focus) { solve_from_focus_ = solve_from_focus; }
+
+  // SetPruning configures regret based pruning. Must be called before
+  // StartSolver.
+  void SetPruning(const PruningConfig& pruning) { pruning_ = pruning; }
+
+  // GetPruningStats returns how many subtree walks were pruned so far.
+  PruningStats GetPruningStats() const {
+    PruningStats stats;
+    stats.decisions = decisions_;
+    stats.pruned_decisions = pruned_decisions_;
+    stats.pruned_subtrees = pruned_subtrees_;
+    return stats;
+  }
+
+  // PublishSnapshot snapshots the focused node for readers.
+  // Must only be called from the solver thread, while it isn't recursing.
+  void PublishSnapshot(long long iteration) {
+    atomic_store(&snapshot_, StrategySnapshot::Take(focus_, iteration));
+    last_snapshot_ = chrono::steady_clock::now();
+  }
+
+  // Publishes if the focus has changed, or the last snapshot is stale and
+  // the focus has been updated since. An unchanged focus (a node the solver
+  // rarely reaches, or a paused solver) keeps its snapshot rather than being
+  // rebuilt every interval.
+  void MaybePublishSnapshot(long long iteration) {
+    shared_ptr<const StrategySnapshot> current = atomic_load(&snapshot_);
+    Node* focus = focus_;
+    if (current != nullptr && current->node == focus &&
+        (current->updates == focus->updates_ ||
+         chrono::steady_clock::now() - last_snapshot_ < SNAPSHOT_INTERVAL)) {
+      return;
+    }
+    PublishSnapshot(iteration);
+  }
+
+  // SetSeed makes the solve reproducible: runs with the same seed (and
+  // thread count) build bit-identical trees. Unseeded runs are random.
+  // Restarts the iteration count, so the next iteration deals the seed's
+  // first hands. Must be called before StartSolver.
+  void SetSeed(uint64_t seed) {
+    seeded_ = true;
+    seed_ = seed;
+    iteration_ = 0;
+  }
+
+  // RunIteration runs one iteration of CFR, from the root or the focus.
+  // Must only be called from the solver thread.
+  void RunIteration() {
+    iteration_++;
+
+    // prune, except for every revisit_interval'th iteration.
+    bool prune = pruning_.enabled && iteration_ > pruning_.warmup_iterations &&
+                 (pruning_.revisit_interval <= 0 || iteration_ % pruning_.revisit_interval != 0);
+    prune_threshold_ = prune ? pruning_.regret_threshold : -numeric_limits<double>::infinity();
+    traverser_ = pruning_.enabled ? (int)(iteration_ % num_players_) : -1;
+
+    // there is one solver thread, so it uses stream 0.
+    if (seeded_) {
+      thread_rng().Seek(seed_, 0, iteration_);
+    }
+
+    Node* focus = focus_;
+    game_state_->reset();
+    if (!solve_from_focus_ || focus == root_ || focus == failed_focus_) {
+      (this->*traverse_)(root_, game_state_);
+      return;
+    }
+
+    // re-solve the subgame under the focus.
+    try {
+      if (subgame_.GetRoot() != focus) {
+        failed_focus_ = focus;
+        subgame_ = Subgame(root_, focus, *game_state_, abstraction_);
+        failed_focus_ = nullptr;
+        SetFocusError("");
+      }
+      subgame_.Sample(&subgame_state_);
+    } catch (const exception& e) {
+      // this iteration solves from the root instead.
+      SetFocusError(e.what());
+      (this->*traverse_)(root_, game_state_);
+      return;
+    }
+    (this->*traverse_)(focus, &subgame_state_);
+  }
+
+  // GetFocusError returns why solving from the focus last failed (those
+  // iterations started from the root), or "" if it hasn't.
+  string GetFocusError() const {
+    lock_guard<mutex> lock(focus_error_mtx_);
+    return focus_error_;
+  }
+
+  // RunIterations runs num_iterations iterations on the calling thread, for
+  // tests and benchmarks. The solver thread must not be running.
+  void RunIterations(int num_iterations) {
+    for (int i = 0; i < num_iterations; i++) {
+      RunIteration();
+    }
+    PublishSnapshot(iteration_);
+  }
+
   // you should run this in a separate thread.
   void SolverLoop() {
-    int iterations = 0;
     cout << "Starting solver loop " << endl;
     // loop exits on StopSolver();
     unique_lock<mutex> lock(mtx, defer_lock);
@@ -139,29 +448,19 @@ class Simulation {
       lock.lock();
       if (state_ == State::STOPPED) {
         lock.unlock();
+        PublishSnapshot(iteration_);
         break;
       } else if (state_ == State::PAUSED) {
         lock.unlock();
+        MaybePublishSnapshot(iteration_);
         this_thread::sleep_for(chrono::milliseconds(100));
         continue;
       }
 
       // drop the lock while running the computation
-      iterations++;
-      // cout << "Done " << iterations << " iterations " << endl;
-
       lock.unlock();
-      // recurse only from the root.
-      // add functionality later for switching recursion basepoint.
-
-      // GameState* state = new GameState()
-
-      // game_state = root_state_;//copy
-      // root_->state_.reset();
-      game_state_->reset();
-      recurse(root_, game_state_, 1.0);
-      // focus_->state_.reset();
-      // recurse(focus_, 1.0);
+      RunIteration();
+      MaybePublishSnapshot(iteration_);
     }
   }
 
@@ -192,7 +491,7 @@ class Simulation {
 
   void SetFocus(Node* new_focus) {
     PauseSolver();
-    cout << "Changed focus from " << focus_ << " to " << new_focus << endl;
+    cout << "Changed focus from " << focus_.load() << " to " << new_focus << endl;
     cout << "Position: " << new_focus->GetTablePosition() << endl;
 
     focus_ = new_focus;
@@ -203,6 +502,16 @@ class Simulation {
   // it is the node for which we are looking at strategy for.
   Node* GetFocus() { return focus_; }
 
+  // GetStrategySnapshot returns the latest published snapshot of the focused
+  // node's average strategy (nullptr before the solver has started). Never
+  // blocks the solver. The snapshot may lag the focus by one publish.
+  shared_ptr<const StrategySnapshot> GetStrategySnapshot() const {
+    return atomic_load(&snapshot_);
+  }
+
+  // GetActionTree returns the betting tree being solved.
+  const ActionTree* GetActionTree() { return action_tree_; }
+
   // GetRoot returns the root of the game tree. The root never changes.
   Node* GetRoot() { return root_; }
 };
\ No newline at end of file
@@ -0,0 +1,61 @@
+// strategy_snapshot.h
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "handaction.h"
+#include "node.h"
+
+using namespace std;
+
+// StrategySnapshot is an immutable copy of one node's average strategy.
+//
+// The solver thread is the only thread that touches a Node's tables, so it
+// periodically takes a snapshot of the focused node and publishes it with an
+// atomic shared_ptr store. Readers (the GUI) atomically load the latest
+// snapshot and can read it for as long as they hold it, without ever blocking
+// the solver. Old snapshots are freed when their last reader lets go.
+struct StrategySnapshot {
+  struct Row {
+    int handhash = 0;
+    // average strategy, indexed by HandAction.
+    array<float, MAX_HAND_ACTIONS> probability{};
+    double visits = 0.0;
+  };
+
+  const Node* node = nullptr;  // node this is a snapshot of
+  long long iteration = 0;     // solver iteration it was taken after
+  long long updates = 0;       // node->updates_ when it was taken
+  vector<Row> rows;
+
+  // Take builds a snapshot of node. Must be called from the solver thread.
+  // Hands that have no cumulative strategy yet use the current strategy.
+  static shared_ptr<const StrategySnapshot> Take(Node* node,
+                                                 long long iteration) {
+    auto snapshot = make_shared<StrategySnapshot>();
+    snapshot->node = node;
+    snapshot->iteration = iteration;
+    snapshot->updates = node->updates_;
+    snapshot->rows.reserve(node->rows_.size());
+
+    array<double, MAX_HAND_ACTIONS> strategy;
+    for (const Node::InfosetRow& infoset : node->rows_) {
+      if (!node->GetAverageStrategy(infoset.handhash, strategy) &&
+          !node->GetCurrentStrategy(infoset.handhash, strategy)) {
+        continue;
+      }
+
+      Row row;
+      row.handhash = infoset.handhash;
+      row.visits = infoset.visits;
+      for (int action = 0; action < MAX_HAND_ACTIONS; action++) {
+        row.probability[action] = strategy[action];
+      }
+      snapshot->rows.push_back(row);
+    }
+
+    return snapshot;
+  }
+};
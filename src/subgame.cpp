@@ -0,0 +1,250 @@
+// subgame.cpp
+#include "subgame.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+#include "chancenode.h"
+#include "helper.h"
+
+using namespace std;
+
+// A step on the way to the subgame root: a decision, or a deal.
+struct PathStep {
+  // the decision. node is nullptr for deals.
+  Node* node = nullptr;
+  int player = 0;
+  HandAction action = NOTHING;
+  int num_actions = 0;
+  vector<int> board1;
+  vector<int> board2;
+
+  // the deal: the chance node permutes suits so that isomorphic deals share a
+  // runout, so a hand below it is one of several hands above it - one per
+  // deal that lands on the runout. See ChanceNode::DealPermutations.
+  vector<SuitPermutation> deal_permutations;
+};
+
+// The hand (by hand_index) that hand was before perm was applied to it.
+static int unpermuted_hand(int hand, const SuitPermutation& perm) {
+  SuitPermutation inverse;
+  for (int s = 0; s < 4; s++) {
+    inverse[perm[s]] = s;
+  }
+
+  uint64_t mask = 0;
+  for (int card : hand_from_index(hand)) {
+    mask |= 1ull << permute_card(card, inverse);
+  }
+  return hand_index(mask);
+}
+
+Subgame::Subgame(Node* root, Node* focus, const GameState& root_state,
+                 const HandAbstraction* abstraction)
+    : focus_(focus), state_(root_state) {
+  // path from focus up to root
+  vector<Node*> path;
+  for (Node* n = focus; n != root; n = n->parent) {
+    if (n == nullptr) {
+      throw runtime_error("Subgame root is not below the tree root.");
+    }
+    path.push_back(n);
+  }
+  path.push_back(root);
+  reverse(path.begin(), path.end());
+
+  vector<PathStep> steps;
+  for (int i = 0; i + 1 < path.size(); i++) {
+    Node* parent = path[i];
+    Node* child = path[i + 1];
+
+    if (auto chance_node = dynamic_cast<ChanceNode*>(parent)) {
+      bool found = false;
+      for (const auto& runout : chance_node->GetRunouts()) {
+        if (runout.node == child) {
+          state_.deal_street(runout.top_card, runout.bottom_card);
+          PathStep deal;
+          deal.deal_permutations = chance_node->DealPermutations(
+              runout.top_card, runout.bottom_card);
+          steps.push_back(move(deal));
+          found = true;
+          break;
+        }
+      }
+      if (!found) {
+        throw runtime_error("Subgame path has a missing runout.");
+      }
+      continue;
+    }
+
+    bool found = false;
+    for (const auto& [action, node] : parent->children) {
+      if (node == child) {
+        PathStep decision;
+        decision.node = parent;
+        decision.player = state_.get_next_to_act();
+        decision.action = action;
+        decision.num_actions = state_.GetUniformStrategy().size();
+        decision.board1 = state_.board1_;
+        decision.board2 = state_.board2_;
+        steps.push_back(move(decision));
+        state_.do_next_action(action);
+        found = true;
+        break;
+      }
+    }
+    if (!found) {
+      throw runtime_error("Subgame path has a missing action.");
+    }
+  }
+
+  // candidate hands avoid every board card at the subgame root.
+  uint64_t board_mask = 0;
+  for (int c : state_.board1_) board_mask |= 1ull << c;
+  for (int c : state_.board2_) board_mask |= 1ull << c;
+
+  vector<int> remaining;
+  for (int c = 0; c < 52; c++) {
+    if (!(board_mask & (1ull << c))) {
+      remaining.push_back(c);
+    }
+  }
+
+  const int n = remaining.size();
+  for (int a = 0; a < n; a++) {
+    for (int b = a + 1; b < n; b++) {
+      for (int c = b + 1; c < n; c++) {
+        for (int d = c + 1; d < n; d++) {
+          hands_.push_back(
+              {remaining[a], remaining[b], remaining[c], remaining[d]});
+        }
+      }
+    }
+  }
+
+  // weights are kept for every hand_index, in the suits of the current step.
+  const int num_players = state_.players_.size();
+  cumulative_weights_.assign(num_players, vector<double>(hands_.size()));
+  vector<double> weights(NUM_HANDS), permuted(NUM_HANDS);
+  for (int p = 0; p < num_players; p++) {
+    fill(weights.begin(), weights.end(), 1.0);
+
+    for (const auto& step : steps) {
+      if (step.node == nullptr) {
+        if (step.deal_permutations.size() == 1 &&
+            step.deal_permutations[0] == SuitPermutation{0, 1, 2, 3}) {
+          continue;
+        }
+
+        // every deal of the runout is equally likely, and each maps the hand
+        // back to a different hand above the chance node.
+        const double num_deals = step.deal_permutations.size();
+        for (int h = 0; h < NUM_HANDS; h++) {
+          double total = 0.0;
+          for (const auto& perm : step.deal_permutations) {
+            total += weights[unpermuted_hand(h, perm)];
+          }
+          permuted[h] = total / num_deals;
+        }
+        swap(weights, permuted);
+        continue;
+      }
+
+      if (step.player != p) {
+        continue;
+      }
+
+      for (int h = 0; h < NUM_HANDS; h++) {
+        if (weights[h] == 0.0) {
+          continue;
+        }
+
+        int key = h;
+        if (abstraction != nullptr) {
+          key = abstraction->InfosetKey(step.board1, step.board2, key);
+        }
+        weights[h] *= step.node->AverageStrategyProbability(
+            key, step.action, 1.0 / (double)step.num_actions);
+      }
+    }
+
+    double total = 0.0;
+    for (int h = 0; h < hands_.size(); h++) {
+      const auto& hand = hands_[h];
+      total += weights[hand_index((1ull << hand[0]) | (1ull << hand[1]) |
+                                  (1ull << hand[2]) | (1ull << hand[3]))];
+      cumulative_weights_[p][h] = total;
+    }
+
+    // the average strategy never takes this line - fall back to a uniform
+    // range rather than getting stuck.
+    if (total <= 0.0) {
+      for (int h = 0; h < hands_.size(); h++) {
+        cumulative_weights_[p][h] = h + 1;
+      }
+    }
+  }
+}
+
+double Subgame::HandWeight(int player, const array<int, 4>& hand) const {
+  auto it = lower_bound(hands_.begin(), hands_.end(), hand);
+  if (it == hands_.end() || *it != hand) {
+    return 0.0;
+  }
+
+  const int h = it - hands_.begin();
+  const vector<double>& cumulative = cumulative_weights_[player];
+  return cumulative[h] - (h > 0 ? cumulative[h - 1] : 0.0);
+}
+
+void Subgame::Sample(GameState* state) const {
+  *state = state_;
+
+  uint64_t used = 0;
+  for (int c : state_.board1_) used |= 1ull << c;
+  for (int c : state_.board2_) used |= 1ull << c;
+
+  const uint64_t board_mask = used;
+  const int num_players = state->players_.size();
+
+  // rejection sampling - hands that clash with an earlier player's hand are
+  // redrawn. start over if a player gets stuck.
+  for (int attempt = 0;; attempt++) {
+    used = board_mask;
+    bool ok = true;
+
+    for (int p = 0; p < num_players && ok; p++) {
+      const vector<double>& cumulative = cumulative_weights_[p];
+      ok = false;
+      for (int tries = 0; tries < 100; tries++) {
+        double chosen = rand_double() * cumulative.back();
+        int h = upper_bound(cumulative.begin(), cumulative.end(), chosen) -
+                cumulative.begin();
+        h = min<int>(h, hands_.size() - 1);
+
+        const auto& hand = hands_[h];
+        uint64_t mask = (1ull << hand[0]) | (1ull << hand[1]) |
+                        (1ull << hand[2]) | (1ull << hand[3]);
+        if (used & mask) {
+          continue;
+        }
+
+        used |= mask;
+        state->players_[p].hand.assign(hand.begin(), hand.end());
+        ok = true;
+        break;
+      }
+    }
+
+    if (ok) {
+      break;
+    }
+    if (attempt == 1000) {
+      throw runtime_error("Failed to sample hands for the subgame.");
+    }
+  }
+
+  state->deck.reset();
+  state->deck.erase_mask(used);
+}
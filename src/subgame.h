@@ -0,0 +1,52 @@
+// subgame.h
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "abstraction.h"
+#include "gamestate.h"
+#include "node.h"
+
+using namespace std;
+
+// Subgame lets the solver iterate from a node deep in the tree, instead of
+// from the root.
+//
+// The actions (and dealt cards) from the root to the subgame root are
+// replayed once, and each player's range at the subgame root is derived from
+// the average strategy along the way: the weight of a hand is the product of
+// the probabilities that it takes each action the player took (averaged over
+// the suit permutations a chance node applies, see ChanceNode). Every
+// iteration then samples hands from those ranges and traverses only the
+// subtree.
+class Subgame {
+ public:
+  Subgame() {}
+
+  // Build replays the path from root to focus. root_state must be the game
+  // state at root. abstraction may be nullptr.
+  Subgame(Node* root, Node* focus, const GameState& root_state,
+          const HandAbstraction* abstraction);
+
+  Node* GetRoot() const { return focus_; }
+
+  // Sample sets state to the subgame root, with hands drawn from the ranges
+  // and a freshly shuffled deck.
+  void Sample(GameState* state) const;
+
+  // HandWeight is player's (unnormalised) range weight for hand at the
+  // subgame root, or 0 if the hand uses a board card. hand must be sorted.
+  double HandWeight(int player, const array<int, 4>& hand) const;
+
+ private:
+  Node* focus_ = nullptr;
+
+  // game state at focus_. hands are overwritten by Sample.
+  GameState state_;
+
+  // every hand that doesn't use a board card.
+  vector<array<int, 4>> hands_;
+  // cumulative_weights_[player][i] = sum of weights of hands_[0..i]
+  vector<vector<double>> cumulative_weights_;
+};
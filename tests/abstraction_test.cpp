@@ -0,0 +1,90 @@
+#include "src/abstraction.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+
+#include "src/chancenode.h"
+#include "src/gamestate.h"
+#include "src/helper.h"
+
+TEST(AbstractionTest, RiverBuckets) {
+  vector<int> board1 = string_to_cards("2c7d9hJsKc");
+  vector<int> board2 = string_to_cards("3d4d8sTcAh");
+
+  HandAbstraction abstraction;
+  abstraction.Build(board1, board2, 8, 1, 2, 5);
+
+  ASSERT_TRUE(abstraction.HasTable(board1, board2));
+  ASSERT_EQ(abstraction.NumBuckets(board1, board2), 8);
+
+  int handhash = hand_index(string_to_cards("AsAdKsKd"));
+  int bucket = abstraction.GetBucket(board1, board2, handhash);
+  ASSERT_GE(bucket, 0);
+  ASSERT_LT(bucket, 8);
+
+  int key = abstraction.InfosetKey(board1, board2, handhash);
+  ASSERT_TRUE(is_bucket_key(key));
+  ASSERT_EQ(bucket_from_key(key), bucket);
+
+  // no table for other boards - hand is its own bucket.
+  vector<int> other = string_to_cards("2d7c9hJsKc");
+  ASSERT_EQ(abstraction.InfosetKey(other, board2, handhash), handhash);
+
+  string path = "abstraction_test.bin";
+  abstraction.Save(path);
+  HandAbstraction loaded;
+  loaded.Load(path);
+  remove(path.c_str());
+
+  ASSERT_EQ(loaded.GetBucket(board1, board2, handhash), bucket);
+  ASSERT_EQ(loaded.NumBuckets(board1, board2), 8);
+}
+
+// ChanceNode relabels a non-canonical turn, and the hands with it. The table
+// built for the real turn must still be found, with the same buckets.
+TEST(AbstractionTest, PermutedTurnUsesTheTable) {
+  // GameState puts the board with the lower first card on top.
+  const vector<int> board1 = string_to_cards("2c3h5c2s");
+  const vector<int> board2 = string_to_cards("AcKc8h7s");
+  const vector<int> hand = string_to_cards("AsAdQsJd");
+
+  HandAbstraction abstraction;
+  abstraction.Build(board1, board2, 8, 1, 2, 5);
+
+  GameState state(string_to_cards("2c3h5c"), string_to_cards("AcKc8h"), 2,
+                  50.0, 5.0);
+  state.players_[0].hand = hand;
+  uint64_t used = 0;
+  for (int c : board1) used |= 1ull << c;
+  for (int c : board2) used |= 1ull << c;
+  for (int c : hand) used |= 1ull << c;
+  state.deck.cards.clear();
+  for (int c = 0; c < 52; c++) {
+    if (!(used & (1ull << c))) state.deck.cards.push_back(c);
+  }
+  // dealt from the back: 2s on the top board, 7s on the bottom one.
+  state.deck.cards.push_back(board2[3]);
+  state.deck.cards.push_back(board1[3]);
+
+  ChanceNode chance_node(0);
+  chance_node.GetNextNodeAndState(&state);
+  ASSERT_EQ(state.board1_, string_to_cards("2c3h5c2d"));
+  ASSERT_EQ(state.board2_, string_to_cards("AcKc8h7d"));
+
+  const int expected = abstraction.InfosetKey(board1, board2, hand_index(hand));
+  ASSERT_TRUE(is_bucket_key(expected));
+  ASSERT_EQ(abstraction.InfosetKey(state.board1_, state.board2_,
+                                   hand_index(state.players_[0].hand)),
+            expected);
+
+  // and after a round trip through a file.
+  const string path = "abstraction_permuted_test.bin";
+  abstraction.Save(path);
+  HandAbstraction loaded;
+  loaded.Load(path);
+  remove(path.c_str());
+  ASSERT_EQ(loaded.InfosetKey(state.board1_, state.board2_,
+                              hand_index(state.players_[0].hand)),
+            expected);
+}
@@ -0,0 +1,110 @@
+#include "src/action_tree.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "src/gamestate.h"
+#include "src/helper.h"
+
+// Playing random lines through the tree must match replaying the actions on a
+// GameState.
+static void ExpectTreeMatchesReplay(const TreeConfig& config) {
+  ActionTree tree;
+  tree.Build(config);
+  ASSERT_GT(tree.NumNodes(), 1);
+
+  GameState root(string_to_cards("AcKc8h"), string_to_cards("2s3s5h"),
+                 config.num_players, config.stack_depth, config.ante,
+                 config.bet_sizing);
+
+  mt19937 gen(1);
+  for (int line = 0; line < 1000; line++) {
+    GameState replayed = root;
+    GameState indexed = root;
+    indexed.use_action_tree(&tree);
+
+    while (!replayed.end_of_game()) {
+      ASSERT_FALSE(indexed.end_of_game());
+      ASSERT_EQ(replayed.end_of_action(), indexed.end_of_action());
+      ASSERT_DOUBLE_EQ(replayed.get_pot(), indexed.get_pot());
+
+      if (replayed.end_of_action()) {
+        replayed.next_street();
+        indexed.next_street();
+        continue;
+      }
+
+      ASSERT_EQ(replayed.get_next_to_act(), indexed.get_next_to_act());
+      auto expected = replayed.GetUniformStrategy();
+      auto actual = indexed.GetUniformStrategy();
+      ASSERT_EQ(expected, actual);
+
+      uniform_int_distribution<int> pick(0, expected.size() - 1);
+      HandAction action = expected[pick(gen)].first;
+      replayed.do_next_action(action);
+      indexed.do_next_action(action);
+    }
+
+    ASSERT_TRUE(indexed.end_of_game());
+    ASSERT_DOUBLE_EQ(replayed.get_pot(), indexed.get_pot());
+    for (int p = 0; p < config.num_players; p++) {
+      ASSERT_EQ(replayed.is_folded(p), indexed.is_folded(p));
+    }
+  }
+}
+
+TEST(ActionTreeTest, MatchesReplayedGameState) {
+  TreeConfig config;
+  config.num_players = 3;
+  config.stack_depth = 50.0;
+  config.ante = 5.0;
+  ExpectTreeMatchesReplay(config);
+}
+
+TEST(ActionTreeTest, BetSizeMenu) {
+  TreeConfig config;
+  config.num_players = 2;
+  config.stack_depth = 100.0;
+  config.ante = 5.0;
+
+  ActionTree pot_only;
+  pot_only.Build(config);
+
+  // half pot and pot as the opening bet, pot only when raising, at most
+  // 2 bets per round and shove when committing 60% of the stack.
+  for (auto& street : config.bet_sizing.sizes) {
+    street.fill(action_bit(POT));
+    street[0] |= action_bit(BET_50);
+  }
+  config.bet_sizing.raise_cap = 2;
+  config.bet_sizing.all_in_threshold = 0.6f;
+  ExpectTreeMatchesReplay(config);
+
+  ActionTree sized;
+  sized.Build(config);
+  ASSERT_NE(sized.NumNodes(), pot_only.NumNodes());
+
+  // root: POT, BET50, CHECK
+  ASSERT_EQ(sized.NumActions(0), 3);
+  ASSERT_EQ(sized.Action(0, 0), POT);
+  ASSERT_EQ(sized.Action(0, 1), BET_50);
+  ASSERT_EQ(sized.Action(0, 2), CHECK);
+
+  // after a bet and a raise, only calling or folding is allowed.
+  int node = sized.ChildByAction(0, BET_50);
+  node = sized.ChildByAction(node, POT);
+  ASSERT_EQ(sized.ChildByAction(node, POT), -1);
+  ASSERT_NE(sized.ChildByAction(node, CALL), -1);
+
+  // a state on the tree refuses actions that aren't in the menu, rather than
+  // moving to node -1.
+  GameState state(string_to_cards("AcKc8h"), string_to_cards("2s3s5h"),
+                  config.num_players, config.stack_depth, config.ante,
+                  config.bet_sizing);
+  state.use_action_tree(&sized);
+  state.do_next_action(BET_50);
+  state.do_next_action(POT);
+  EXPECT_THROW(state.do_next_action(POT), runtime_error);
+  EXPECT_EQ(state.get_pot(), sized.Pot(node));
+}
@@ -0,0 +1,71 @@
+#include "src/chancenode.h"
+
+#include <gtest/gtest.h>
+
+#include "src/gamestate.h"
+#include "src/helper.h"
+
+TEST(ChanceNodeTest, BoardSymmetries) {
+  // Only clubs and hearts on the boards, so diamonds and spades can swap.
+  vector<SuitPermutation> symmetries = board_symmetries(
+      string_to_cards("AcKc8h"), string_to_cards("2c3h5c"));
+  ASSERT_EQ(symmetries.size(), 2);
+
+  // Every suit present - no symmetries apart from the identity.
+  symmetries = board_symmetries(string_to_cards("AcKd8h"),
+                                string_to_cards("2s3h5c"));
+  ASSERT_EQ(symmetries.size(), 1);
+}
+
+TEST(ChanceNodeTest, IsomorphicRunoutsShareSubtree) {
+  GameState root(string_to_cards("AcKc8h"), string_to_cards("2c3h5c"), 2,
+                 50.0, 5.0);
+  ChanceNode chance_node(0);
+
+  for (int i = 0; i < 500; i++) {
+    GameState state = root;
+    state.reset();
+    chance_node.GetNextNodeAndState(&state);
+
+    // the lowest representative is always chosen, so the top board never
+    // turns a spade (it would be swapped to a diamond).
+    ASSERT_NE(state.board1_[3] & 0x3, 3);
+  }
+
+  const SuitPermutation swap_ds = {0, 3, 2, 1};
+  for (int t1 = 0; t1 < 52; t1++) {
+    for (int t2 = 0; t2 < 52; t2++) {
+      Node* node = chance_node.GetNextNode(t1, t2);
+      if (node == nullptr) {
+        continue;
+      }
+      ASSERT_EQ(node, chance_node.GetNextNode(permute_card(t1, swap_ds),
+                                              permute_card(t2, swap_ds)));
+    }
+  }
+}
+
+TEST(ChanceNodeTest, GetRunoutsInOrder) {
+  GameState root(string_to_cards("AcKc8h"), string_to_cards("2c3h5c"), 2,
+                 50.0, 5.0);
+  ChanceNode chance_node(0);
+
+  for (int i = 0; i < 200; i++) {
+    GameState state = root;
+    state.reset();
+    chance_node.GetNextNodeAndState(&state);
+  }
+
+  vector<Runout> runouts = chance_node.GetRunouts();
+  ASSERT_FALSE(runouts.empty());
+  for (int i = 0; i < runouts.size(); i++) {
+    const Runout& r = runouts[i];
+    ASSERT_EQ(r.node, chance_node.GetNextNode(r.top_card, r.bottom_card));
+    ASSERT_GE(r.weight, 1);
+    ASSERT_LE(r.weight, 2);
+    if (i > 0) {
+      ASSERT_LT(make_pair(runouts[i - 1].top_card, runouts[i - 1].bottom_card),
+                make_pair(r.top_card, r.bottom_card));
+    }
+  }
+}
@@ -2,6 +2,7 @@
 
 #include <gtest/gtest.h>
 
+#include "src/equity_engine.h"
 #include "src/helper.h"
 
 TEST(EquityCalcTest, Test1) {
@@ -18,3 +19,120 @@ TEST(EquityCalcTest, Test1) {
   ASSERT_EQ(equities[0], 1.0);
   ASSERT_EQ(equities[1], 0.0);
 }
+
+// The fixed seat count version must agree with the vector one, with folded
+// seats (nullptr) getting nothing.
+TEST(EquityCalcTest, FixedPlayers) {
+  vector<vector<int>> hands = {string_to_cards("AcAdKsKh"),
+                               string_to_cards("QcQdJsJh"),
+                               string_to_cards("9c8d7s6h")};
+  vector<int> board1 = string_to_cards("2c5d9hTsJd");
+  vector<int> board2 = string_to_cards("3c4c8h8sAh");
+
+  vector<double> expected = equity_calc(hands, board1, board2);
+
+  array<const int*, 6> seats{};
+  seats[0] = hands[0].data();
+  seats[2] = hands[1].data();
+  seats[3] = hands[2].data();
+  array<double, 6> equities =
+      equity_calc<6>(seats, board1.data(), board2.data());
+
+  ASSERT_DOUBLE_EQ(equities[0], expected[0]);
+  ASSERT_DOUBLE_EQ(equities[1], 0.0);
+  ASSERT_DOUBLE_EQ(equities[2], expected[1]);
+  ASSERT_DOUBLE_EQ(equities[3], expected[2]);
+  ASSERT_DOUBLE_EQ(equities[4], 0.0);
+  ASSERT_DOUBLE_EQ(equities[5], 0.0);
+}
+
+// Both rivers left to come: the Monte Carlo estimate must be within a few
+// standard errors of the exact equity over every pair of rivers.
+TEST(EquityCalcTest, MonteCarloMatchesEnumeration) {
+  vector<vector<int>> hands = {string_to_cards("AcAdKsKh"),
+                               string_to_cards("QcJdTs9s")};
+  vector<int> board1 = string_to_cards("2c5d9hTh");
+  vector<int> board2 = string_to_cards("3c4c8h8s");
+
+  Deck deck;
+  deck.erase(board1);
+  deck.erase(board2);
+  deck.erase(hands[0]);
+  deck.erase(hands[1]);
+
+  double exact = 0.0;
+  int num_runouts = 0;
+  for (int r1 : deck.cards) {
+    for (int r2 : deck.cards) {
+      if (r1 == r2) continue;
+      vector<int> b1 = board1, b2 = board2;
+      b1.push_back(r1);
+      b2.push_back(r2);
+      exact += equity_calc(hands, b1, b2)[0];
+      num_runouts++;
+    }
+  }
+  exact /= num_runouts;
+
+  EquityConfig config;
+  config.num_iterations = 200000;
+  config.num_threads = 4;
+  EquityResult result = monte_carlo_equity(hands, board1, board2, 0, config);
+  ASSERT_EQ(result.equity.size(), 2);
+  EXPECT_NEAR(result.equity[0], exact, 4 * result.std_error[0]);
+  EXPECT_NEAR(result.equity[0] + result.equity[1], 1.0, 1e-9);
+}
+
+// A seed fixes every deal, so the thread count can't change the result.
+TEST(EquityCalcTest, MonteCarloIsReproducible) {
+  EquityConfig config;
+  config.num_iterations = 20000;
+  config.seed = 7;
+
+  config.num_threads = 1;
+  EquityResult one = multiway_equity_calc(
+      string_to_cards("AhKh5c6c"), string_to_cards("JcQdKc"),
+      string_to_cards("8s2h5s"), 6, config);
+  config.num_threads = 3;
+  EquityResult three = multiway_equity_calc(
+      string_to_cards("AhKh5c6c"), string_to_cards("JcQdKc"),
+      string_to_cards("8s2h5s"), 6, config);
+
+  ASSERT_EQ(one.equity.size(), 6);
+  ASSERT_EQ(three.num_threads, 3);
+  double total = 0.0;
+  for (int j = 0; j < 6; j++) {
+    EXPECT_NEAR(one.equity[j], three.equity[j], 1e-12);
+    total += one.equity[j];
+  }
+  EXPECT_NEAR(total, 1.0, 1e-9);
+
+  EXPECT_THROW(monte_carlo_equity({string_to_cards("AcAdKsKh")},
+                                  string_to_cards("Ac2c3c"), {}, 1, config),
+               runtime_error);
+}
+
+// The known hands are ranked a block of boards at a time, the random ones
+// per showdown. Brute force ranks everything per showdown, and a seed has to
+// give the same equities either way.
+TEST(EquityCalcTest, BatchedKnownHandsMatchBruteForce) {
+  EquityConfig config;
+  config.num_iterations = 3000;
+  config.num_threads = 2;
+  config.seed = 11;
+  const vector<vector<int>> hands = {string_to_cards("AhKh5c6c"),
+                                     string_to_cards("QsJsTd9d")};
+
+  set_evaluator_backend(EVALUATOR_HASH_TABLE);
+  EquityResult batched = monte_carlo_equity(
+      hands, string_to_cards("JcQdKc"), string_to_cards("8s2h5s"), 3, config);
+  set_evaluator_backend(EVALUATOR_BRUTE_FORCE);
+  EquityResult brute = monte_carlo_equity(
+      hands, string_to_cards("JcQdKc"), string_to_cards("8s2h5s"), 3, config);
+  set_evaluator_backend(EVALUATOR_AUTO);
+
+  ASSERT_EQ(batched.equity.size(), 5);
+  for (int j = 0; j < 5; j++) {
+    EXPECT_EQ(batched.equity[j], brute.equity[j]);
+  }
+}
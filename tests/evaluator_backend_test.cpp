@@ -0,0 +1,86 @@
+#include "src/evaluator_backend.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "src/equity_calc.h"
+#include "src/helper.h"
+
+using namespace std;
+
+// Random double board showdowns: 10 board cards, then 4 per hand.
+static vector<int> RandomShowdown(mt19937& gen, int num_hands) {
+  vector<int> deck(52);
+  for (int c = 0; c < 52; c++) deck[c] = c;
+  shuffle(deck.begin(), deck.end(), gen);
+  deck.resize(10 + 4 * num_hands);
+  return deck;
+}
+
+TEST(EvaluatorBackendTest, BackendsAgree) {
+  mt19937 gen(17);
+  for (int trial = 0; trial < 2000; trial++) {
+    const int num_hands = 1 + trial % 8;
+    const vector<int> cards = RandomShowdown(gen, num_hands);
+    vector<const int*> hands;
+    for (int j = 0; j < num_hands; j++) {
+      hands.push_back(cards.data() + 10 + 4 * j);
+    }
+
+    vector<int> expected1(num_hands), expected2(num_hands);
+    showdown_evaluator(EVALUATOR_HASH_TABLE)
+        .Evaluate(cards.data(), hands.data(), num_hands, expected1.data());
+    showdown_evaluator(EVALUATOR_HASH_TABLE)
+        .Evaluate(cards.data() + 5, hands.data(), num_hands,
+                  expected2.data());
+
+    for (int b = 0; b < NUM_EVALUATOR_BACKENDS; b++) {
+      SCOPED_TRACE(evaluator_backend_name((EvaluatorBackend)b));
+      const ShowdownEvaluator& evaluator =
+          showdown_evaluator((EvaluatorBackend)b);
+      ASSERT_EQ(evaluator.Backend(), b);
+
+      vector<int> ranks1(num_hands), ranks2(num_hands);
+      evaluator.EvaluateBoards(cards.data(), cards.data() + 5, hands.data(),
+                               num_hands, ranks1.data(), ranks2.data());
+      ASSERT_EQ(ranks1, expected1);
+      ASSERT_EQ(ranks2, expected2);
+    }
+  }
+}
+
+// Pinning a backend must not change any equity, and auto picks a real one.
+TEST(EvaluatorBackendTest, PinnedBackendsGiveTheSameEquity) {
+  vector<vector<int>> hands = {string_to_cards("AcAdKsKh"),
+                               string_to_cards("QcQdJsJh"),
+                               string_to_cards("9c8d7s6h")};
+  vector<int> board1 = string_to_cards("2c5d9hTsJd");
+  vector<int> board2 = string_to_cards("3c4c8h8sAh");
+
+  const EvaluatorBackend saved = evaluator_backend();
+  set_evaluator_backend(EVALUATOR_HASH_TABLE);
+  const vector<double> expected = equity_calc(hands, board1, board2);
+
+  for (int b = 0; b <= EVALUATOR_AUTO; b++) {
+    SCOPED_TRACE(evaluator_backend_name((EvaluatorBackend)b));
+    set_evaluator_backend((EvaluatorBackend)b);
+    ASSERT_EQ(equity_calc(hands, board1, board2), expected);
+  }
+  set_evaluator_backend(saved);
+
+  init_showdown_evaluators();
+  for (int num_hands = 1; num_hands <= MAX_SEATS; num_hands++) {
+    ASSERT_LT(fastest_evaluator_backend(num_hands), NUM_EVALUATOR_BACKENDS);
+  }
+
+  EvaluatorBackend parsed;
+  for (int b = 0; b <= EVALUATOR_AUTO; b++) {
+    ASSERT_TRUE(parse_evaluator_backend(
+        evaluator_backend_name((EvaluatorBackend)b), &parsed));
+    ASSERT_EQ(parsed, b);
+  }
+  ASSERT_FALSE(parse_evaluator_backend("fastest", &parsed));
+}
@@ -0,0 +1,326 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <bitset>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "include/phevaluator.h"
+#include "src/cpu_features.h"
+#include "src/hash.h"
+#include "src/omaha_tables.h"
+#include "src/helper.h"
+
+using namespace std;
+
+// Best 5 card rank out of cards, by trying every subset.
+static int BruteForce(const vector<int>& cards) {
+  const int n = cards.size();
+  int best = 100000;
+  for (int a = 0; a < n; a++)
+    for (int b = a + 1; b < n; b++)
+      for (int c = b + 1; c < n; c++)
+        for (int d = c + 1; d < n; d++)
+          for (int e = d + 1; e < n; e++)
+            best = min(best, evaluate_5cards(cards[a], cards[b], cards[c],
+                                             cards[d], cards[e]));
+  return best;
+}
+
+// Best Omaha rank: exactly 2 of the hole cards and 3 of the board.
+static int BruteForceOmaha(const vector<int>& board, const vector<int>& hole) {
+  int best = 100000;
+  for (int a = 0; a < hole.size(); a++)
+    for (int b = a + 1; b < hole.size(); b++)
+      for (int c = 0; c < 5; c++)
+        for (int d = c + 1; d < 5; d++)
+          for (int e = d + 1; e < 5; e++)
+            best = min(best, evaluate_5cards(hole[a], hole[b], board[c],
+                                             board[d], board[e]));
+  return best;
+}
+
+static vector<int> RandomCards(mt19937& gen, int n) {
+  vector<int> deck(52);
+  for (int i = 0; i < 52; i++) deck[i] = i;
+  shuffle(deck.begin(), deck.end(), gen);
+  deck.resize(n);
+  return deck;
+}
+
+TEST(EvaluatorTest, KnownRanks) {
+  auto rank = [](const string& s) {
+    vector<int> c = string_to_cards(s);
+    return evaluate_5cards(c[0], c[1], c[2], c[3], c[4]);
+  };
+
+  EXPECT_EQ(rank("AsKsQsJsTs"), 1);
+  EXPECT_EQ(rank("5h4h3h2hAh"), 10);
+  EXPECT_EQ(rank("AsAdAcAhKs"), 11);
+  EXPECT_EQ(rank("AsKsQsJs9s"), 323);
+  EXPECT_EQ(rank("AsKdQsJsTs"), 1600);
+  EXPECT_EQ(rank("5d4h3h2hAh"), 1609);
+  EXPECT_EQ(rank("7s5d4h3h2h"), 7462);
+
+  vector<int> c = string_to_cards("AsKdQsJsTs2c3c");
+  EXPECT_EQ(phevaluator::EvaluateCards(c[0], c[1], c[2], c[3], c[4], c[5],
+                                       c[6])
+                .describeCategory(),
+            "Straight");
+}
+
+TEST(EvaluatorTest, SixAndSevenCardsPickBestFive) {
+  mt19937 gen(7);
+  for (int i = 0; i < 5000; i++) {
+    vector<int> c = RandomCards(gen, 7);
+    ASSERT_EQ(evaluate_7cards(c[0], c[1], c[2], c[3], c[4], c[5], c[6]),
+              BruteForce(c));
+
+    c.pop_back();
+    ASSERT_EQ(evaluate_6cards(c[0], c[1], c[2], c[3], c[4], c[5]),
+              BruteForce(c));
+  }
+}
+
+// Every dispatch level the cpu has must give the same ranks.
+TEST(EvaluatorTest, BatchMatchesSingleHands) {
+  const cpu_level saved = cpu_dispatch_level();
+  for (int level = 0; level <= cpu_detected_level(); level++) {
+    SCOPED_TRACE(cpu_level_name((cpu_level)level));
+    set_cpu_dispatch_level((cpu_level)level);
+
+    mt19937 gen(11);
+    for (int trial = 0; trial < 200; trial++) {
+      for (int board_size = 3; board_size <= 5; board_size++) {
+        for (int hand_size = 5 - board_size; board_size + hand_size <= 7;
+             hand_size++) {
+          if (hand_size == 0) continue;
+
+          vector<int> cards = RandomCards(gen, 52);
+          vector<int> board(cards.begin(), cards.begin() + board_size);
+          vector<int> hands(cards.begin() + board_size, cards.end());
+          const int num_hands = hands.size() / hand_size;
+
+          board_context context;
+          init_board_context(&context, board.data(), board_size);
+          vector<int> ranks(num_hands);
+          evaluate_batch(&context, hands.data(), hand_size, num_hands,
+                         ranks.data());
+
+          for (int i = 0; i < num_hands; i++) {
+            vector<int> all = board;
+            all.insert(all.end(), hands.begin() + i * hand_size,
+                       hands.begin() + (i + 1) * hand_size);
+            ASSERT_EQ(ranks[i], BruteForce(all));
+          }
+        }
+      }
+    }
+  }
+  set_cpu_dispatch_level(saved);
+}
+
+TEST(EvaluatorTest, OmahaMatchesBruteForce) {
+  mt19937 gen(13);
+  for (int i = 0; i < 20000; i++) {
+    vector<int> c = RandomCards(gen, 11);
+    // every other hand gets a two tone board, so flushes come up often.
+    if (i % 2) {
+      for (int j = 0; j < 11; j++) c[j] = (c[j] & ~0x3) | (j % 2);
+      sort(c.begin(), c.end());
+      if (unique(c.begin(), c.end()) != c.end()) continue;
+      shuffle(c.begin(), c.end(), gen);
+    }
+    vector<int> board(c.begin(), c.begin() + 5);
+    vector<int> hole(c.begin() + 5, c.end());
+
+    ASSERT_EQ(evaluate_plo6_cards(c[0], c[1], c[2], c[3], c[4], c[5], c[6],
+                                  c[7], c[8], c[9], c[10]),
+              BruteForceOmaha(board, hole));
+
+    hole.pop_back();
+    ASSERT_EQ(evaluate_plo5_cards(c[0], c[1], c[2], c[3], c[4], c[5], c[6],
+                                  c[7], c[8], c[9]),
+              BruteForceOmaha(board, hole));
+
+    hole.pop_back();
+    ASSERT_EQ(evaluate_plo4_cards(c[0], c[1], c[2], c[3], c[4], c[5], c[6],
+                                  c[7], c[8]),
+              BruteForceOmaha(board, hole));
+  }
+
+  vector<int> c = string_to_cards("AsKsQs2d3dJsTs4h5h6h7h");
+  EXPECT_EQ(phevaluator::EvaluatePlo6Cards(c[0], c[1], c[2], c[3], c[4], c[5],
+                                           c[6], c[7], c[8], c[9], c[10])
+                .value(),
+            1);
+}
+
+TEST(EvaluatorTest, Plo4BoardsMatchSingleHands) {
+  mt19937 gen(17);
+  // 10 boards evaluate hand by hand, 2000 read the hole-major tables.
+  for (int num_boards : {10, 2000}) {
+    for (int trial = 0; trial < 20; trial++) {
+      vector<int> hole = RandomCards(gen, 4);
+      vector<int> boards;
+      for (int i = 0; i < num_boards; i++) {
+        vector<int> c = RandomCards(gen, 52);
+        // every other board is two tone, so flushes come up often.
+        c.erase(remove_if(c.begin(), c.end(),
+                          [&](int card) {
+                            return find(hole.begin(), hole.end(), card) !=
+                                       hole.end() ||
+                                   (i % 2 && (card & 0x3) >= 2);
+                          }),
+                c.end());
+        boards.insert(boards.end(), c.begin(), c.begin() + 5);
+      }
+
+      vector<int> ranks(num_boards);
+      evaluate_plo4_boards(hole.data(), boards.data(), num_boards,
+                           ranks.data());
+      for (int i = 0; i < num_boards; i++) {
+        const int* b = &boards[i * 5];
+        ASSERT_EQ(ranks[i], evaluate_plo4_cards(b[0], b[1], b[2], b[3], b[4],
+                                                hole[0], hole[1], hole[2],
+                                                hole[3]));
+      }
+    }
+  }
+}
+
+TEST(EvaluatorTest, Plo4HoleKeysMatchSingleHands) {
+  mt19937 gen(19);
+  for (int i = 0; i < 100000; i++) {
+    vector<int> c = RandomCards(gen, 9);
+    if (i % 2) {
+      // two tone, so flushes come up often.
+      for (int& card : c) card &= ~0x2;
+      sort(c.begin(), c.end());
+      if (unique(c.begin(), c.end()) != c.end()) continue;
+      shuffle(c.begin(), c.end(), gen);
+    }
+
+    plo4_board_context board;
+    init_plo4_board_context(&board, c.data());
+    const int hole = plo4_hole_index(&c[5]);
+    ASSERT_EQ(hole, hand_index(vector<int>(c.begin() + 5, c.end())));
+    ASSERT_EQ(evaluate_plo4_hole(&board, hole),
+              evaluate_plo4_cards(c[0], c[1], c[2], c[3], c[4], c[5], c[6],
+                                  c[7], c[8]));
+  }
+}
+
+TEST(EvaluatorTest, Plo4CompactMatchesFlat) {
+  const omaha_tables* flat = plo4_tables();
+  if (flat->noflush == nullptr) {
+    GTEST_SKIP() << "compact builds have no flat noflush table";
+  }
+  const plo4_compact_tables* compact = plo4_compact();
+  for (int board_hash = 0; board_hash < 6175; board_hash++) {
+    for (int hole_hash = 0; hole_hash < 1820; hole_hash++) {
+      ASSERT_EQ(plo4_compact_noflush(compact, board_hash, hole_hash),
+                flat->noflush[board_hash * 1820 + hole_hash]);
+    }
+  }
+}
+
+TEST(EvaluatorTest, OmahaTablesCacheRoundTrip) {
+  const string path = testing::TempDir() + "plo4_cache_test.bin";
+  const omaha_tables* generated = plo4_tables();
+  ASSERT_TRUE(save_omaha_tables(path.c_str(), 4, generated));
+
+  // a cache for other tables must not load.
+  omaha_tables loaded;
+  EXPECT_FALSE(load_omaha_tables(path.c_str(), 5, &loaded));
+
+  ASSERT_TRUE(load_omaha_tables(path.c_str(), 4, &loaded));
+  EXPECT_TRUE(equal(loaded.flush, loaded.flush + 3003 * 1365,
+                    generated->flush));
+  if (generated->noflush == nullptr) {
+    EXPECT_EQ(loaded.noflush, nullptr);
+  } else {
+    EXPECT_TRUE(equal(loaded.noflush, loaded.noflush + 6175 * 1820,
+                      generated->noflush));
+  }
+  remove(path.c_str());
+}
+
+// Every way of mapping the cache must give the same tables. Hugetlb mappings
+// copy the tables into a hugetlbfs mount, so they are only tested when
+// PHEVALUATOR_HUGETLB_DIR names one the test may write to, and the copy is
+// removed afterwards. Without enough huge pages they fall back to ordinary
+// mappings.
+TEST(EvaluatorTest, OmahaTablesCacheMappings) {
+  const string path = testing::TempDir() + "plo4_mapping_test.bin";
+  const omaha_tables* generated = plo4_tables();
+  ASSERT_TRUE(save_omaha_tables(path.c_str(), 4, generated));
+
+  vector<table_pages> modes = {TABLE_PAGES_DEFAULT, TABLE_PAGES_MADVISE};
+  const char* hugetlb_dir = getenv("PHEVALUATOR_HUGETLB_DIR");
+  if (hugetlb_dir != nullptr) {
+    modes.push_back(TABLE_PAGES_HUGETLB);
+  }
+
+  const table_mapping saved = get_table_mapping();
+  for (table_pages pages : modes) {
+    for (int prefault = 0; prefault <= 1; prefault++) {
+      set_table_mapping({pages, prefault});
+      omaha_tables loaded;
+      ASSERT_TRUE(load_omaha_tables(path.c_str(), 4, &loaded));
+      EXPECT_TRUE(equal(loaded.flush, loaded.flush + 3003 * 1365,
+                        generated->flush));
+      if (generated->noflush != nullptr) {
+        EXPECT_TRUE(equal(loaded.noflush, loaded.noflush + 6175 * 1820,
+                          generated->noflush));
+      }
+    }
+  }
+  set_table_mapping(saved);
+  remove(path.c_str());
+  if (hugetlb_dir != nullptr) {
+    // the mappings above keep the copy's pages until the process exits.
+    remove((string(hugetlb_dir) + "/phevaluator-plo4.bin").c_str());
+    remove((string(hugetlb_dir) + "/phevaluator-plo4-compact.bin").c_str());
+  }
+}
+
+TEST(EvaluatorTest, HashKernelsMatchScalar) {
+  if (!cpu_has_bmi2()) {
+    GTEST_SKIP() << "no BMI2";
+  }
+
+  // every multiset of k ranks, at most 4 of each.
+  for (int k = 1; k <= 7; k++) {
+    vector<unsigned char> q(13);
+    function<void(int, int)> visit = [&](int rank, int left) {
+      if (rank == 13) {
+        if (left == 0) {
+          ASSERT_EQ(hash_quinary_bmi2(q.data(), k),
+                    hash_quinary_scalar(q.data(), k));
+        }
+        return;
+      }
+      for (int n = 0; n <= 4 && n <= left; n++) {
+        q[rank] = n;
+        visit(rank + 1, left - n);
+      }
+      q[rank] = 0;
+    };
+    visit(0, k);
+  }
+
+  // every length the Omaha tables use, up to the PLO6 holes' 17 bits, and
+  // every k the choose table covers.
+  for (int len : {13, 15, 16, 17}) {
+    for (int binary = 0; binary < (1 << len); binary++) {
+      const int k = bitset<17>(binary).count();
+      if (k == 0 || k > 9) continue;
+      ASSERT_EQ(hash_binary_len_bmi2(binary, len, k),
+                hash_binary_len_scalar(binary, len, k));
+    }
+  }
+}
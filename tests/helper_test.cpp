@@ -0,0 +1,43 @@
+#include "src/helper.h"
+
+#include <gtest/gtest.h>
+
+// Walking the hands in colex order must visit every index once, in order.
+TEST(HandIndexTest, ColexBijection) {
+  int expected = 0;
+  for (int d = 3; d < 52; d++) {
+    for (int c = 2; c < d; c++) {
+      for (int b = 1; b < c; b++) {
+        for (int a = 0; a < b; a++) {
+          uint64_t mask = (1ull << a) | (1ull << b) | (1ull << c) | (1ull << d);
+          ASSERT_EQ(hand_index(mask), expected);
+
+          array<int, 4> hand = hand_from_index(expected);
+          ASSERT_EQ(hand, (array<int, 4>{a, b, c, d}));
+          expected++;
+        }
+      }
+    }
+  }
+  ASSERT_EQ(expected, NUM_HANDS);
+}
+
+TEST(HandIndexTest, OrderDoesntMatter) {
+  int index = hand_index(string_to_cards("AsKd2c7h"));
+  ASSERT_EQ(hand_index(string_to_cards("7h2cKdAs")), index);
+  ASSERT_EQ(hand_index_to_string(index), "2c7hKdAs");
+}
+
+// rand_double must resolve more than a float's 24 bits, or sampling from a
+// cumulative sum over every hand can never land on most of them.
+TEST(RandTest, DoubleUsesMoreThanFloatPrecision) {
+  int fine = 0;
+  for (int i = 0; i < 100; i++) {
+    const double x = rand_double();
+    ASSERT_GE(x, 0.0);
+    ASSERT_LT(x, 1.0);
+    const double scaled = ldexp(x, 24);
+    if (scaled != floor(scaled)) fine++;
+  }
+  EXPECT_GT(fine, 90);
+}
@@ -0,0 +1,82 @@
+#include "src/kernels.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+// Runs f once for every dispatch level the cpu has. Callers restore the
+// level they started with.
+template <typename F>
+static void ForEachLevel(F f) {
+  for (int level = 0; level <= cpu_detected_level(); level++) {
+    SCOPED_TRACE(cpu_level_name((cpu_level)level));
+    set_cpu_dispatch_level((cpu_level)level);
+    f();
+  }
+}
+
+TEST(KernelsTest, ShowdownWinnersMatchScalar) {
+  const cpu_level saved = cpu_dispatch_level();
+  mt19937 gen(3);
+  vector<array<int, MAX_SEATS>> rows(20000);
+  for (auto& ranks : rows) {
+    // few distinct ranks, so ties are common. some seats are folded.
+    const int num_seats = uniform_int_distribution<int>(1, MAX_SEATS)(gen);
+    for (int j = 0; j < MAX_SEATS; j++) {
+      ranks[j] = j < num_seats && gen() % 4 ? 1 + gen() % 8 : NO_SEAT_RANK;
+    }
+    ranks[gen() % num_seats] = 1 + gen() % 8;
+  }
+
+  set_cpu_dispatch_level(CPU_LEVEL_SCALAR);
+  vector<unsigned> expected;
+  for (const auto& ranks : rows) {
+    unsigned winners = 0;
+    int best = NO_SEAT_RANK;
+    for (int j = 0; j < MAX_SEATS; j++) best = min(best, ranks[j]);
+    for (int j = 0; j < MAX_SEATS; j++) {
+      if (ranks[j] == best) winners |= 1u << j;
+    }
+    ASSERT_EQ(showdown_winners(ranks.data()), winners);
+    expected.push_back(winners);
+  }
+
+  ForEachLevel([&] {
+    for (int i = 0; i < rows.size(); i++) {
+      ASSERT_EQ(showdown_winners(rows[i].data()), expected[i]);
+    }
+  });
+  set_cpu_dispatch_level(saved);
+}
+
+TEST(KernelsTest, RegretMatchMatchesScalar) {
+  const cpu_level saved = cpu_dispatch_level();
+  mt19937 gen(5);
+  uniform_real_distribution<double> regret(-10.0, 10.0);
+  for (int trial = 0; trial < 2000; trial++) {
+    // every length up to past the widest vector, with some all negative.
+    const int n = 1 + trial % 20;
+    vector<double> regrets(n);
+    for (double& r : regrets) r = regret(gen) - (trial % 7 == 0 ? 20.0 : 0.0);
+
+    set_cpu_dispatch_level(CPU_LEVEL_SCALAR);
+    vector<double> expected(n, -1.0);
+    const bool expected_ok = regret_match(regrets.data(), n, expected.data());
+
+    ForEachLevel([&] {
+      vector<double> strategy(n, -1.0);
+      ASSERT_EQ(regret_match(regrets.data(), n, strategy.data()),
+                expected_ok);
+      // bit identical, so a seed solves the same on any machine.
+      ASSERT_EQ(memcmp(strategy.data(), expected.data(), n * sizeof(double)),
+                0);
+    });
+  }
+  set_cpu_dispatch_level(saved);
+}
@@ -1,4 +1,9 @@
+#include "src/node.h"
+
 #include <gtest/gtest.h>
+
+#include "src/helper.h"
+
 // gpt code (stub - testing cmake)
 //
 //
@@ -17,7 +22,121 @@ TEST(AdditionTest, MixedNumbers) {
   EXPECT_EQ(add(1, -1), 0);  // 1 + (-1) = 0
 }
 
+// The average strategy is computed from the strategy sums on demand, and the
+// cached copy must not survive an update.
+TEST(NodeTest, AverageStrategyIsCachedUntilAdjusted) {
+  GameState state(string_to_cards("AcKc8h"), string_to_cards("2s3s5h"), 2,
+                  50.0, 5.0);
+  Node node(state.get_next_to_act());
+  const int hand = hand_index(state.players_[0].hand);
+
+  array<double, MAX_HAND_ACTIONS> average;
+  ASSERT_FALSE(node.GetAverageStrategy(hand, average));
+
+  array<double, MAX_HAND_ACTIONS> ev{};
+  ev[POT] = 10.0;
+
+  // first update plays the uniform strategy over {POT, CHECK}.
+  node.AdjustStrategy(&state, ev, hand, 1.0);
+  ASSERT_TRUE(node.GetAverageStrategy(hand, average));
+  EXPECT_DOUBLE_EQ(average[POT], 0.5);
+  EXPECT_DOUBLE_EQ(average[CHECK], 0.5);
+
+  // only POT has positive regret, so the second update plays POT.
+  node.AdjustStrategy(&state, ev, hand, 1.0);
+  ASSERT_TRUE(node.GetAverageStrategy(hand, average));
+  EXPECT_DOUBLE_EQ(average[POT], 0.75);
+  EXPECT_DOUBLE_EQ(average[CHECK], 0.25);
+
+  array<double, MAX_HAND_ACTIONS> current;
+  ASSERT_TRUE(node.GetCurrentStrategy(hand, current));
+  EXPECT_DOUBLE_EQ(current[POT], 1.0);
+  EXPECT_DOUBLE_EQ(node.AverageStrategyProbability(hand, CHECK, 0.0), 0.25);
+}
+
+// Only actions regret matching gives probability 0 are pruned, and a pruned
+// action's regret and strategy sum are left alone.
+TEST(NodeTest, PrunedActionsKeepTheirRegret) {
+  GameState state(string_to_cards("AcKc8h"), string_to_cards("2s3s5h"), 2,
+                  50.0, 5.0);
+  Node node(state.get_next_to_act());
+  const int hand = hand_index(state.players_[0].hand);
+  EXPECT_EQ(node.PrunedActions(hand, 0.0), 0u);
+
+  array<double, MAX_HAND_ACTIONS> ev{};
+  ev[POT] = 10.0;
+  node.AdjustStrategy(&state, ev, hand, 1.0);  // POT +5, CHECK -5
+
+  EXPECT_EQ(node.PrunedActions(hand, -10.0), 0u);
+  const uint32_t pruned = node.PrunedActions(hand, -1.0);
+  EXPECT_EQ(pruned, 1u << CHECK);
+
+  const double check_regret = node.FindRow(hand)->regret[CHECK];
+  const double check_sum = node.FindRow(hand)->strategy_sum[CHECK];
+  node.AdjustStrategy(&state, ev, hand, 1.0, pruned);
+  EXPECT_EQ(node.FindRow(hand)->regret[CHECK], check_regret);
+  EXPECT_EQ(node.FindRow(hand)->strategy_sum[CHECK], check_sum);
+  EXPECT_DOUBLE_EQ(node.FindRow(hand)->regret[POT], 5.0);
+}
+
+// Reading every hand's average (as snapshots and subgame ranges do) keeps the
+// cache at a fixed size, and an update only drops its own hand.
+TEST(NodeTest, AverageStrategyCacheIsBounded) {
+  GameState state(string_to_cards("AcKc8h"), string_to_cards("2s3s5h"), 2,
+                  50.0, 5.0);
+  Node node(state.get_next_to_act());
+  EXPECT_EQ(node.NumCachedAverages(), 0);
+
+  array<double, MAX_HAND_ACTIONS> ev{};
+  ev[POT] = 10.0;
+  for (int hand = 0; hand < NUM_HANDS; hand += 7) {
+    node.AdjustStrategy(&state, ev, hand, 1.0);
+  }
+
+  array<double, MAX_HAND_ACTIONS> average;
+  for (int hand = 0; hand < NUM_HANDS; hand += 7) {
+    ASSERT_TRUE(node.GetAverageStrategy(hand, average));
+  }
+  const int num_cached = node.NumCachedAverages();
+  EXPECT_GT(num_cached, 0);
+  EXPECT_LE(num_cached, 1024);
+
+  // the last hand read is cached until it is updated.
+  const int last = (NUM_HANDS - 1) / 7 * 7;
+  node.AdjustStrategy(&state, ev, last, 1.0);
+  EXPECT_EQ(node.NumCachedAverages(), num_cached - 1);
+  ASSERT_TRUE(node.GetAverageStrategy(last, average));
+  EXPECT_DOUBLE_EQ(average[POT], 0.75);
+  EXPECT_EQ(node.NumCachedAverages(), num_cached);
+}
+
 // int main(int argc, char **argv) {
 //   ::testing::InitGoogleTest(&argc, argv);
 //   return RUN_ALL_TESTS();  // Runs all the test cases
 // }
+
+// The current strategy is stored next to the regrets and rematched on every
+// update, so sampling reads the row as it is.
+TEST(NodeTest, CurrentStrategyIsKeptWithTheRegrets) {
+  GameState state(string_to_cards("AcKc8h"), string_to_cards("2s3s5h"), 2,
+                  50.0, 5.0);
+  Node node(state.get_next_to_act());
+  const int hand = hand_index(state.players_[0].hand);
+
+  array<double, MAX_HAND_ACTIONS> ev{};
+  ev[POT] = 10.0;
+  ev[CHECK] = 4.0;
+  node.AdjustStrategy(&state, ev, hand, 1.0);  // POT +3, CHECK -3
+
+  const Node::InfosetRow* row = node.FindRow(hand);
+  ASSERT_NE(row, nullptr);
+  EXPECT_EQ(row->strategy[POT], 1.0);
+  EXPECT_EQ(row->strategy[CHECK], 0.0);
+  EXPECT_EQ(node.GetNextAction(&state, hand), make_pair(POT, 1.0));
+
+  ev[POT] = 0.0;
+  node.AdjustStrategy(&state, ev, hand, 1.0);  // POT +0, CHECK +4
+  EXPECT_EQ(row->strategy[POT], 0.75);
+  EXPECT_EQ(row->strategy[CHECK], 0.25);
+  EXPECT_EQ(node.updates_, 2);
+}
@@ -1,10 +1,17 @@
 
 #include <gtest/gtest.h>
 
+#include <array>
+#include <bitset>
 #include <chrono>
 #include <iostream>
 #include <thread>
 
+#include "src/cpu_features.h"
+#include "src/equity_engine.h"
+#include "src/evaluator_backend.h"
+#include "src/hash.h"
+#include "src/omaha_tables.h"
 #include "src/simulation.h"
 
 TEST(Profiling, Recurse) {
@@ -22,3 +29,319 @@ TEST(Profiling, Recurse) {
   this_thread::sleep_for(chrono::seconds(5));
   sim.StopSolver();
 }
+
+// Runs f (which returns a checksum, so the work isn't optimised away) and
+// prints its throughput.
+template <typename F>
+static void Benchmark(const string& name, long long num_evals, F f) {
+  auto start = chrono::steady_clock::now();
+  long long checksum = f();
+  double seconds =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+  cout << name << ": " << num_evals / seconds / 1e6 << "M evals/s (checksum "
+       << checksum << ")" << endl;
+}
+
+// Random, distinct cards: num_rows rows of row_size.
+static vector<int> RandomRows(int num_rows, int row_size = 7) {
+  vector<int> rows;
+  Deck deck;
+  for (int i = 0; i < num_rows; i++) {
+    deck.reset();
+    vector<int> row = deck.deal_with_modification(row_size);
+    rows.insert(rows.end(), row.begin(), row.end());
+  }
+  return rows;
+}
+
+TEST(Profiling, EvaluateCards) {
+  const int NUM_SAMPLES = 1 << 20;
+  const vector<int> rows = RandomRows(NUM_SAMPLES);
+  const int* c = rows.data();
+
+  Benchmark("evaluate_5cards", NUM_SAMPLES, [&]() {
+    long long sum = 0;
+    for (int i = 0; i < NUM_SAMPLES * 7; i += 7)
+      sum += evaluate_5cards(c[i], c[i + 1], c[i + 2], c[i + 3], c[i + 4]);
+    return sum;
+  });
+  Benchmark("evaluate_6cards", NUM_SAMPLES, [&]() {
+    long long sum = 0;
+    for (int i = 0; i < NUM_SAMPLES * 7; i += 7)
+      sum += evaluate_6cards(c[i], c[i + 1], c[i + 2], c[i + 3], c[i + 4],
+                             c[i + 5]);
+    return sum;
+  });
+  Benchmark("evaluate_7cards", NUM_SAMPLES, [&]() {
+    long long sum = 0;
+    for (int i = 0; i < NUM_SAMPLES * 7; i += 7)
+      sum += evaluate_7cards(c[i], c[i + 1], c[i + 2], c[i + 3], c[i + 4],
+                             c[i + 5], c[i + 6]);
+    return sum;
+  });
+
+  // every 2 card hand on one flop and one turn.
+  for (const string& board_string : vector<string>{"AcKd8h", "AcKd8h2s"}) {
+    vector<int> board = string_to_cards(board_string);
+    vector<int> hands;
+    for (int a = 0; a < 52; a++) {
+      for (int b = a + 1; b < 52; b++) {
+        if (find(board.begin(), board.end(), a) == board.end() &&
+            find(board.begin(), board.end(), b) == board.end()) {
+          hands.push_back(a);
+          hands.push_back(b);
+        }
+      }
+    }
+    const int num_hands = hands.size() / 2;
+    const int repeats = NUM_SAMPLES / num_hands;
+    vector<int> ranks(num_hands);
+
+    board_context context;
+    init_board_context(&context, board.data(), board.size());
+
+    // once per dispatch level the cpu has.
+    const cpu_level saved = cpu_dispatch_level();
+    for (int level = 0; level <= cpu_detected_level(); level++) {
+      set_cpu_dispatch_level((cpu_level)level);
+      Benchmark("evaluate_batch " + board_string + " " +
+                    cpu_level_name((cpu_level)level),
+                (long long)repeats * num_hands, [&]() {
+                  long long sum = 0;
+                  for (int r = 0; r < repeats; r++) {
+                    evaluate_batch(&context, hands.data(), 2, num_hands,
+                                   ranks.data());
+                    sum += ranks[r % num_hands];
+                  }
+                  return sum;
+                });
+    }
+    set_cpu_dispatch_level(saved);
+  }
+}
+
+TEST(Profiling, EvaluatePloCards) {
+  const int NUM_SAMPLES = 1 << 20;
+  const vector<int> rows = RandomRows(NUM_SAMPLES, 11);
+  const int* c = rows.data();
+
+  // build the tables outside of the timed loops.
+  evaluate_plo5_cards(c[0], c[1], c[2], c[3], c[4], c[5], c[6], c[7], c[8],
+                      c[9]);
+  evaluate_plo6_cards(c[0], c[1], c[2], c[3], c[4], c[5], c[6], c[7], c[8],
+                      c[9], c[10]);
+
+  Benchmark("evaluate_plo5_cards", NUM_SAMPLES, [&]() {
+    long long sum = 0;
+    for (int i = 0; i < NUM_SAMPLES * 11; i += 11)
+      sum += evaluate_plo5_cards(c[i], c[i + 1], c[i + 2], c[i + 3], c[i + 4],
+                                 c[i + 5], c[i + 6], c[i + 7], c[i + 8],
+                                 c[i + 9]);
+    return sum;
+  });
+  Benchmark("evaluate_plo6_cards", NUM_SAMPLES, [&]() {
+    long long sum = 0;
+    for (int i = 0; i < NUM_SAMPLES * 11; i += 11)
+      sum += evaluate_plo6_cards(c[i], c[i + 1], c[i + 2], c[i + 3], c[i + 4],
+                                 c[i + 5], c[i + 6], c[i + 7], c[i + 8],
+                                 c[i + 9], c[i + 10]);
+    return sum;
+  });
+}
+
+TEST(Profiling, Plo4NoflushLayouts) {
+  const int NUM_SAMPLES = 1 << 22;
+  const vector<int> rows = RandomRows(NUM_SAMPLES, 9);
+
+  // the quinary hashes of random PLO4 hands, as showdown loops see them.
+  vector<int> board_hashes(NUM_SAMPLES), hole_hashes(NUM_SAMPLES);
+  for (int i = 0; i < NUM_SAMPLES; i++) {
+    unsigned char board[13] = {0}, hole[13] = {0};
+    for (int j = 0; j < 5; j++) board[rows[i * 9 + j] >> 2]++;
+    for (int j = 5; j < 9; j++) hole[rows[i * 9 + j] >> 2]++;
+    board_hashes[i] = hash_quinary(board, 5);
+    hole_hashes[i] = hash_quinary(hole, 4);
+  }
+
+  const omaha_tables* flat = plo4_tables();
+  const plo4_compact_tables* compact = plo4_compact();
+  if (flat->noflush != nullptr) {
+    Benchmark("noflush_plo4 flat", NUM_SAMPLES, [&]() {
+      long long sum = 0;
+      for (int i = 0; i < NUM_SAMPLES; i++)
+        sum += flat->noflush[board_hashes[i] * 1820 + hole_hashes[i]];
+      return sum;
+    });
+  }
+  Benchmark("noflush_plo4 compact", NUM_SAMPLES, [&]() {
+    long long sum = 0;
+    for (int i = 0; i < NUM_SAMPLES; i++)
+      sum += plo4_compact_noflush(compact, board_hashes[i], hole_hashes[i]);
+    return sum;
+  });
+}
+
+TEST(Profiling, Plo4OneHandManyBoards) {
+  const int NUM_BOARDS = 1 << 20;
+  const vector<int> hole = string_to_cards("AhKhQsJs");
+  vector<int> boards;
+  Deck deck;
+  for (int i = 0; i < NUM_BOARDS; i++) {
+    deck.reset();
+    deck.erase(hole);
+    vector<int> board = deck.deal_with_modification(5);
+    boards.insert(boards.end(), board.begin(), board.end());
+  }
+  vector<int> ranks(NUM_BOARDS);
+  const int* b = boards.data();
+  const int* h = hole.data();
+
+  // build the tables outside of the timed loops.
+  evaluate_plo4_boards(h, b, NUM_BOARDS, ranks.data());
+
+  Benchmark("evaluate_plo4_cards, one hand", NUM_BOARDS, [&]() {
+    long long sum = 0;
+    for (int i = 0; i < NUM_BOARDS * 5; i += 5)
+      sum += evaluate_plo4_cards(b[i], b[i + 1], b[i + 2], b[i + 3], b[i + 4],
+                                 h[0], h[1], h[2], h[3]);
+    return sum;
+  });
+  Benchmark("evaluate_plo4_boards", NUM_BOARDS, [&]() {
+    evaluate_plo4_boards(h, b, NUM_BOARDS, ranks.data());
+    long long sum = 0;
+    for (int rank : ranks) sum += rank;
+    return sum;
+  });
+}
+
+TEST(Profiling, Plo4Showdown) {
+  // a 6 handed showdown per row: 5 board cards and 6 holes.
+  const int NUM_ROWS = 1 << 18;
+  const int ROW = 5 + 6 * 4;
+  const vector<int> rows = RandomRows(NUM_ROWS, ROW);
+  const int* c = rows.data();
+
+  // build the tables outside of the timed loops.
+  plo4_board_context board;
+  init_plo4_board_context(&board, c);
+  evaluate_plo4_hole(&board, plo4_hole_index(c + 5));
+
+  Benchmark("evaluate_plo4_cards, 6 hands a board", NUM_ROWS * 6, [&]() {
+    long long sum = 0;
+    for (int i = 0; i < NUM_ROWS * ROW; i += ROW)
+      for (int h = i + 5; h < i + ROW; h += 4)
+        sum += evaluate_plo4_cards(c[i], c[i + 1], c[i + 2], c[i + 3],
+                                   c[i + 4], c[h], c[h + 1], c[h + 2],
+                                   c[h + 3]);
+    return sum;
+  });
+  Benchmark("evaluate_plo4_hole, 6 hands a board", NUM_ROWS * 6, [&]() {
+    long long sum = 0;
+    for (int i = 0; i < NUM_ROWS * ROW; i += ROW) {
+      init_plo4_board_context(&board, c + i);
+      for (int h = i + 5; h < i + ROW; h += 4)
+        sum += evaluate_plo4_hole(&board, plo4_hole_index(c + h));
+    }
+    return sum;
+  });
+}
+
+TEST(Profiling, HashKernels) {
+  const int NUM_SAMPLES = 1 << 20;
+  const vector<int> rows = RandomRows(NUM_SAMPLES, 5);
+  vector<array<unsigned char, 13>> quinaries(NUM_SAMPLES);
+  vector<int> binaries(NUM_SAMPLES);
+  for (int i = 0; i < NUM_SAMPLES; i++) {
+    quinaries[i].fill(0);
+    int binary = 0;
+    for (int j = 0; j < 5; j++) {
+      quinaries[i][rows[i * 5 + j] >> 2]++;
+      binary |= 1 << (rows[i * 5 + j] >> 2);
+    }
+    // pad to 5 bits of 15, like the PLO4 flush path.
+    for (int bit = 13; bitset<16>(binary).count() < 5; bit++) {
+      binary |= 1 << bit;
+    }
+    binaries[i] = binary;
+  }
+
+  auto quinary = [&](int (*hash)(const unsigned char[], int)) {
+    return [&, hash]() {
+      long long sum = 0;
+      for (const auto& q : quinaries) sum += hash(q.data(), 5);
+      return sum;
+    };
+  };
+  auto binary = [&](int (*hash)(const int, int, int)) {
+    return [&, hash]() {
+      long long sum = 0;
+      for (int b : binaries) sum += hash(b, 15, 5);
+      return sum;
+    };
+  };
+
+  Benchmark("hash_quinary_scalar", NUM_SAMPLES, quinary(hash_quinary_scalar));
+  Benchmark("hash_binary_len_scalar", NUM_SAMPLES,
+            binary(hash_binary_len_scalar));
+  if (cpu_has_bmi2()) {
+    Benchmark("hash_quinary_bmi2", NUM_SAMPLES, quinary(hash_quinary_bmi2));
+    Benchmark("hash_binary_len_bmi2", NUM_SAMPLES,
+              binary(hash_binary_len_bmi2));
+  }
+}
+
+TEST(Profiling, ShowdownEvaluators) {
+  const int NUM_SHOWDOWNS = 1 << 14;
+  for (int num_hands : {2, 6}) {
+    const int ROW = 10 + 4 * num_hands;
+    const vector<int> rows = RandomRows(NUM_SHOWDOWNS, ROW);
+    vector<const int*> hands;
+    for (int i = 0; i < NUM_SHOWDOWNS; i++) {
+      for (int j = 0; j < num_hands; j++) {
+        hands.push_back(rows.data() + i * ROW + 10 + 4 * j);
+      }
+    }
+
+    vector<int> ranks1(num_hands), ranks2(num_hands);
+    for (int b = 0; b < NUM_EVALUATOR_BACKENDS; b++) {
+      const ShowdownEvaluator& evaluator =
+          showdown_evaluator((EvaluatorBackend)b);
+      Benchmark(string(evaluator_backend_name((EvaluatorBackend)b)) + ", " +
+                    to_string(num_hands) + " hands",
+                (long long)NUM_SHOWDOWNS * num_hands * 2, [&]() {
+                  long long sum = 0;
+                  for (int i = 0; i < NUM_SHOWDOWNS; i++) {
+                    const int* board = rows.data() + i * ROW;
+                    evaluator.EvaluateBoards(board, board + 5,
+                                             &hands[i * num_hands], num_hands,
+                                             ranks1.data(), ranks2.data());
+                    sum += ranks1[0] + ranks2[0];
+                  }
+                  return sum;
+                });
+    }
+    cout << "fastest for " << num_hands << " hands: "
+         << evaluator_backend_name(fastest_evaluator_backend(num_hands))
+         << endl;
+  }
+}
+
+TEST(Profiling, MonteCarloEquity) {
+  const vector<int> hand = string_to_cards("AhKh5c6c");
+  const vector<int> flop1 = string_to_cards("JcQdKc");
+  const vector<int> flop2 = string_to_cards("8s2h5s");
+
+  EquityConfig config;
+  config.num_iterations = 200000;
+  const int cores = max(1, (int)thread::hardware_concurrency());
+  for (int num_threads = 1; num_threads <= cores; num_threads *= 2) {
+    config.num_threads = num_threads;
+    Benchmark("monte_carlo_equity, 6 players, " + to_string(num_threads) +
+                  " threads",
+              config.num_iterations, [&]() {
+                EquityResult result =
+                    multiway_equity_calc(hand, flop1, flop2, 6, config);
+                return (long long)(result.equity[0] * 1e6);
+              });
+  }
+}
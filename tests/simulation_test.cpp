@@ -0,0 +1,261 @@
+#include "src/simulation.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <thread>
+
+#include "src/helper.h"
+#include "src/rng.h"
+
+// Counts heap allocations made by this thread while counting_allocations is
+// set. Only SteadyStateIterationsDontAllocate sets it, so every other test
+// allocates as usual.
+static thread_local bool counting_allocations = false;
+static thread_local long long allocations = 0;
+
+void* operator new(size_t size) {
+  if (counting_allocations) {
+    allocations++;
+  }
+  if (void* p = malloc(size == 0 ? 1 : size)) {
+    return p;
+  }
+  throw bad_alloc();
+}
+
+// operator new above gets its memory from malloc, so free is the matching
+// release. GCC can't see that when it inlines these into a new-expression's
+// caller, and warns that free doesn't match new.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+// Walks both trees in lockstep, comparing every table exactly.
+static void ExpectSameTree(const Node* a, const Node* b) {
+  ASSERT_EQ(a->rows_.size(), b->rows_.size());
+  for (const Node::InfosetRow& row : a->rows_) {
+    const Node::InfosetRow* other = b->FindRow(row.handhash);
+    ASSERT_NE(other, nullptr);
+    ASSERT_EQ(row, *other);
+  }
+  ASSERT_EQ(a->children.size(), b->children.size());
+  for (const auto& [action, child] : a->children) {
+    auto other = b->children.find(action);
+    ASSERT_NE(other, b->children.end());
+    ExpectSameTree(child, other->second);
+  }
+
+  auto chance_a = dynamic_cast<const ChanceNode*>(a);
+  auto chance_b = dynamic_cast<const ChanceNode*>(b);
+  ASSERT_EQ(chance_a == nullptr, chance_b == nullptr);
+  if (chance_a != nullptr) {
+    auto runouts_a = chance_a->GetRunouts();
+    auto runouts_b = chance_b->GetRunouts();
+    ASSERT_EQ(runouts_a.size(), runouts_b.size());
+    for (int i = 0; i < runouts_a.size(); i++) {
+      ASSERT_EQ(runouts_a[i].top_card, runouts_b[i].top_card);
+      ASSERT_EQ(runouts_a[i].bottom_card, runouts_b[i].bottom_card);
+      ExpectSameTree(runouts_a[i].node, runouts_b[i].node);
+    }
+  }
+}
+
+TEST(SimulationTest, CounterRngIsPhilox) {
+  // Philox4x32-10 known answer, counter = key = 0.
+  CounterRng rng(0, 0, 0);
+  EXPECT_EQ(rng.next(), 0x6627e8d5u);
+  EXPECT_EQ(rng.next(), 0xe169c58du);
+  EXPECT_EQ(rng.next(), 0xbc57ac4cu);
+  EXPECT_EQ(rng.next(), 0x9b00dbd8u);
+
+  // seeking back reproduces the stream.
+  CounterRng a(42, 3, 1000), b(42, 3, 999);
+  b.Seek(42, 3, 1000);
+  for (int i = 0; i < 10; i++) {
+    EXPECT_EQ(a.next(), b.next());
+  }
+}
+
+TEST(SimulationTest, SeededRunsAreIdentical) {
+  Simulation first, second;
+  for (Simulation* sim : {&first, &second}) {
+    sim->initialise("AcKc8h", "KhQc4s", 3, 50.0, 5.0);
+    sim->SetSeed(1234);
+    sim->RunIterations(200);
+  }
+  ExpectSameTree(first.GetRoot(), second.GetRoot());
+
+  Simulation other;
+  other.initialise("AcKc8h", "KhQc4s", 3, 50.0, 5.0);
+  other.SetSeed(4321);
+  other.RunIterations(200);
+  ASSERT_NE(first.GetRoot()->rows_, other.GetRoot()->rows_);
+}
+
+// Number of table entries and subtrees in the tree - whatever an iteration
+// has to allocate the first time it gets somewhere.
+static long long TreeEntries(const Node* node) {
+  long long entries = node->rows_.size() + node->children.size();
+  for (const auto& [action, child] : node->children) {
+    entries += TreeEntries(child);
+  }
+  if (auto chance_node = dynamic_cast<const ChanceNode*>(node)) {
+    for (const auto& runout : chance_node->GetRunouts()) {
+      entries += 1 + TreeEntries(runout.node);
+    }
+  }
+  return entries;
+}
+
+TEST(SimulationTest, SteadyStateIterationsDontAllocate) {
+  Simulation sim;
+  sim.initialise("AcKc8h", "KhQc4s", 3, 50.0, 5.0);
+
+  // a pass is 200 consecutive iterations, each with its own deal. Reseeding
+  // at the start of a pass replays the same deals, so after warming up most
+  // of what a pass reaches already exists.
+  const int pass = 200;
+  for (int i = 0; i < 10; i++) {
+    sim.SetSeed(99);
+    sim.RunIterations(pass);
+  }
+
+  // regrets keep changing, so an iteration can still take a line it hasn't
+  // before. Those may allocate; every other one must not.
+  sim.SetSeed(99);
+  int steady_iterations = 0;
+  for (int i = 0; i < pass; i++) {
+    const long long entries = TreeEntries(sim.GetRoot());
+
+    allocations = 0;
+    counting_allocations = true;
+    sim.RunIteration();
+    counting_allocations = false;
+
+    if (TreeEntries(sim.GetRoot()) == entries) {
+      steady_iterations++;
+      ASSERT_EQ(allocations, 0) << "iteration " << i;
+    }
+  }
+  EXPECT_GT(steady_iterations, pass / 2);
+}
+
+// Hands on the flop share a few buckets, so the root's regrets build up
+// quickly enough for pruning to kick in. GameState keeps the board with the
+// lower first card as board1.
+static const HandAbstraction& FlopBuckets() {
+  static const HandAbstraction* abstraction = [] {
+    auto* a = new HandAbstraction();
+    a->Build(string_to_cards("KhQc4s"), string_to_cards("AcKc8h"), 4, 1, 1, 5);
+    return a;
+  }();
+  return *abstraction;
+}
+
+TEST(SimulationTest, PruningWaitsForWarmup) {
+  PruningConfig pruning;
+  pruning.enabled = true;
+  pruning.regret_threshold = 0.0;
+  pruning.warmup_iterations = 100;
+  pruning.revisit_interval = 0;
+
+  Simulation sim;
+  sim.initialise("AcKc8h", "KhQc4s", 2, 50.0, 5.0);
+  sim.SetAbstraction(&FlopBuckets());
+  sim.SetPruning(pruning);
+  sim.SetSeed(7);
+  sim.RunIterations(100);
+  PruningStats stats = sim.GetPruningStats();
+  EXPECT_GT(stats.decisions, 0);
+  EXPECT_EQ(stats.pruned_decisions, 0);
+  EXPECT_EQ(stats.pruned_subtrees, 0);
+
+  sim.RunIterations(300);
+  stats = sim.GetPruningStats();
+  EXPECT_GT(stats.pruned_decisions, 0);
+  // every pruned decision skips at least one subtree.
+  EXPECT_GE(stats.pruned_subtrees, stats.pruned_decisions);
+  EXPECT_LE(stats.pruned_decisions, stats.decisions);
+}
+
+TEST(SimulationTest, PruningRevisitsEveryInterval) {
+  PruningConfig pruning;
+  pruning.enabled = true;
+  pruning.regret_threshold = 0.0;
+  pruning.warmup_iterations = 0;
+
+  // every iteration is a revisit, so nothing is ever pruned.
+  pruning.revisit_interval = 1;
+  Simulation always;
+  always.initialise("AcKc8h", "KhQc4s", 2, 50.0, 5.0);
+  always.SetAbstraction(&FlopBuckets());
+  always.SetPruning(pruning);
+  always.SetSeed(7);
+  always.RunIterations(300);
+  EXPECT_GT(always.GetPruningStats().decisions, 0);
+  EXPECT_EQ(always.GetPruningStats().pruned_subtrees, 0);
+
+  // revisiting every other iteration prunes on the rest.
+  pruning.revisit_interval = 2;
+  Simulation half;
+  half.initialise("AcKc8h", "KhQc4s", 2, 50.0, 5.0);
+  half.SetAbstraction(&FlopBuckets());
+  half.SetPruning(pruning);
+  half.SetSeed(7);
+  half.RunIterations(300);
+  EXPECT_GT(half.GetPruningStats().pruned_subtrees, 0);
+
+  // pruning off never counts anything.
+  Simulation off;
+  off.initialise("AcKc8h", "KhQc4s", 2, 50.0, 5.0);
+  off.SetAbstraction(&FlopBuckets());
+  off.SetSeed(7);
+  off.RunIterations(300);
+  EXPECT_EQ(off.GetPruningStats().decisions, 0);
+}
+
+// A focus whose subgame can't be built falls back to the root for that
+// iteration, and the error is kept for the GUI.
+TEST(SimulationTest, FocusErrorsFallBackToTheRoot) {
+  Simulation sim;
+  sim.initialise("AcKc8h", "KhQc4s", 2, 50.0, 5.0);
+  sim.SetSeed(3);
+  sim.RunIterations(10);
+  EXPECT_EQ(sim.GetFocusError(), "");
+
+  Node stray(0);  // not in the tree
+  sim.SetFocus(&stray);
+  const auto before = sim.GetRoot()->rows_;
+  sim.RunIterations(10);
+  EXPECT_NE(sim.GetFocusError(), "");
+  EXPECT_NE(sim.GetRoot()->rows_, before);
+
+  sim.SetFocus(sim.GetRoot());
+}
+
+// A stale snapshot is only rebuilt once the focus has been updated since it
+// was taken, so a paused solver doesn't copy every row each interval.
+TEST(SimulationTest, UnchangedFocusKeepsItsSnapshot) {
+  Simulation sim;
+  sim.initialise("AcKc8h", "KhQc4s", 2, 50.0, 5.0);
+  sim.SetSeed(3);
+  sim.RunIterations(10);
+
+  const auto before = sim.GetStrategySnapshot();
+  ASSERT_NE(before, nullptr);
+  EXPECT_GT(before->updates, 0);
+  EXPECT_EQ(before->updates, sim.GetRoot()->updates_);
+
+  this_thread::sleep_for(chrono::milliseconds(300));
+  sim.MaybePublishSnapshot(before->iteration);
+  EXPECT_EQ(sim.GetStrategySnapshot(), before);
+}
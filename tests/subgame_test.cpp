@@ -0,0 +1,248 @@
+#include "src/subgame.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "src/action_tree.h"
+#include "src/chancenode.h"
+#include "src/helper.h"
+#include "src/rng.h"
+#include "src/simulation.h"
+
+namespace {
+
+// Only clubs and hearts on the flops, so diamonds and spades are
+// interchangeable and the turn merges isomorphic deals.
+const char* const FLOP1 = "AcKc8h";
+const char* const FLOP2 = "KhQc4h";
+const SuitPermutation SWAP_DS = {0, 3, 2, 1};
+
+struct PathDecision {
+  Node* node;
+  int player;
+  HandAction action;
+  int num_actions;
+};
+
+// A solved tree, and a path from the root through the first chance node to a
+// turn runout where the deal was suit-permuted half the time.
+class SubgameTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    sim_.initialise(FLOP1, FLOP2, 2, 50.0, 5.0);
+    sim_.SetSeed(5);
+    for (int i = 0; i < 500; i++) {
+      sim_.RunIteration();
+    }
+
+    TreeConfig config;
+    tree_.Build(config);
+    root_state_ = GameState(string_to_cards(FLOP1), string_to_cards(FLOP2), 2,
+                            50.0, 5.0);
+    root_state_.use_action_tree(&tree_);
+
+    GameState state = root_state_;
+    ASSERT_TRUE(FindPath(sim_.GetRoot(), state));
+  }
+
+  // depth first to the first chance node with a runout that has two deals
+  // and no king (the tests take the kings out of the range).
+  bool FindPath(Node* node, GameState& state) {
+    if (auto chance_node = dynamic_cast<ChanceNode*>(node)) {
+      for (const auto& runout : chance_node->GetRunouts()) {
+        if (chance_node->DealPermutations(runout.top_card, runout.bottom_card)
+                    .size() == 2 &&
+            runout.top_card / 4 != 11 && runout.bottom_card / 4 != 11) {
+          focus_ = runout.node;
+          deal_ = {runout.top_card, runout.bottom_card};
+          return true;
+        }
+      }
+      return false;
+    }
+
+    for (const auto& [action, child] : node->children) {
+      GameState next = state;
+      decisions_.push_back({node, state.get_next_to_act(), action,
+                            (int)state.GetUniformStrategy().size()});
+      next.do_next_action(action);
+      if (!next.end_of_game() && FindPath(child, next)) {
+        return true;
+      }
+      decisions_.pop_back();
+    }
+    return false;
+  }
+
+  // hands that don't use a card on either board at the focus.
+  vector<array<int, 4>> FocusHands() const {
+    uint64_t board = 0;
+    for (int c : string_to_cards(FLOP1)) board |= 1ull << c;
+    for (int c : string_to_cards(FLOP2)) board |= 1ull << c;
+    board |= (1ull << deal_.first) | (1ull << deal_.second);
+
+    vector<array<int, 4>> hands;
+    for (int h = 0; h < NUM_HANDS; h++) {
+      const array<int, 4> hand = hand_from_index(h);
+      uint64_t mask = 0;
+      for (int c : hand) mask |= 1ull << c;
+      if (!(mask & board)) {
+        hands.push_back(hand);
+      }
+    }
+    return hands;
+  }
+
+  // product of the average strategy probabilities of player's actions on the
+  // path, for hand as it was before the turn.
+  double PathWeight(int player, const array<int, 4>& hand) const {
+    const int key = hand_index((1ull << hand[0]) | (1ull << hand[1]) |
+                               (1ull << hand[2]) | (1ull << hand[3]));
+    double weight = 1.0;
+    for (const auto& decision : decisions_) {
+      if (decision.player == player) {
+        weight *= decision.node->AverageStrategyProbability(
+            key, decision.action, 1.0 / decision.num_actions);
+      }
+    }
+    return weight;
+  }
+
+  static array<int, 4> Swapped(const array<int, 4>& hand) {
+    vector<int> cards(hand.begin(), hand.end());
+    permute_cards(cards, SWAP_DS);
+    sort(cards.begin(), cards.end());
+    return {cards[0], cards[1], cards[2], cards[3]};
+  }
+
+  Simulation sim_;
+  ActionTree tree_;
+  GameState root_state_;
+  vector<PathDecision> decisions_;
+  Node* focus_ = nullptr;
+  pair<int, int> deal_;
+};
+
+// A hand at the turn was either itself or its diamond/spade swap on the flop,
+// depending on which of the two deals came.
+TEST_F(SubgameTest, RangesFollowTheAverageStrategy) {
+  const PathDecision& first = decisions_[0];
+  HandAction other = NOTHING;
+  for (HandAction action : first.node->actions_) {
+    if (action != first.action) other = action;
+  }
+  ASSERT_NE(other, NOTHING);
+
+  // the flop hand takes the path's action, its swap never does.
+  const vector<array<int, 4>> hands = FocusHands();
+  const array<int, 4> hand = *find_if(
+      hands.begin(), hands.end(),
+      [](const array<int, 4>& h) { return Swapped(h) != h; });
+  const array<int, 4> swapped = Swapped(hand);
+  auto key = [](const array<int, 4>& h) {
+    return hand_index((1ull << h[0]) | (1ull << h[1]) | (1ull << h[2]) |
+                      (1ull << h[3]));
+  };
+  auto& sums = first.node->Row(key(hand)).strategy_sum;
+  sums.fill(0.0);
+  sums[first.action] = 1.0;
+  auto& swapped_sums = first.node->Row(key(swapped)).strategy_sum;
+  swapped_sums.fill(0.0);
+  swapped_sums[other] = 1.0;
+
+  Subgame subgame(sim_.GetRoot(), focus_, root_state_, nullptr);
+  ASSERT_EQ(subgame.GetRoot(), focus_);
+
+  for (const auto& h : {hand, swapped}) {
+    const double expected =
+        0.5 * (PathWeight(first.player, h) +
+               PathWeight(first.player, Swapped(h)));
+    EXPECT_GT(expected, 0.0);
+    EXPECT_NEAR(subgame.HandWeight(first.player, h), expected, 1e-9);
+  }
+
+  // every hand, for both players.
+  for (int player = 0; player < 2; player++) {
+    for (const auto& h : hands) {
+      const double expected =
+          0.5 * (PathWeight(player, h) + PathWeight(player, Swapped(h)));
+      ASSERT_NEAR(subgame.HandWeight(player, h), expected, 1e-9);
+    }
+  }
+
+  // hands on the board have no weight.
+  EXPECT_EQ(subgame.HandWeight(0, {0, 1, 2, deal_.first}), 0.0);
+}
+
+TEST_F(SubgameTest, SampleDealsEachCardOnceAndFollowsTheWeights) {
+  // player 0 (drawn first) never holds a king, and a hand with the ace of
+  // spades is played a quarter as often.
+  const int kd = string_to_cards("Kd")[0];
+  const int ks = string_to_cards("Ks")[0];
+  const int as = string_to_cards("As")[0];
+  for (const auto& decision : decisions_) {
+    if (decision.player != 0) {
+      continue;
+    }
+    for (int h = 0; h < NUM_HANDS; h++) {
+      const array<int, 4> hand = hand_from_index(h);
+      const bool king = count(hand.begin(), hand.end(), kd) +
+                        count(hand.begin(), hand.end(), ks);
+      const bool ace = count(hand.begin(), hand.end(), as);
+      if (!king && !ace) {
+        continue;
+      }
+      auto& sums = decision.node->Row(h).strategy_sum;
+      for (HandAction action : decision.node->actions_) {
+        sums[action] = action == decision.action ? (king ? 0.0 : 1.0) : 3.0;
+      }
+    }
+  }
+
+  Subgame subgame(sim_.GetRoot(), focus_, root_state_, nullptr);
+
+  double total = 0.0, with_ace = 0.0;
+  for (const auto& hand : FocusHands()) {
+    const double weight = subgame.HandWeight(0, hand);
+    total += weight;
+    if (count(hand.begin(), hand.end(), as)) with_ace += weight;
+  }
+  const double expected = with_ace / total;
+
+  thread_rng().Seek(11, 0, 0);
+  const int num_samples = 20000;
+  int aces = 0;
+  GameState state;
+  for (int i = 0; i < num_samples; i++) {
+    subgame.Sample(&state);
+
+    uint64_t used = 0;
+    int num_cards = 0;
+    auto use = [&](int card) {
+      ASSERT_FALSE(used & (1ull << card)) << cards_to_string({card});
+      used |= 1ull << card;
+      num_cards++;
+    };
+    for (int c : state.board1_) use(c);
+    for (int c : state.board2_) use(c);
+    for (const auto& player : state.players_) {
+      for (int c : player.hand) use(c);
+    }
+    for (int c : state.deck.cards) use(c);
+    ASSERT_EQ(num_cards, 52);
+
+    const vector<int>& hand = state.players_[0].hand;
+    ASSERT_EQ(count(hand.begin(), hand.end(), kd), 0);
+    ASSERT_EQ(count(hand.begin(), hand.end(), ks), 0);
+    aces += count(hand.begin(), hand.end(), as);
+  }
+
+  const double frequency = (double)aces / num_samples;
+  const double sigma = sqrt(expected * (1.0 - expected) / num_samples);
+  EXPECT_NEAR(frequency, expected, 5.0 * sigma);
+}
+
+}  // namespace
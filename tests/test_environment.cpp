@@ -0,0 +1,45 @@
+#include <gtest/gtest.h>
+#include <stdlib.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Points the Omaha table cache at a fresh directory under gtest's temporary
+// directory, removed again when the tests finish, so running the tests never
+// writes tables to ~/.cache or leaves them behind in /tmp. A
+// PHEVALUATOR_CACHE_DIR set by the caller (e.g. to reuse the tables across
+// runs) is left alone.
+class CacheDirEnvironment : public ::testing::Environment {
+ public:
+  void SetUp() override {
+    if (getenv("PHEVALUATOR_CACHE_DIR") != nullptr) {
+      return;
+    }
+
+    const string pattern = ::testing::TempDir() + "phevaluator-XXXXXX";
+    vector<char> dir(pattern.begin(), pattern.end());
+    dir.push_back('\0');
+    if (mkdtemp(dir.data()) == nullptr) {
+      return;
+    }
+    dir_ = dir.data();
+    setenv("PHEVALUATOR_CACHE_DIR", dir_.c_str(), 1);
+  }
+
+  void TearDown() override {
+    if (!dir_.empty()) {
+      error_code ignored;
+      filesystem::remove_all(dir_, ignored);
+    }
+  }
+
+ private:
+  string dir_;
+};
+
+static ::testing::Environment* const cache_dir_environment =
+    ::testing::AddGlobalTestEnvironment(new CacheDirEnvironment);